@@ -42,7 +42,7 @@
  *----------------------------------------------------------*/
 
 /* USER CODE BEGIN Includes */
-#include "SEGGER_SYSVIEW_FreeRTOS.h"
+#include "trace_recorder.h"
 /* Section where include file can be added */
 /* USER CODE END Includes */
 
@@ -51,6 +51,8 @@
   #include <stdint.h>
   extern uint32_t SystemCoreClock;
   void xPortSysTickHandler(void);
+  void CpuStats_InitCounter(void);
+  uint32_t CpuStats_Counter(void);
 #endif
 #ifndef CMSIS_device_header
 #define CMSIS_device_header "stm32f1xx.h"
@@ -65,7 +67,7 @@
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 56 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)7 *1024)
+#define configTOTAL_HEAP_SIZE                    ((size_t)512)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_TRACE_FACILITY                 1
 #define configUSE_16_BIT_TICKS                   0
@@ -88,6 +90,11 @@
 #define configUSE_STATS_FORMATTING_FUNCTIONS    1
 #define configCHECK_FOR_STACK_OVERFLOW    2
 
+/* Run time stats: DWT cycle counter minus interrupt cycles (cpu_stats.c) */
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() CpuStats_InitCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE()         CpuStats_Counter()
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 #define INCLUDE_vTaskPrioritySet            1
@@ -103,6 +110,7 @@ to exclude the API function. */
 #define INCLUDE_uxTaskGetStackHighWaterMark 1
 #define INCLUDE_xTaskGetCurrentTaskHandle   1
 #define INCLUDE_eTaskGetState               1
+#define INCLUDE_xTaskGetIdleTaskHandle      1
 
 /*
  * The CMSIS-RTOS V2 FreeRTOS wrapper is dependent on the heap implementation used
@@ -0,0 +1,66 @@
+/*
+================================================================================
+adc_dma.h - ADC1 定时器触发扫描 + DMA 双缓冲采样头文件
+================================================================================
+*/
+#ifndef __ADC_DMA_H
+#define __ADC_DMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "sensor.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Scan sequence: Vrefint, internal temperature sensor, external probes */
+#define ADC_DMA_CH_VREFINT          17
+#define ADC_DMA_CH_TEMPSENSOR       16
+#define ADC_DMA_CH_PROBE0           1       // PA1
+#define ADC_DMA_CH_PROBE1           4       // PA4
+#define ADC_DMA_PROBE_PINS          (GPIO_PIN_1 | GPIO_PIN_4)
+
+#define ADC_DMA_NUM_CHANNELS        4
+#define ADC_DMA_BLOCK_SCANS         32      // scans averaged per half buffer
+#define ADC_DMA_SCAN_RATE_HZ        1000    // TIM3 TRGO rate
+
+/* Index of each channel inside a scan / block average */
+#define ADC_DMA_IDX_VREFINT         0
+#define ADC_DMA_IDX_TEMPSENSOR      1
+#define ADC_DMA_IDX_PROBE0          2
+#define ADC_DMA_IDX_PROBE1          3
+
+/* Reference data, STM32F103 datasheet 5.3.19 / 5.3.4 */
+#define ADC_DMA_VREFINT_MV          1200
+#define ADC_DMA_TS_V25_MV           1430
+#define ADC_DMA_TS_SLOPE_UV         4300    // uV per degC
+
+/* Exported types ------------------------------------------------------------*/
+/* Average of one half buffer, raw 12-bit codes scaled by ADC_DMA_BLOCK_SCANS */
+typedef struct {
+    uint32_t sequence;
+    uint32_t sum[ADC_DMA_NUM_CHANNELS];
+} ADC_DMA_Block_t;
+
+/* Exported variables --------------------------------------------------------*/
+extern DMA_HandleTypeDef hdma_adc1;
+extern TIM_HandleTypeDef htim3;
+
+/* Exported functions prototypes ---------------------------------------------*/
+HAL_StatusTypeDef ADC_DMA_Init(void);
+void ADC_DMA_Stop(void);
+uint32_t ADC_DMA_GetBlock(ADC_DMA_Block_t *block);
+
+/**
+ * @brief Sensor framework driver. Values: vdda (mV), mcu_temp (0.1 degC),
+ *        probe0/probe1 (mV). ctx is an ADC_DMA_Block_t* scratch frame.
+ */
+extern const Sensor_Driver_t ADC_DMA_SensorDriver;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ADC_DMA_H */
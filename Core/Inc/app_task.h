@@ -13,8 +13,19 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "cmsis_os2.h"
+#include "sensor.h"
 
 /* Exported types ------------------------------------------------------------*/
+/* Message on the sensor bus topic (bus.h) */
+typedef struct {
+    uint8_t id;
+    Sensor_Reading_t reading;
+} Sensor_Event_t;
+
+/* Message on the led bus topic (bus.h) */
+typedef struct {
+    char* pin_state;
+} LED_Message_t;
 
 /* Exported constants --------------------------------------------------------*/
 
@@ -26,6 +37,7 @@ extern osThreadId_t defaultTaskHandle;
 extern osThreadId_t ESP8266TaskHandle;
 extern osThreadId_t MQTTPublishTaskHandle;
 extern osThreadId_t DataProcessTaskHandle;
+extern osThreadId_t SensorTaskHandle;
 
 /* Queue handles */
 extern osMessageQueueId_t uart2QueueHandle;
@@ -43,6 +55,7 @@ void StartDataProcessTask(void *argument);
 void StartSensorTask(void *argument);
 void Tasks_Init(void);
 void OLED_Task(void  * argument);
+void KeepAliveTimer_Callback(void *argument);
 void vMonitorTask(void *pvParameters);
 #ifdef __cplusplus
 }
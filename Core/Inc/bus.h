@@ -0,0 +1,77 @@
+/*
+================================================================================
+bus.h - 进程内发布/订阅总线：编译期登记的类型化主题
+================================================================================
+每个主题是下表中的一个静态环形缓冲（深度 = 保留的历史条数）和一个发布序号。
+发布时消息只写一次（写进环里的下一个槽），然后给该主题的每个订阅者置一次
+线程标志，订阅者越多只是多几次 osThreadFlagsSet，不再为每个消费者各建一个
+队列、各拷一份。订阅者醒来后直接读环里的槽：Bus_Latest_xxx 取最新值，
+Bus_Next_xxx 按顺序读保留的历史；读游标（下一条的序号）由订阅者自己保存，
+主题不记录谁读到了哪里，所以读者之间互不影响。
+
+槽在发布 depth 条新消息之后才会被改写。读者拿到的是槽的指针，用完之后用
+Bus_Valid 确认读期间没有被改写；改写了就重新取（见 OLED_Task）。发布在关中断
+的几条指令内完成，任务和中断里都可以调用，同一主题可以有多个发布者。
+*/
+#ifndef __BUS_H
+#define __BUS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmsis_os2.h"
+#include "config.h"
+#include "app_task.h"
+#include <stdbool.h>
+
+/* Exported constants --------------------------------------------------------*/
+/*   名称      消息类型          历史深度；消息应当小（发布时关中断拷贝）*/
+#define BUS_TOPIC_TABLE(X) \
+    X(sensor,  Sensor_Event_t,   2) \
+    X(led,     LED_Message_t,    2)
+
+/* Exported types ------------------------------------------------------------*/
+#define BUS_ENUM_TOPIC(name, type, depth)   BUS_TOPIC_##name,
+typedef enum { BUS_TOPIC_TABLE(BUS_ENUM_TOPIC) BUS_TOPIC_COUNT } Bus_Topic_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 登记订阅者：每次发布都给 thread 置 flags；满 BUS_MAX_SUBSCRIBERS 返回 false */
+bool Bus_Subscribe(Bus_Topic_t topic, osThreadId_t thread, uint32_t flags);
+
+/* 把 msg（主题的消息类型）写入环中下一个槽，再通知全部订阅者 */
+void Bus_Publish(Bus_Topic_t topic, const void *msg);
+
+/* 最新的一条；游标之后没有新发布时返回 NULL，否则把游标移到最新一条之后 */
+const void *Bus_Latest(Bus_Topic_t topic, uint32_t *cursor);
+
+/* 游标处的下一条，读完返回 NULL；读者落后超过历史深度时跳到最旧的保留条目，
+   丢掉的条数计入 bus_overruns */
+const void *Bus_Next(Bus_Topic_t topic, uint32_t *cursor);
+
+/* 刚由 Bus_Latest / Bus_Next 取得的那一条（游标的前一条）是否仍未被改写 */
+bool Bus_Valid(Bus_Topic_t topic, uint32_t cursor);
+
+/* 类型化的包装，避免在调用处强制转换：Bus_Publish_sensor(&event) 等 */
+#define BUS_TYPED_TOPIC(name, type, depth) \
+    static inline void Bus_Publish_##name(const type *msg) \
+    { \
+        Bus_Publish(BUS_TOPIC_##name, msg); \
+    } \
+    static inline const type *Bus_Latest_##name(uint32_t *cursor) \
+    { \
+        return (const type *)Bus_Latest(BUS_TOPIC_##name, cursor); \
+    } \
+    static inline const type *Bus_Next_##name(uint32_t *cursor) \
+    { \
+        return (const type *)Bus_Next(BUS_TOPIC_##name, cursor); \
+    }
+BUS_TOPIC_TABLE(BUS_TYPED_TOPIC)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BUS_H */
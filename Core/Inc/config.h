@@ -18,6 +18,8 @@ system_config.h - 系统配置文件
 #define MQTT_PASSWORD               "public"
 #define MQTT_TOPIC_PUB              "stm32/sensor/data"
 #define MQTT_TOPIC_SUB              "stm32/control/cmd"
+#define MQTT_TOPIC_AGG              "stm32/sensor/agg"
+#define MQTT_TOPIC_SYS              "stm32/$SYS/metrics"   // binary, decode with tools/metrics_dump
 
 #define MQTT_KEEP_ALIVE             60
 #define MQTT_BUFFER_SIZE            256
@@ -28,4 +30,45 @@ system_config.h - 系统配置文件
 #define MQTT_KEEP_ALIVE_INTERVAL   60        // seconds
 #define SENSOR_READ_INTERVAL       30000     // milliseconds
 
+/* On-device statistics */
+#define STATS_WINDOW_SHORT_MS      60000     // 1 minute aggregate
+#define STATS_WINDOW_LONG_MS       3600000   // 1 hour aggregate
+#define STATS_PUBLISH_RAW          1         // 0: publish aggregates only
+#define METRICS_PUBLISH_MS         60000     // device metrics on MQTT_TOPIC_SYS
+#define HISTORY_BUCKET_MS          20000     // OLED sparkline bucket: 32 buckets = last 10.7 minutes
+
+/* OLED transport */
+#define OLED_TRANSPORT_SOFT        0         // bit-banged I2C on PB1 (SCL) / PB0 (SDA)
+#define OLED_TRANSPORT_HW          1         // I2C2 400 kHz + DMA on PB10 (SCL) / PB11 (SDA)
+#define OLED_TRANSPORT_SOFT_ISR    2         // bit-banged on PB1/PB0, clocked from the TIM4 ISR in the background
+#ifndef OLED_TRANSPORT
+#define OLED_TRANSPORT             OLED_TRANSPORT_SOFT
+#endif
+#define OLED_FRAME_MIN_MS          100       // display frame-rate cap; events inside one interval share a frame
+
+/* In-process publish/subscribe bus (bus.h) */
+#define BUS_MAX_SUBSCRIBERS        4         // per topic; each publish sets one thread flag per subscriber
+
+/* Debug console (printf / my_printf on USART1) */
+#ifndef CONSOLE_DMA
+#define CONSOLE_DMA                (OLED_TRANSPORT != OLED_TRANSPORT_HW) // TX DMA shares DMA1_Channel4 with OLED_TRANSPORT_HW
+#endif
+#define CONSOLE_RING_SIZE          512       // bytes, power of two; a write that does not fit is dropped and counted
+#ifndef LOG_DEFERRED
+#define LOG_DEFERRED               1         // DLOG(): 1 = binary records, decode with tools/logdec; 0 = format on device
+#endif
+#ifndef TRACE_RECORDER
+#define TRACE_RECORDER             0         // 1: record task switches / queue ops / ISRs for tools/tracecv (TRACE_RECORDS * 8 bytes RAM)
+#endif
+#define TRACE_RECORDS              256       // event ring, power of two; the oldest events are overwritten
+#define TRACE_SLOW_CMD_MS          500       // an ESP8266 AT command slower than this freezes the ring and dumps it
+#ifndef TRACE_DUMP_MS
+#define TRACE_DUMP_MS              0         // >0: also dump a snapshot this often
+#endif
+
+/* RTOS memory: every task/queue/mutex/timer is static (rtos_objects.h) */
+#ifndef RTOS_RAM_BUDGET
+#define RTOS_RAM_BUDGET            (12 * 1024) // compile-time cap on the static table; the linker checks the 20 KB total
+#endif
+
 #endif /* __SYSTEM_CONFIG_H */
\ No newline at end of file
@@ -0,0 +1,46 @@
+/*
+================================================================================
+console.h - USART1 调试输出：无锁多生产者环形缓冲 + TX DMA 异步发送
+================================================================================
+printf（_write / __io_putchar）和 my_printf 都经 Console_Write 写入环形缓冲，
+调用方只做一次拷贝就返回，由 DMA1_Channel4 在后台把数据送到 USART1。缓冲满时
+整条丢弃并计数，不会阻塞，任务和中断里都可以调用。
+
+CONSOLE_DMA 为 0 时（例如 OLED_TRANSPORT_HW 占用了同一个 DMA 通道）退回到
+原来的 HAL_UART_Transmit 阻塞发送，此时不要在中断里打印。
+*/
+#ifndef __CONSOLE_H
+#define __CONSOLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    uint32_t bytes;             ///< 已写入缓冲的字节数
+    uint32_t dropped;           ///< 因缓冲满丢弃的写入次数
+    uint32_t dropped_bytes;
+    uint16_t max_used;          ///< 缓冲占用的最高水位（字节）
+} Console_Stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 在 MX_USART1_UART_Init 之后调用，配置 USART1 TX DMA */
+void Console_Init(void);
+
+/* 写入 len 字节，要么全部写入要么整条丢弃；返回写入的字节数 */
+uint16_t Console_Write(const char *data, uint16_t len);
+
+void Console_GetStats(Console_Stats_t *stats);
+
+/* DMA1_Channel4 中断处理（stm32f1xx_it.c 调用） */
+void Console_DMA_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CONSOLE_H */
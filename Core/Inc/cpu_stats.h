@@ -0,0 +1,102 @@
+/*
+================================================================================
+cpu_stats.h - 基于 DWT 周期计数器的任务/中断 CPU 占用统计
+================================================================================
+FreeRTOS 的运行时间统计（configGENERATE_RUN_TIME_STATS）以 CpuStats_Counter()
+为时基：DWT->CYCCNT 减去累计的中断周期，所以每个任务的 ulRunTimeCounter 只
+包含它自己在线程模式下运行的周期，中断时间单独记在 CpuStats_IsrEnter/Exit
+之间（stm32f1xx_it.c 中的外设中断都已包上）。SysTick/PendSV 属于内核开销，
+仍计入当时运行的任务。
+
+CpuStats_Sample() 由周期任务调用（监控任务每秒一次），每次把两次采样之间的
+增量换算成千分比，保存最近 CPU_STATS_WINDOW 次，查询接口返回窗口平均值。
+32 位计数器在 72 MHz 下约 59 s 回绕一次，只要采样间隔远小于此，无符号差值
+就不受回绕影响。
+*/
+#ifndef __CPU_STATS_H
+#define __CPU_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "trace_recorder.h"
+#include <stdbool.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define CPU_STATS_MAX_TASKS         10      // 跟踪的任务数上限（含 IDLE / Tmr Svc）
+#define CPU_STATS_WINDOW            5       // 滑动窗口内的采样次数
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 单个任务的占用，单位千分比（‰）
+ */
+typedef struct {
+    const char  *name;
+    TaskHandle_t handle;
+    uint16_t     load;          ///< 窗口平均
+    uint16_t     last;          ///< 最近一次采样间隔
+} CpuStats_Task_t;
+
+/**
+ * @brief 全局占用汇总，单位千分比（‰），均为窗口平均
+ */
+typedef struct {
+    uint16_t isr;               ///< 中断
+    uint16_t idle;              ///< 空闲任务
+    uint16_t busy;              ///< 1000 - idle，即任务 + 中断
+    uint8_t  samples;           ///< 窗口中已有的采样数
+    uint8_t  tasks;             ///< 跟踪中的任务数
+    uint32_t window_ms;         ///< 窗口覆盖的时间
+} CpuStats_Summary_t;
+
+/* 中断计时状态，仅供下面的内联函数使用 */
+extern volatile uint32_t g_cpu_isr_cycles;
+extern volatile uint32_t g_cpu_isr_start;
+extern volatile uint8_t  g_cpu_isr_depth;
+
+/* Exported functions --------------------------------------------------------*/
+/* 外设中断入口/出口各调用一次；嵌套时只统计最外层，开销为几条指令。
+   同时是事件跟踪（trace_recorder.h）的中断进出钩子 */
+static inline void CpuStats_IsrEnter(void)
+{
+    if (g_cpu_isr_depth++ == 0) {
+        g_cpu_isr_start = DWT->CYCCNT;
+    }
+    Trace_Event(TRACE_EV_ISR_ENTER, (uint8_t)__get_IPSR(), 0);
+}
+
+static inline void CpuStats_IsrExit(void)
+{
+    Trace_Event(TRACE_EV_ISR_EXIT, (uint8_t)__get_IPSR(), 0);
+    if (--g_cpu_isr_depth == 0) {
+        g_cpu_isr_cycles += DWT->CYCCNT - g_cpu_isr_start;
+    }
+}
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 运行时间统计时基，由 FreeRTOSConfig.h 的 port 宏调用 */
+void CpuStats_InitCounter(void);
+uint32_t CpuStats_Counter(void);
+
+/* 采样一次所有任务的运行时间（任务上下文，周期调用） */
+void CpuStats_Sample(void);
+
+/* 查询：第 index 个跟踪中的任务，越界返回 false */
+bool CpuStats_GetTask(uint8_t index, CpuStats_Task_t *out);
+
+/* 查询：指定任务的窗口平均占用（‰），未跟踪的任务返回 0 */
+uint16_t CpuStats_TaskLoad(TaskHandle_t task);
+
+/* 查询：中断/空闲/总占用 */
+void CpuStats_GetSummary(CpuStats_Summary_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CPU_STATS_H */
@@ -14,16 +14,19 @@ extern "C" {
 #include "task.h"
 #include "semphr.h"
 #include "main.h"
+#include "sensor.h"
 #include <stdint.h>
 
 // ================================ 配置定义 ================================
-#define DHT11_GPIO_PORT     GPIOA
+#define DHT11_GPIO_BASE     GPIOA_BASE          // 改端口只改这里，dht11.cpp 的 Pin<> 也用它
+#define DHT11_GPIO_PORT     ((GPIO_TypeDef *)DHT11_GPIO_BASE)
 #define DHT11_GPIO_PIN      GPIO_PIN_0
 #define DHT11_GPIO_CLK      __HAL_RCC_GPIOA_CLK_ENABLE
 
 #define DHT11_READ_INTERVAL_MS    2000  // 读取间隔，DHT11最小间隔2秒
 #define DHT11_TIMEOUT_MS          100   // 超时时间
 #define DHT11_MAX_RETRY           3     // 最大重试次数
+#define DHT11_START_LOW_MS        20    // 起始信号低电平时间，至少18ms
 
 // ================================ 数据结构定义 ================================
 
@@ -93,7 +96,28 @@ DHT11_Status_t DHT11_Get_Full_Data(DHT11_Data_t *data);
  * @retval 0 数据无效
  */
 uint8_t DHT11_Is_Data_Valid(void);
+
+/**
+ * @brief 阻塞读取一帧数据（起始信号期间调用 vTaskDelay）
+ */
 DHT11_Status_t DHT11_Read_Raw_Data(DHT11_Data_t *data);
+
+/**
+ * @brief 发起一次非阻塞读取：拉低总线后立即返回
+ */
+DHT11_Status_t DHT11_Start_Read(void);
+
+/**
+ * @brief 轮询 DHT11_Start_Read 发起的读取
+ * @retval DHT11_ERROR_BUSY 起始信号尚未满足 DHT11_START_LOW_MS
+ * @note 起始信号结束后在本次调用中完成约4ms的应答与数据采集
+ */
+DHT11_Status_t DHT11_Poll_Data(DHT11_Data_t *data);
+
+/**
+ * @brief 传感器框架驱动，ctx 为 DHT11_Data_t*，输出温度/湿度（0.1单位）
+ */
+extern const Sensor_Driver_t DHT11_SensorDriver;
 #ifdef __cplusplus
 }
 #endif
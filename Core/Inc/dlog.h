@@ -0,0 +1,85 @@
+/*
+================================================================================
+dlog.h - 延迟格式化的二进制日志
+================================================================================
+DLOG("fmt", 参数...) 不在设备上格式化：格式串放在链接脚本的 .logstr 段里
+（INFO 段，只留在 ELF 中，不占 flash），它在段内的偏移就是格式串 ID；设备只把
+ID、时间戳和原始参数字写进控制台环形缓冲（console.c），由主机端
+tools/logdec 对照 ELF 还原成文本。普通 printf 文本可以和记录混在同一个串口流里。
+
+参数为整数（按 32 位字记录）或字符串（char * / const char *，按内容记录，
+最多 DLOG_STR_MAX 字节，主机无法读取设备 RAM）。格式串支持 %d %i %u %x %X
+%c %s %%，可带标志、宽度和 l/h 长度修饰。记录格式：
+     u8  DLOG_SYNC
+     u16 格式串 ID（小端）
+     u32 时间戳（tick，小端）
+     u8  参数个数
+     u8  字符串参数位图（第 i 位为 1 表示第 i 个参数是字符串）
+     每个参数：整数 u32 小端；字符串 u8 长度 + 内容
+DLOG_SYNC 不会出现在 ASCII 文本中，解码器据此区分文本和记录。
+
+config.h 中 LOG_DEFERRED 为 0 时 DLOG 退回 my_printf，在设备上直接格式化。
+*/
+#ifndef __DLOG_H
+#define __DLOG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include "config.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define DLOG_SYNC                   0xFF
+#define DLOG_MAX_ARGS               8
+#define DLOG_STR_MAX                15      // 字符串参数最多记录的字节数
+#define DLOG_RECORD_MAX             (9 + DLOG_MAX_ARGS * (1 + DLOG_STR_MAX))
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    uint32_t value;                 ///< 整数值，或字符串指针
+    uint8_t  is_str;
+} DLog_Arg_t;
+
+/* Exported macro ------------------------------------------------------------*/
+#define DLOG_ARG_(x) \
+    { (uint32_t)(uintptr_t)(x), _Generic((x), char *: 1, const char *: 1, default: 0) }
+
+#define DLOG_NARGS(...)             DLOG_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define DLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+
+#define DLOG_MAP_0()
+#define DLOG_MAP_1(a)                       DLOG_ARG_(a)
+#define DLOG_MAP_2(a, b)                    DLOG_MAP_1(a), DLOG_ARG_(b)
+#define DLOG_MAP_3(a, b, c)                 DLOG_MAP_2(a, b), DLOG_ARG_(c)
+#define DLOG_MAP_4(a, b, c, d)              DLOG_MAP_3(a, b, c), DLOG_ARG_(d)
+#define DLOG_MAP_5(a, b, c, d, e)           DLOG_MAP_4(a, b, c, d), DLOG_ARG_(e)
+#define DLOG_MAP_6(a, b, c, d, e, f)        DLOG_MAP_5(a, b, c, d, e), DLOG_ARG_(f)
+#define DLOG_MAP_7(a, b, c, d, e, f, g)     DLOG_MAP_6(a, b, c, d, e, f), DLOG_ARG_(g)
+#define DLOG_MAP_8(a, b, c, d, e, f, g, h)  DLOG_MAP_7(a, b, c, d, e, f, g), DLOG_ARG_(h)
+#define DLOG_CAT_(a, b)                     a##b
+#define DLOG_MAP_(n, ...)                   DLOG_CAT_(DLOG_MAP_, n)(__VA_ARGS__)
+
+#if LOG_DEFERRED
+#define DLOG(fmt, ...) \
+    do { \
+        static const char dlog_fmt_[] __attribute__((section(".logstr"), used)) = fmt; \
+        const DLog_Arg_t dlog_args_[DLOG_NARGS(__VA_ARGS__) + 1] = { DLOG_MAP_(DLOG_NARGS(__VA_ARGS__), ##__VA_ARGS__) }; \
+        DLog_Write((uint16_t)(uintptr_t)dlog_fmt_, dlog_args_, DLOG_NARGS(__VA_ARGS__)); \
+    } while (0)
+#else
+#include "my_printf.h"
+#define DLOG(fmt, ...)              my_printf(fmt, ##__VA_ARGS__)
+#endif
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 编码一条记录写入控制台缓冲；任务和中断里都可以调用，缓冲满时丢弃 */
+void DLog_Write(uint16_t id, const DLog_Arg_t *args, uint8_t nargs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DLOG_H */
@@ -51,6 +51,7 @@ ESP8266_StatusTypeDef ESP8266_SendCommand(const char* cmd, const char* expected_
 ESP8266_StatusTypeDef ESP8266_ConnectWiFi(const char* ssid, const char* password);
 ESP8266_StatusTypeDef ESP8266_ConnectTCP(const char* host, const char* port);
 ESP8266_StatusTypeDef ESP8266_SendData(const uint8_t* data, uint16_t length);
+uint32_t ESP8266_GetSendTime(void);
 ESP8266_StatusTypeDef ESP8266_CheckConnection(void);
 void ESP8266_ProcessResponse(const char* response);
 
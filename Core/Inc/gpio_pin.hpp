@@ -0,0 +1,97 @@
+/*
+================================================================================
+gpio_pin.hpp - 编译期 GPIO 引脚模板（C++17，仅头文件）
+================================================================================
+Pin<端口基地址, 引脚号> 的所有操作都是对 BSRR/BRR/IDR/CRL/CRH 的单条访存，
+内联后没有函数调用，也不经过 HAL_GPIO_WritePin/HAL_GPIO_Init：
+  - high()/low()  : 写 BSRR/BRR，原子操作，无需读-改-写
+  - read()        : 读 IDR
+  - 模式切换      : 只改写 CRL(N<8)/CRH(N>=8) 中本引脚的 4 位配置，
+                    代替 HAL_GPIO_Init 对 16 个引脚位置的循环
+
+用法：
+    using SDA = Pin<GPIOB_BASE, pin_index(GPIO_PIN_0)>;
+    SDA::output_pp();
+    SDA::low();
+*/
+#ifndef __GPIO_PIN_HPP
+#define __GPIO_PIN_HPP
+
+#include "stm32f1xx.h"
+#include <stdint.h>
+
+/* CRL/CRH 中每个引脚的 4 位配置 (CNF[1:0]:MODE[1:0]) */
+enum class PinMode : uint32_t {
+    Analog      = 0x0,      // 模拟输入
+    Floating    = 0x4,      // 浮空输入
+    InputPull   = 0x8,      // 上拉/下拉输入，方向由 ODR 决定
+    OutputPP    = 0x3,      // 推挽输出 50MHz（对应 GPIO_SPEED_FREQ_HIGH）
+    OutputOD    = 0x7,      // 开漏输出 50MHz
+    AltPP       = 0xB,      // 复用推挽 50MHz
+    AltOD       = 0xF,      // 复用开漏 50MHz
+};
+
+#ifdef GPIO_PIN_HOST
+/* 主机端仿真（tools/oled_emu）：寄存器访问转发给仿真器，驱动代码不做任何修改 */
+extern "C" void Host_GPIO_Write(uint32_t port, uint8_t pin, uint8_t level);
+extern "C" uint8_t Host_GPIO_Read(uint32_t port, uint8_t pin);
+extern "C" void Host_GPIO_Config(uint32_t port, uint8_t pin, uint32_t cfg);
+#endif
+
+/* HAL 的 GPIO_PIN_x 掩码 -> 引脚号，便于沿用头文件中已有的引脚定义 */
+constexpr uint8_t pin_index(uint16_t gpio_pin)
+{
+    return static_cast<uint8_t>(__builtin_ctz(gpio_pin));
+}
+
+template <uint32_t PortBase, uint8_t N>
+struct Pin {
+    static_assert(N < 16, "GPIO pin number must be 0..15");
+
+    static constexpr uint32_t mask = 1UL << N;
+
+#ifdef GPIO_PIN_HOST
+    static inline void high() { Host_GPIO_Write(PortBase, N, 1); }
+    static inline void low() { Host_GPIO_Write(PortBase, N, 0); }
+    static inline void write(bool level) { Host_GPIO_Write(PortBase, N, level); }
+    static inline bool read() { return Host_GPIO_Read(PortBase, N) != 0; }
+
+    template <PinMode M>
+    static inline void mode() { Host_GPIO_Config(PortBase, N, static_cast<uint32_t>(M)); }
+#else
+    static GPIO_TypeDef *port() { return reinterpret_cast<GPIO_TypeDef *>(PortBase); }
+
+    static inline void high() { port()->BSRR = mask; }
+    static inline void low() { port()->BRR = mask; }
+    static inline void write(bool level) { port()->BSRR = level ? mask : (mask << 16); }
+    static inline bool read() { return (port()->IDR & mask) != 0; }
+
+    /* 只改写本引脚的配置位；同一端口的其他引脚不受影响（非原子，勿与中断中的同端口配置并发） */
+    template <PinMode M>
+    static inline void mode()
+    {
+        constexpr uint32_t shift = (N & 7U) * 4U;
+        constexpr uint32_t field = 0xFUL << shift;
+        constexpr uint32_t value = static_cast<uint32_t>(M) << shift;
+
+        if constexpr (N < 8) {
+            port()->CRL = (port()->CRL & ~field) | value;
+        } else {
+            port()->CRH = (port()->CRH & ~field) | value;
+        }
+    }
+#endif
+
+    static inline void output_pp() { mode<PinMode::OutputPP>(); }
+    static inline void output_od() { mode<PinMode::OutputOD>(); }
+    static inline void input_floating() { mode<PinMode::Floating>(); }
+
+    /* 上拉输入：与 HAL_GPIO_Init 相同，先切换模式再置 ODR 选择上拉 */
+    static inline void input_pullup()
+    {
+        mode<PinMode::InputPull>();
+        high();
+    }
+};
+
+#endif /* __GPIO_PIN_HPP */
@@ -0,0 +1,78 @@
+/*
+================================================================================
+metrics.h - 设备指标注册表：计数器 / 量规 / 固定桶直方图
+================================================================================
+指标在 metrics_table.h 中静态登记，每个指标就是数组里的一个字，更新是内联的
+一次原子加（Cortex-M3 上为 LDREX/STREX）或一次存储，任务和中断里都可以调用。
+Metrics_Serialize 把全部指标编码成紧凑的二进制报文，由 MQTT 发布任务按
+METRICS_PUBLISH_MS 周期发布到 MQTT_TOPIC_SYS，主机端用 tools/metrics_dump 解码。
+*/
+#ifndef __METRICS_H
+#define __METRICS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include "metrics_table.h"
+
+/* Exported variables --------------------------------------------------------*/
+/* 指标存储，仅供下面的内联函数使用 */
+extern uint32_t g_metric_counters[METRIC_COUNTER_COUNT];
+extern int32_t  g_metric_gauges[METRIC_GAUGE_COUNT];
+extern uint32_t g_metric_hist[METRIC_HIST_COUNT][METRICS_HIST_BOUNDS + 1];
+extern const uint32_t g_metric_hist_bounds[METRIC_HIST_COUNT][METRICS_HIST_BOUNDS];
+
+/* Exported functions --------------------------------------------------------*/
+static inline void Metric_Add(Metric_Counter_t id, uint32_t n)
+{
+    __atomic_fetch_add(&g_metric_counters[id], n, __ATOMIC_RELAXED);
+}
+
+static inline void Metric_Inc(Metric_Counter_t id)
+{
+    Metric_Add(id, 1);
+}
+
+static inline void Metric_Set(Metric_Gauge_t id, int32_t value)
+{
+    __atomic_store_n(&g_metric_gauges[id], value, __ATOMIC_RELAXED);
+}
+
+/* 把 value 计入第一个上界 >= value 的桶 */
+static inline void Metric_Observe(Metric_Hist_t id, uint32_t value)
+{
+    const uint32_t *bound = g_metric_hist_bounds[id];
+    uint8_t i = 0;
+
+    while (i < METRICS_HIST_BOUNDS && value > bound[i]) {
+        i++;
+    }
+    __atomic_fetch_add(&g_metric_hist[id][i], 1, __ATOMIC_RELAXED);
+}
+
+static inline uint32_t Metric_Counter(Metric_Counter_t id)
+{
+    return __atomic_load_n(&g_metric_counters[id], __ATOMIC_RELAXED);
+}
+
+static inline int32_t Metric_Gauge(Metric_Gauge_t id)
+{
+    return __atomic_load_n(&g_metric_gauges[id], __ATOMIC_RELAXED);
+}
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 指标表的 schema 哈希，与报文头中的值相同 */
+uint16_t Metrics_Schema(void);
+
+/* 编码全部指标，返回报文长度；buf 小于 METRICS_WIRE_MAX 时可能返回 -1 */
+int Metrics_Serialize(uint8_t *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __METRICS_H */
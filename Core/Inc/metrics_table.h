@@ -0,0 +1,75 @@
+/*
+================================================================================
+metrics_table.h - 设备指标表（计数器 / 量规 / 固定桶直方图）
+================================================================================
+固件（metrics.c）和主机端解码器（tools/metrics_dump）共用这张表，因此本文件
+不包含任何头文件。新增指标只需在对应的表里加一行，在模块里调用
+Metric_Inc / Metric_Set / Metric_Observe 即可；表内容变化会改变
+METRICS_SCHEMA_TEXT 的哈希，解码器据此拒绝与自己编译时不一致的报文。
+*/
+#ifndef __METRICS_TABLE_H
+#define __METRICS_TABLE_H
+
+/* 计数器：单调递增，报文中为累计值（丢一包不影响差分）。X(obj) */
+#define METRICS_COUNTER_TABLE(X) \
+    X(mqtt_publish_ok)      \
+    X(mqtt_publish_fail)    \
+    X(mqtt_reconnects)      \
+    X(mqtt_commands)        \
+    X(sensor_events)        \
+    X(sensor_errors)        \
+    X(oled_wakeups)         \
+    X(oled_frames)          \
+    X(msg_pool_empty)       \
+    X(bus_overruns)         \
+    X(stats_dropped)
+
+/* 量规：最近一次设置的有符号值。X(obj) */
+#define METRICS_GAUGE_TABLE(X) \
+    X(uptime_s)             \
+    X(heap_free)            \
+    X(heap_min_free)        \
+    X(heap_largest_free)    \
+    X(heap_frag)            \
+    X(stack_min_free)       \
+    X(cpu_busy)             \
+    X(cpu_isr)
+
+/* 直方图：METRICS_HIST_BOUNDS 个递增的上界（含），最后一个桶收其余的值。
+   X(obj, 上界...) */
+#define METRICS_HIST_BOUNDS         7
+#define METRICS_HIST_TABLE(X) \
+    X(mqtt_publish_ms,  5,   10,   20,   50,   100,   200,   500) \
+    X(oled_frame_us,  500, 1000, 2000, 5000, 10000, 20000, 50000)
+
+/* 表的文本形式，用于计算 schema 哈希 */
+#define METRICS_SCHEMA_COUNTER(obj)         "c:" #obj ";"
+#define METRICS_SCHEMA_GAUGE(obj)           "g:" #obj ";"
+#define METRICS_SCHEMA_HIST(obj, ...)       "h:" #obj "=" #__VA_ARGS__ ";"
+#define METRICS_SCHEMA_TEXT \
+    METRICS_COUNTER_TABLE(METRICS_SCHEMA_COUNTER) \
+    METRICS_GAUGE_TABLE(METRICS_SCHEMA_GAUGE) \
+    METRICS_HIST_TABLE(METRICS_SCHEMA_HIST)
+
+/* 报文格式（版本 1），多字节整数均为 LEB128 变长编码：
+     u8  METRICS_WIRE_VERSION
+     u16 schema（小端，METRICS_SCHEMA_TEXT 的 FNV-1a 折叠到 16 位）
+     var 序号
+     var 计数器 x METRIC_COUNTER_COUNT
+     var 量规（zigzag）x METRIC_GAUGE_COUNT
+     var 直方图桶 x METRIC_HIST_COUNT x (METRICS_HIST_BOUNDS + 1) */
+#define METRICS_WIRE_VERSION        1
+
+#define METRICS_ENUM_COUNTER(obj)           METRIC_COUNTER_##obj,
+#define METRICS_ENUM_GAUGE(obj)             METRIC_GAUGE_##obj,
+#define METRICS_ENUM_HIST(obj, ...)         METRIC_HIST_##obj,
+
+typedef enum { METRICS_COUNTER_TABLE(METRICS_ENUM_COUNTER) METRIC_COUNTER_COUNT } Metric_Counter_t;
+typedef enum { METRICS_GAUGE_TABLE(METRICS_ENUM_GAUGE) METRIC_GAUGE_COUNT } Metric_Gauge_t;
+typedef enum { METRICS_HIST_TABLE(METRICS_ENUM_HIST) METRIC_HIST_COUNT } Metric_Hist_t;
+
+/* 报文最大长度：每个变长整数最多 5 字节 */
+#define METRICS_WIRE_MAX \
+    (3 + 5 * (1 + METRIC_COUNTER_COUNT + METRIC_GAUGE_COUNT + METRIC_HIST_COUNT * (METRICS_HIST_BOUNDS + 1)))
+
+#endif /* __METRICS_TABLE_H */
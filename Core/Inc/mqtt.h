@@ -22,11 +22,6 @@ typedef enum {
     MQTT_NOT_CONNECTED
 } MQTT_StatusTypeDef;
 
-typedef struct {
-    char topic[64];
-    char payload[128];
-} MQTT_Message_t;
-
 /* Exported constants --------------------------------------------------------*/
 
 
@@ -40,6 +35,7 @@ extern uint16_t mqtt_message_id;
 MQTT_StatusTypeDef MQTT_Connect(void);
 MQTT_StatusTypeDef MQTT_Disconnect(void);
 MQTT_StatusTypeDef MQTT_Publish(const char* topic, const char* payload);
+MQTT_StatusTypeDef MQTT_PublishRaw(const char* topic, const uint8_t* payload, uint16_t payload_len);
 MQTT_StatusTypeDef MQTT_Subscribe(const char* topic);
 MQTT_StatusTypeDef MQTT_Unsubscribe(const char* topic);
 void MQTT_ProcessMessage(const char* data, uint16_t length);
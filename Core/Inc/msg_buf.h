@@ -0,0 +1,67 @@
+/*
+================================================================================
+msg_buf.h - 固定块消息缓冲：内存池分配，引用计数，队列里只传指针
+================================================================================
+USART2 空闲中断把 DMA 收到的一段数据直接写进池中的一个 MsgBuf_t（唯一的
+一次拷贝），之后解析、分发和消费都只传递指针：uart2Queue / mqttQueue 的
+元素是 MsgBuf_t *。缓冲块来自 rtos_objects.h 表中的 msgPool（osMemoryPool，
+静态内存），分配和释放在中断里也可以调用。
+
+引用规则：MsgBuf_Alloc 返回的缓冲带 1 个引用；MsgBuf_Send 把调用方的引用
+交给队列（失败时替调用方释放）；MsgBuf_Receive 得到的引用由接收方在用完后
+MsgBuf_Release。同一缓冲要交给多个消费者时，先为每个额外的消费者
+MsgBuf_Ref 一次。引用数归零时缓冲块回到池里。
+*/
+#ifndef __MSG_BUF_H
+#define __MSG_BUF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "cmsis_os2.h"
+#include "uart.h"
+#include <stdbool.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define MSG_BUF_SIZE                UART_DMA_BUFFER_SIZE   // 含结尾的 '\0'
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    uint16_t length;                ///< data 中的字节数，data[length] 为 '\0'
+    uint16_t offset;                ///< 有效载荷的起点（+IPD 报文为 ':' 之后）
+    uint8_t  refs;                  ///< 引用计数，只经 MsgBuf_Ref / MsgBuf_Release 修改
+    char     data[MSG_BUF_SIZE];
+} MsgBuf_t;
+
+/* Exported variables --------------------------------------------------------*/
+extern osMemoryPoolId_t msgPoolHandle;
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 从池中取一块（不等待），引用数为 1；池空返回 NULL 并计数 */
+MsgBuf_t *MsgBuf_Alloc(void);
+
+/* 增加一个引用，返回 buf 本身 */
+MsgBuf_t *MsgBuf_Ref(MsgBuf_t *buf);
+
+/* 释放一个引用，最后一个引用释放时归还缓冲块 */
+void MsgBuf_Release(MsgBuf_t *buf);
+
+/* 把指针放入队列，调用方的引用随之转交；失败时释放该引用并返回 false */
+bool MsgBuf_Send(osMessageQueueId_t queue, MsgBuf_t *buf, uint32_t timeout);
+
+/* 从队列取一个缓冲（带 1 个引用），超时返回 NULL */
+MsgBuf_t *MsgBuf_Receive(osMessageQueueId_t queue, uint32_t timeout);
+
+/* 有效载荷（data + offset） */
+static inline const char *MsgBuf_Payload(const MsgBuf_t *buf)
+{
+    return buf->data + buf->offset;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MSG_BUF_H */
@@ -22,6 +22,10 @@
 #ifndef __OLED_H
 #define __OLED_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #include <stdint.h>
 #include "stdlib.h"
 #define OLED_MODE 0
@@ -33,26 +37,31 @@
 #define	Brightness	0xFF
 #define X_WIDTH 	128
 #define Y_WIDTH 	64
+#define OLED_PAGES	(Y_WIDTH/8)
 
-/* GPIO定义 */
-#define I2C_SCL_GPIO_Port   GPIOB
-#define I2C_SCL_Pin         GPIO_PIN_1
-#define I2C_SDA_GPIO_Port   GPIOB
-#define I2C_SDA_Pin         GPIO_PIN_0
-//-----------------OLED IIC端口定义----------------
-#define OLED_SCLK_Clr() HAL_GPIO_WritePin(I2C_SCL_GPIO_Port, I2C_SCL_Pin, GPIO_PIN_RESET)//SCL
-#define OLED_SCLK_Set()  HAL_GPIO_WritePin(I2C_SCL_GPIO_Port, I2C_SCL_Pin, GPIO_PIN_SET)
-
-#define OLED_SDIN_Clr() HAL_GPIO_WritePin(I2C_SDA_GPIO_Port, I2C_SDA_Pin, GPIO_PIN_RESET)//SDA
-#define OLED_SDIN_Set() HAL_GPIO_WritePin(I2C_SDA_GPIO_Port, I2C_SDA_Pin, GPIO_PIN_SET)
-
-
+/* I2C 引脚定义在 soft_i2c.h */
 #define OLED_CMD  0	//写命令
 #define OLED_DATA 1	//写数据
 
+//总线字节统计（含地址和控制字节）
+typedef struct {
+    uint32_t refreshes;
+    uint32_t total_bus_bytes;       //累计发送字节数
+    uint32_t last_bus_bytes;        //最近一次 OLED_Refresh 发送的字节数
+    uint32_t last_legacy_bytes;     //同样的绘制按逐字节事务直接写屏需要的字节数
+#ifdef OLED_FONT_PROFILE
+    uint32_t glyphs;                //OLED_ShowChar 绘制的字形数
+    uint32_t glyph_cycles;          //解码 + 写显存的累计周期数
+#endif
+} OLED_Stats_t;
+
 
 //OLED控制用函数
+//绘图函数只写显存，调用 OLED_Refresh 后才发送到屏幕
 void OLED_WR_Byte(unsigned dat,unsigned cmd);
+void OLED_Refresh(void);
+void OLED_WaitIdle(void);
+void OLED_GetStats(OLED_Stats_t *stats);
 void OLED_Display_On(void);
 void OLED_Display_Off(void);
 void OLED_Init(void);
@@ -76,6 +85,10 @@ void Write_IIC_Data(unsigned char IIC_Data);
 void Write_IIC_Byte(unsigned char IIC_Byte);
 
 void IIC_Wait_Ack();
+
+#ifdef __cplusplus
+}
+#endif
 #endif
 
 
@@ -0,0 +1,55 @@
+/*
+================================================================================
+oled_font.h - OLED 子集字库（由 tools/fontgen 生成）及字形解码
+================================================================================
+字形数据来自 oledfont.h 的完整字库，只收录 tools/fontgen/charset.txt 中列出的
+字符，生成到 oled_font_data.c。字形可选"非零字节掩码"压缩：每个字形前放
+ceil(n/8) 字节的掩码，第 i 位为 1 表示第 i 列字节非零并紧随其后存放，
+为 0 的列不占空间（字模中大量空白列）。
+
+定义 OLED_FONT_PROFILE 时 OLED_ShowChar 用 DWT 统计每个字形的解码+绘制周期，
+结果在 OLED_Stats_t.glyph_cycles / glyphs 中。
+*/
+#ifndef __OLED_FONT_H
+#define __OLED_FONT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define OLED_FONT_NONE              0xFF    // 索引表中未收录的字符
+#define OLED_FONT_MAX_BYTES         32      // 最大字形（16x16 汉字）解码后的字节数
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 子集字库描述
+ * @note  解码结果按页存放：out[page * width + x]
+ */
+typedef struct {
+    uint8_t         width;          // 列数
+    uint8_t         pages;          // 高度（页数，8 像素一页）
+    uint8_t         packed;         // 1: 非零字节掩码压缩；0: 原始字模
+    uint8_t         first;          // 索引表对应的第一个字符（汉字为序号 0）
+    uint8_t         count;          // 索引表长度
+    const uint8_t  *map;            // 字符 - first -> 字形号，OLED_FONT_NONE 表示未收录
+    const uint16_t *offset;         // 压缩时每个字形在 data 中的偏移；原始字模为 NULL
+    const uint8_t  *data;
+} OLED_Font_t;
+
+extern const OLED_Font_t OLED_Font6x8;
+extern const OLED_Font_t OLED_Font8x16;
+extern const OLED_Font_t OLED_FontHz16;
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 解码一个字形到 out（至少 width * pages 字节），返回字节数；未收录返回 0 */
+uint8_t OLED_Font_Decode(const OLED_Font_t *font, uint8_t chr, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OLED_FONT_H */
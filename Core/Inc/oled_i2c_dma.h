@@ -0,0 +1,53 @@
+/*
+================================================================================
+oled_i2c_dma.h - 硬件 I2C + DMA 显示传输头文件
+================================================================================
+*/
+#ifndef __OLED_I2C_DMA_H
+#define __OLED_I2C_DMA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "stdbool.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* I2C2 on PB10 (SCL) / PB11 (SDA), TX requests on DMA1_Channel4.
+   I2C1 is not used: its TX request is fixed to DMA1_Channel6 (USART2 RX). */
+#define OLED_I2C_DMA_SPEED_HZ       400000
+#define OLED_I2C_DMA_GPIO_Port      GPIOB
+#define OLED_I2C_DMA_SCL_Pin        GPIO_PIN_10
+#define OLED_I2C_DMA_SDA_Pin        GPIO_PIN_11
+#define OLED_I2C_DMA_TIMEOUT_MS     50      // > one 1 KB frame at 400 kHz (~23 ms)
+#define OLED_I2C_DMA_BUS_FREE_US    100     // wait for the previous STOP, ~10 bit times at 100 kHz
+
+/* Exported variables --------------------------------------------------------*/
+extern DMA_HandleTypeDef hdma_i2c2_tx;
+
+/* Exported functions prototypes ---------------------------------------------*/
+HAL_StatusTypeDef OLED_I2C_DMA_Init(void);
+
+/* Start count back-to-back write transactions of len bytes each, block k at first + k * stride.
+   Each block carries its own control byte; blocks are chained with a repeated start. */
+HAL_StatusTypeDef OLED_I2C_DMA_WriteBlocks(uint8_t addr, const uint8_t *first, uint16_t len,
+                                           uint16_t stride, uint8_t count);
+
+/* Block until the current transfer completes, return its result */
+HAL_StatusTypeDef OLED_I2C_DMA_Wait(uint32_t timeout);
+bool OLED_I2C_DMA_Busy(void);
+
+/* The last transfer ended because the device did not acknowledge (AF), as opposed
+   to a timeout, bus error or the bus still being busy */
+bool OLED_I2C_DMA_Nacked(void);
+
+void OLED_I2C_DMA_EV_IRQHandler(void);
+void OLED_I2C_DMA_ER_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OLED_I2C_DMA_H */
@@ -0,0 +1,29 @@
+/*
+================================================================================
+oled_spark.h - OLED 趋势图（sparkline）：一页高、每桶一列的 min/max 竖线
+================================================================================
+*/
+#ifndef __OLED_SPARK_H
+#define __OLED_SPARK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "oled.h"
+#include "sensor_history.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define OLED_SPARK_MAX_COLS         HISTORY_BUCKETS
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 在 page 页从 x 列开始画 n 个桶（从旧到新，每桶一列），纵轴按可见数据自动缩放；
+   只改写显存，内容不变的列不会被标脏，随后的 OLED_Refresh 最多发送这一页 */
+void OLED_Spark_Draw(uint8_t x, uint8_t page, const History_Bucket_t *b, uint8_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OLED_SPARK_H */
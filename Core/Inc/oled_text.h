@@ -0,0 +1,57 @@
+/*
+================================================================================
+oled_text.h - OLED 文本字段层：只重绘内容发生变化的字符格
+================================================================================
+*/
+#ifndef __OLED_TEXT_H
+#define __OLED_TEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "oled.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define OLED_TEXT_MAX_FIELDS        8
+#define OLED_TEXT_MAX_CHARS         (X_WIDTH / 6)   // 6x8 字体一行最多 21 个字符
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 文本层统计
+ * @note  full_bytes 为把所有字段整行重新写屏（每页一次定位 + 一次数据事务）需要的
+ *        总线字节数，saved_bytes = full_bytes - 本帧 OLED_Refresh 实际发送的字节数
+ */
+typedef struct {
+    uint32_t frames;
+    uint32_t cells_drawn;           // 累计重绘的字符格
+    uint32_t cells_skipped;         // 累计因内容未变而跳过的字符格
+    uint16_t last_cells_drawn;      // 最近一帧重绘的字符格
+    uint16_t last_full_bytes;
+    uint16_t last_bus_bytes;
+    uint16_t last_saved_bytes;
+    uint32_t total_saved_bytes;
+} OLED_TextStats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 注册一个文本字段：起点 (x, page)，宽 width 个字符，字体 8 或 16；返回字段 id，失败返回 -1 */
+int OLED_Text_AddField(uint8_t x, uint8_t page, uint8_t width, uint8_t size);
+
+/* 更新字段内容：逐字符与上次内容比较，只把变化的字符格写入显存；不足 width 补空格，超出截断 */
+void OLED_Text_Set(uint8_t field, const char *str);
+
+/* 发送本帧改动（OLED_Refresh）并统计节省的总线字节数 */
+void OLED_Text_Flush(void);
+
+/* 屏幕被其他绘图函数覆盖（如 OLED_Clear）后调用，下一次 Set 整行重绘 */
+void OLED_Text_Invalidate(void);
+
+/* 读取统计 */
+void OLED_Text_GetStats(OLED_TextStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OLED_TEXT_H */
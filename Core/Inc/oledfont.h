@@ -201,7 +201,7 @@ const unsigned char F8X16[]=
   0x00,0x06,0x01,0x01,0x02,0x02,0x04,0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,//~ 94
   0x00,0x0E,0x11,0x11,0x0E,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,// degree ° 95
 };
-char Hzk[][32]={
+const unsigned char Hzk[][32]={
 
 // ��(0) ��(1) ��(2) ��(3) ʪ(4) ��(5) ̨(6) ��(7) ��(8) ��(9)
 
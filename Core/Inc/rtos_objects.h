@@ -0,0 +1,93 @@
+/*
+================================================================================
+rtos_objects.h - 全部 RTOS 对象（任务/队列/互斥量/信号量/定时器）的静态分配表
+================================================================================
+每个对象的控制块、栈、消息缓冲或内存池块都是 rtos_objects.c 中按下表展开的静态数组，
+创建时只传入这些内存，FreeRTOS 堆不再参与。改动任务栈或队列深度只改这里；
+总量在编译期与 RTOS_RAM_BUDGET (config.h) 比较，链接后用 tools/ram_report
+查看每个对象的实际占用。
+*/
+#ifndef __RTOS_OBJECTS_H
+#define __RTOS_OBJECTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "cmsis_os2.h"
+#include "config.h"
+
+/* Exported constants --------------------------------------------------------*/
+/*   名称              入口函数               栈(字)  优先级 */
+#define RTOS_TASK_TABLE(X) \
+    X(MonitorTask,     vMonitorTask,          256,    osPriorityLow) \
+    X(ESP8266Task,     StartESP8266Task,      280,    osPriorityHigh) \
+    X(MQTTPublishTask, StartMQTTPublishTask,  320,    osPriorityNormal) \
+    X(DataProcessTask, StartDataProcessTask,  400,    osPriorityAboveNormal) \
+    X(OLED_Task,       OLED_Task,             200,    osPriorityBelowNormal) \
+    X(SensorTask,      StartSensorTask,       160,    osPriorityHigh1)
+
+/*   名称              深度                     消息类型 */
+#define RTOS_QUEUE_TABLE(X) \
+    X(uart2Queue,      4,                       MsgBuf_t *) \
+    X(mqttQueue,       4,                       MsgBuf_t *) \
+    X(statsQueue,      STATS_CLOSED_QUEUE_LEN,  Stats_Aggregate_t)
+
+/*   名称              块数  块类型；uart2Queue / mqttQueue 传递的 USART2 接收缓冲（msg_buf.h），
+     ISR 正在写的 1 块 + 两个消费者各持有 1 块 + 排队中的若干块 */
+#define RTOS_POOL_TABLE(X) \
+    X(msgPool,         6,    MsgBuf_t)
+
+#define RTOS_MUTEX_TABLE(X) \
+    X(uart2Mutex)
+
+/*   名称              最大计数  初值；后台 OLED 传输（HW/SOFT_ISR）的帧完成信号 */
+#if OLED_TRANSPORT != OLED_TRANSPORT_SOFT
+#define RTOS_SEMAPHORE_TABLE(X) \
+    X(oledDone,        1,        0)
+#else
+#define RTOS_SEMAPHORE_TABLE(X)
+#endif
+
+/*   名称              回调                     类型 */
+#define RTOS_TIMER_TABLE(X) \
+    X(keepAliveTimer,  KeepAliveTimer_Callback, osTimerPeriodic)
+
+/* 空闲任务与定时器服务任务的栈同样在表内静态分配 */
+#define RTOS_IDLE_STACK_WORDS       configMINIMAL_STACK_SIZE
+#define RTOS_TIMER_STACK_WORDS      configTIMER_TASK_STACK_DEPTH
+
+/* Exported types ------------------------------------------------------------*/
+#define RTOS_ENUM_TASK(obj, entry, words, prio)     RTOS_TASK_##obj,
+#define RTOS_ENUM_QUEUE(obj, depth, type)           RTOS_QUEUE_##obj,
+#define RTOS_ENUM_POOL(obj, count, type)            RTOS_POOL_##obj,
+#define RTOS_ENUM_MUTEX(obj)                        RTOS_MUTEX_##obj,
+#define RTOS_ENUM_SEMAPHORE(obj, max, initial)      RTOS_SEM_##obj,
+#define RTOS_ENUM_TIMER(obj, func, type)            RTOS_TIMER_##obj,
+
+typedef enum { RTOS_TASK_TABLE(RTOS_ENUM_TASK) RTOS_TASK_COUNT } Rtos_TaskId_t;
+typedef enum { RTOS_QUEUE_TABLE(RTOS_ENUM_QUEUE) RTOS_QUEUE_COUNT } Rtos_QueueId_t;
+typedef enum { RTOS_POOL_TABLE(RTOS_ENUM_POOL) RTOS_POOL_COUNT } Rtos_PoolId_t;
+typedef enum { RTOS_MUTEX_TABLE(RTOS_ENUM_MUTEX) RTOS_MUTEX_COUNT } Rtos_MutexId_t;
+typedef enum { RTOS_SEMAPHORE_TABLE(RTOS_ENUM_SEMAPHORE) RTOS_SEM_COUNT } Rtos_SemaphoreId_t;
+typedef enum { RTOS_TIMER_TABLE(RTOS_ENUM_TIMER) RTOS_TIMER_COUNT } Rtos_TimerId_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 用表中的静态内存创建对象；同一个对象只能创建一次，失败返回 NULL */
+osThreadId_t Rtos_ThreadNew(Rtos_TaskId_t id, void *argument);
+osMessageQueueId_t Rtos_QueueNew(Rtos_QueueId_t id);
+osMemoryPoolId_t Rtos_PoolNew(Rtos_PoolId_t id);
+osMutexId_t Rtos_MutexNew(Rtos_MutexId_t id);
+osSemaphoreId_t Rtos_SemaphoreNew(Rtos_SemaphoreId_t id);
+osTimerId_t Rtos_TimerNew(Rtos_TimerId_t id, void *argument);
+
+/* 表内全部对象占用的 RAM（字节），与链接报告中 rtos_* 符号之和一致 */
+uint32_t Rtos_StaticRamBytes(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RTOS_OBJECTS_H */
@@ -1,13 +1,136 @@
+/*
+================================================================================
+sensor.h - 传感器驱动框架头文件
+================================================================================
+*/
 #ifndef __SENSOR_H
 #define __SENSOR_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
 #include "main.h"
+#include "FreeRTOS.h"
 #include "stdbool.h"
+#include <stddef.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define SENSOR_MAX_DEVICES          4       // 注册表容量
+#define SENSOR_MAX_VALUES           4       // 每个传感器最多输出的数值个数
+#define SENSOR_READ_TIMEOUT_MS      200     // start_read 到完成的最长时间
+#define SENSOR_POLL_INTERVAL_MS     5       // 有读取进行中时的轮询间隔
+#define SENSOR_IDLE_WAIT_MAX_MS     1000    // 调度器单次最长休眠
+
+/* 采样抖动直方图桶上界(us)，最后一个桶收集所有更大的值 */
+#define SENSOR_JITTER_BUCKETS       8
+#define SENSOR_JITTER_BOUNDS_US     {50, 100, 250, 500, 1000, 2000, 5000}
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    SENSOR_OK = 0,
+    SENSOR_BUSY,                 ///< 读取尚未完成，稍后再轮询
+    SENSOR_ERROR,
+    SENSOR_ERROR_TIMEOUT,
+    SENSOR_ERROR_CHECKSUM
+} Sensor_Status_t;
+
+/**
+ * @brief 一次完整读取解码后的结果，数值为定点整数
+ * @note  timestamp 由调度器填为该样本的名义采样时刻（phase + k * period），
+ *        与实际启动时刻的偏差记录在抖动直方图中
+ */
+typedef struct {
+    TickType_t timestamp;
+    uint8_t    count;
+    int32_t    value[SENSOR_MAX_VALUES];
+} Sensor_Reading_t;
+
+/**
+ * @brief 传感器驱动虚表，所有函数均不得阻塞
+ * @note  start_read 发起转换；poll_complete 返回 SENSOR_BUSY 直到数据就绪；
+ *        decode 把驱动内部的原始帧转换为 Sensor_Reading_t
+ */
+typedef struct {
+    Sensor_Status_t (*init)(void *ctx);
+    Sensor_Status_t (*start_read)(void *ctx);
+    Sensor_Status_t (*poll_complete)(void *ctx);
+    Sensor_Status_t (*decode)(void *ctx, Sensor_Reading_t *out);
+} Sensor_Driver_t;
+
+/**
+ * @brief 单个输出数值的描述，value = 实际值 * 10^decimals
+ */
+typedef struct {
+    const char *name;            ///< 发布时使用的 JSON 键
+    uint8_t     decimals;
+} Sensor_ValueDesc_t;
+
+/**
+ * @brief 注册到框架的传感器实例（通常放在 flash 中）
+ */
+typedef struct {
+    const char               *name;
+    const Sensor_Driver_t    *driver;
+    void                     *ctx;
+    uint32_t                  period_ms;
+    uint32_t                  phase_ms;     ///< 采样时刻 = k * period_ms + phase_ms（基于内核 tick）
+    uint8_t                   value_count;
+    const Sensor_ValueDesc_t *values;
+} Sensor_Config_t;
+
+/**
+ * @brief 每个传感器的采样时刻抖动统计（实际启动时刻 - 名义采样时刻）
+ */
+typedef struct {
+    uint32_t samples;
+    uint32_t missed;             ///< 因启动过晚而跳过的采样时刻
+    uint32_t max_us;
+    uint16_t hist[SENSOR_JITTER_BUCKETS];
+} Sensor_Jitter_t;
+
+/**
+ * @brief 每次读取完成（成功或失败）后由调度器调用
+ * @note  在调度任务上下文中执行，应尽快返回
+ */
+typedef void (*Sensor_Listener_t)(uint8_t id, Sensor_Status_t status, const Sensor_Reading_t *reading);
 
-/* 初始化传感器 */
+/* Exported functions prototypes ---------------------------------------------*/
+/* 初始化（清空）传感器注册表 */
 bool Sensor_Init(void);
 
-/* 读取传感器数据 */
-bool Sensor_ReadData(float *temperature, float *humidity, uint16_t *pressure);
+/* 注册一个传感器，返回其 id，失败返回 -1 */
+int Sensor_Register(const Sensor_Config_t *config);
+
+/* 设置读取完成回调 */
+void Sensor_SetListener(Sensor_Listener_t listener);
+
+/* 执行一轮调度，返回下一次需要调度的绝对 tick（配合 vTaskDelayUntil 使用） */
+TickType_t Sensor_Schedule(void);
+
+/* 读取/清零采样抖动统计 */
+bool Sensor_GetJitter(uint8_t id, Sensor_Jitter_t *jitter);
+void Sensor_ResetJitter(uint8_t id);
+
+/* 微秒分辨率的单调时间（内核 tick + SysTick 计数值） */
+uint64_t Sensor_TimeUs(void);
+
+/* 获取已注册传感器数量及其配置 */
+uint8_t Sensor_Count(void);
+const Sensor_Config_t *Sensor_GetConfig(uint8_t id);
+
+/* 读取最近一次有效数据 */
+bool Sensor_GetLatest(uint8_t id, Sensor_Reading_t *reading);
+
+/* 按 decimals 位小数格式化一个定点数值，返回写入长度 */
+int Sensor_FormatValue(char *buf, size_t size, int32_t value, uint8_t decimals);
+
+/* 把所有有效数据格式化为 "name":value 列表，返回写入长度 */
+int Sensor_FormatJson(char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
 
-#endif /* __SENSOR_H */
\ No newline at end of file
+#endif /* __SENSOR_H */
@@ -0,0 +1,47 @@
+/*
+================================================================================
+sensor_history.h - 传感器历史环形缓冲（每桶 min/max），供 OLED 趋势图使用
+================================================================================
+*/
+#ifndef __SENSOR_HISTORY_H
+#define __SENSOR_HISTORY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "sensor.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define HISTORY_MAX_CHANNELS        2       // 记录历史的 (sensor, value) 对数量
+#define HISTORY_BUCKETS             32      // 每个通道的桶数，HISTORY_BUCKET_MS 见 config.h
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief 一个时间桶内读数的范围，单位为整数（已按 decimals 缩放掉小数位）
+ * @note  min > max 表示该桶没有读数
+ */
+typedef struct {
+    int8_t min;
+    int8_t max;
+} History_Bucket_t;
+
+#define History_BucketValid(b)      ((b)->min <= (b)->max)
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 为 sensor_id 的第 value_index 个数值建立历史通道，返回通道号，失败返回 -1 */
+int History_AddChannel(uint8_t sensor_id, uint8_t value_index);
+
+/* 把一次读数计入对应通道（在传感器调度任务中调用） */
+void History_Update(uint8_t sensor_id, const Sensor_Reading_t *reading);
+
+/* 取最近 n 个桶（截止到当前时刻，从旧到新），没有读数的桶为空；返回 0 表示通道无效 */
+uint8_t History_Read(int channel, History_Bucket_t *out, uint8_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_HISTORY_H */
@@ -0,0 +1,63 @@
+/*
+================================================================================
+sensor_stats.h - 传感器滚动窗口统计（min/max/mean/stddev）头文件
+================================================================================
+*/
+#ifndef __SENSOR_STATS_H
+#define __SENSOR_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "sensor.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define STATS_MAX_CHANNELS          8       // (sensor, value) 对的最大数量
+#define STATS_MAX_WINDOWS           2       // 每个通道的窗口数量上限
+/* 待发布的已关闭窗口：各传感器的窗口边界对齐到同一时刻，发布任务一个周期内
+   最多积压所有通道的所有窗口，即 (各传感器数值数之和) x 窗口数；通道表的上限
+   就是这个和。放不下的计入 stats_dropped 指标 */
+#define STATS_CLOSED_QUEUE_LEN      (STATS_MAX_CHANNELS * STATS_MAX_WINDOWS)
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    const char *name;           ///< 发布时的窗口名，例如 "1m"
+    uint32_t    length_ms;
+} Stats_Window_t;
+
+/**
+ * @brief 一个已关闭窗口的聚合结果，数值与原始读数使用相同的定点缩放
+ */
+typedef struct {
+    uint8_t    sensor_id;
+    uint8_t    value_index;
+    uint8_t    window;
+    uint16_t   count;
+    int32_t    min;
+    int32_t    max;
+    int32_t    mean;
+    int32_t    stddev;
+    TickType_t start;
+} Stats_Aggregate_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 初始化统计引擎，windows 表需在整个运行期有效 */
+void Stats_Init(const Stats_Window_t *windows, uint8_t window_count);
+
+/* 把一次读数计入所有窗口（在传感器调度任务中调用） */
+void Stats_Update(uint8_t sensor_id, const Sensor_Reading_t *reading);
+
+/* 取出一个已关闭的窗口聚合结果，timeout 为 0 时不阻塞 */
+bool Stats_GetClosed(Stats_Aggregate_t *agg, uint32_t timeout);
+
+/* 格式化为 JSON 对象 */
+int Stats_FormatJson(const Stats_Aggregate_t *agg, char *buf, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_STATS_H */
@@ -8,24 +8,36 @@
 #ifndef __SOFT_I2C_H
 #define __SOFT_I2C_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #include "main.h"
 #include "stm32f1xx_hal.h"
 
 /* GPIO定义 */
-#define I2C_SCL_GPIO_Port   GPIOB
+#define I2C_SCL_GPIO_BASE   GPIOB_BASE      // 改端口只改这里，Pin<> 与 HAL 用的是同一个值
+#define I2C_SCL_GPIO_Port   ((GPIO_TypeDef *)I2C_SCL_GPIO_BASE)
 #define I2C_SCL_Pin         GPIO_PIN_1
-#define I2C_SDA_GPIO_Port   GPIOB
+#define I2C_SDA_GPIO_BASE   GPIOB_BASE
+#define I2C_SDA_GPIO_Port   ((GPIO_TypeDef *)I2C_SDA_GPIO_BASE)
 #define I2C_SDA_Pin         GPIO_PIN_0
 
 /* OLED I2C地址 */
 #define OLED_ADDRESS        0x78  // 0x3C << 1
 
-/* GPIO操作宏 */
-#define SCL_H()     HAL_GPIO_WritePin(I2C_SCL_GPIO_Port, I2C_SCL_Pin, GPIO_PIN_SET)
-#define SCL_L()     HAL_GPIO_WritePin(I2C_SCL_GPIO_Port, I2C_SCL_Pin, GPIO_PIN_RESET)
-#define SDA_H()     HAL_GPIO_WritePin(I2C_SDA_GPIO_Port, I2C_SDA_Pin, GPIO_PIN_SET)
-#define SDA_L()     HAL_GPIO_WritePin(I2C_SDA_GPIO_Port, I2C_SDA_Pin, GPIO_PIN_RESET)
-#define READ_SDA()  HAL_GPIO_ReadPin(I2C_SDA_GPIO_Port, I2C_SDA_Pin)
+/* SSD1306 控制字节（Co = 0，后续字节全部为同一类型） */
+#define OLED_CONTROL_CMD    0x00
+#define OLED_CONTROL_DATA   0x40
+
+#ifdef SOFT_I2C_PROFILE
+/* 用 DWT->CYCCNT 统计 I2C_Send_Byte/I2C_Wait_Ack 的周期数，delay_cycles 为其中的延时部分 */
+typedef struct {
+    uint32_t bits;          // 已发送的位数（含应答位）
+    uint32_t cycles;        // 总周期数
+    uint32_t delay_cycles;  // I2C_Delay_us 消耗的周期数
+} I2C_Profile_t;
+#endif
 
 /* 函数声明 */
 void Soft_I2C_Init(void);
@@ -36,7 +48,16 @@ void I2C_Ack(void);
 void I2C_NAck(void);
 void I2C_Send_Byte(uint8_t data);
 uint8_t I2C_Read_Byte(void);
+uint8_t I2C_Write_Buffer(uint8_t addr, uint8_t control, const uint8_t *buf, uint16_t len);
+uint8_t I2C_Write_CmdList(uint8_t addr, const uint8_t *cmds, uint16_t len);
 void OLED_Write_Cmd(uint8_t cmd);
 void OLED_Write_Data(uint8_t data);
+#ifdef SOFT_I2C_PROFILE
+void I2C_GetProfile(I2C_Profile_t *profile, uint8_t reset);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif /* __SOFT_I2C_H */
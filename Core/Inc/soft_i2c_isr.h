@@ -0,0 +1,64 @@
+/*=================================================================
+ * 文件: soft_i2c_isr.h
+ * 描述: 定时器中断驱动的后台模拟I2C头文件
+ * 作者: 开发者
+ * 日期: 2025
+ *=================================================================*/
+
+#ifndef __SOFT_I2C_ISR_H
+#define __SOFT_I2C_ISR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "main.h"
+#include "stdbool.h"
+#include "soft_i2c.h"
+
+/* 每个定时器中断推进半个位：SCL = I2C_ISR_TICK_HZ / 2 */
+#define I2C_ISR_TICK_HZ     200000U     // 100 kHz SCL
+#define I2C_ISR_TIM         TIM4
+#define I2C_ISR_TIM_IRQn    TIM4_IRQn
+
+/* 传输结果 */
+typedef enum {
+    I2C_ISR_OK = 0,
+    I2C_ISR_NACK,
+    I2C_ISR_BUSY
+} I2C_ISR_Status_t;
+
+/* 传输描述符：一次事务 = 起始 + 地址 + 控制字节 + len 字节数据 + 停止，
+   next 非空时接着发送下一个事务 */
+typedef struct I2C_ISR_Xfer {
+    struct I2C_ISR_Xfer *next;
+    const uint8_t       *data;
+    uint16_t             len;
+    uint8_t              addr;
+    uint8_t              control;
+} I2C_ISR_Xfer_t;
+
+/* 整条描述符链发送完成（或出错）后在中断上下文中调用 */
+typedef void (*I2C_ISR_Callback_t)(I2C_ISR_Status_t status, void *arg);
+
+/* 统计：中断耗时与总线忙时间（DWT 周期数） */
+typedef struct {
+    uint32_t transfers;
+    uint32_t bytes;
+    uint32_t nacks;
+    uint32_t isr_cycles;        // 中断处理函数累计周期
+    uint32_t busy_cycles;       // 描述符链从提交到完成的累计周期
+} I2C_ISR_Stats_t;
+
+/* 函数声明 */
+void I2C_ISR_Init(void);
+I2C_ISR_Status_t I2C_ISR_Submit(const I2C_ISR_Xfer_t *chain, I2C_ISR_Callback_t done, void *arg);
+bool I2C_ISR_Busy(void);
+void I2C_ISR_GetStats(I2C_ISR_Stats_t *stats, bool reset);
+void I2C_ISR_TIM_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SOFT_I2C_ISR_H */
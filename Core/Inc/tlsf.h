@@ -0,0 +1,72 @@
+/*
+================================================================================
+tlsf.h - 两级分离适配（TLSF）分配器：O(1) 分配/释放，不依赖 RTOS
+================================================================================
+空闲块按大小分到 TLSF_FL_COUNT x TLSF_SL_COUNT 条链表里：一级是 2 的幂区间，
+二级把每个区间再等分成 TLSF_SL_COUNT 份。两级各有一个位图，分配时用两次
+“找最低置位”直接定位到一条一定放得下的链表，取表头；释放时与前后相邻的
+空闲块立即合并。两者都不遍历链表，耗时与堆里有多少块无关。
+
+块头 8 字节，块内位置用 16 位偏移（单位 TLSF_ALIGN）表示，所以块头大小与
+指针宽度无关，主机上的基准测试与目标板上的布局一致；单个内存池最大
+TLSF_MAX_POOL 字节。heap_tlsf.c 用它实现 FreeRTOS 的 pvPortMalloc / vPortFree，
+tools/heap_bench 在主机上直接调用本文件。
+*/
+#ifndef __TLSF_H
+#define __TLSF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/* Exported constants --------------------------------------------------------*/
+#define TLSF_ALIGN                  8       // 与 portBYTE_ALIGNMENT 相同
+#define TLSF_HEADER_SIZE            8       // 每个块（已用或空闲）的开销
+#define TLSF_SL_LOG2                2       // 每个 2 的幂区间分 4 条链表，最坏多找 25%
+#define TLSF_SL_COUNT               (1U << TLSF_SL_LOG2)
+#define TLSF_FL_COUNT               14      // 块长 15 位（单位 TLSF_ALIGN）：最高位 14 - TLSF_SL_LOG2 + 1 = 13
+#define TLSF_MAX_POOL               (0x7FFFUL * TLSF_ALIGN)
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct {
+    uint8_t  *base;                                 ///< 对齐后的池起点，块偏移以此为 0
+    size_t    free_bytes;                           ///< 全部空闲块之和（含块头）
+    uint16_t  fl_bitmap;                            ///< 第 i 位：一级 i 下有非空链表
+    uint8_t   sl_bitmap[TLSF_FL_COUNT];             ///< 第 j 位：链表 [i][j] 非空
+    uint16_t  heads[TLSF_FL_COUNT][TLSF_SL_COUNT];  ///< 链表头的块偏移，0xFFFF 为空
+} Tlsf_t;
+
+typedef struct {
+    size_t free_bytes;
+    size_t largest_free;            ///< 最大空闲块（含块头），能分配的最大请求比它小 TLSF_HEADER_SIZE
+    size_t smallest_free;
+    size_t free_blocks;
+} Tlsf_Stats_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+/* 用 mem 开始的 size 字节建池（起点按 TLSF_ALIGN 对齐，超出 TLSF_MAX_POOL 的部分不用）；
+   空间连一个块都放不下返回 false */
+bool Tlsf_Init(Tlsf_t *tlsf, void *mem, size_t size);
+
+/* 分配 size 字节，返回 TLSF_ALIGN 对齐的指针；放不下或 size 为 0 返回 NULL */
+void *Tlsf_Alloc(Tlsf_t *tlsf, size_t size);
+
+/* 释放；p 为 NULL 时不做任何事，p 不是已分配的块时返回 false */
+bool Tlsf_Free(Tlsf_t *tlsf, void *p);
+
+/* 已分配块的大小（含块头） */
+size_t Tlsf_BlockSize(const Tlsf_t *tlsf, const void *p);
+
+/* 遍历整个池统计空闲块，耗时与块数成正比，只用于报告 */
+void Tlsf_GetStats(const Tlsf_t *tlsf, Tlsf_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TLSF_H */
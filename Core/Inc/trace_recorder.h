@@ -0,0 +1,145 @@
+/*
+================================================================================
+trace_recorder.h - 内核事件跟踪：任务切换、队列操作、中断进出写入 RAM 环形缓冲
+================================================================================
+FreeRTOSConfig.h 包含本文件，TRACE_RECORDER 为 1 时下面的 trace 宏接到内核
+钩子上（宏在 tasks.c / queue.c 内部展开，可以直接读 TCB 和队列结构体）；
+中断进出借用 CpuStats_IsrEnter/Exit 已经包好的位置。每个事件是 8 字节记录：
+     u32 DWT 周期计数
+     u8  事件类型（Trace_Event_t）
+     u8  参数 a：任务号 / 队列号 / 异常号 / 标记号
+     u16 参数 b：队列中的消息数 / 标记附加值 / 堆块地址
+环形缓冲写满后覆盖最旧的记录。Trace_Trigger() 冻结缓冲，监控任务随后调用
+Trace_Dump() 把快照按帧经 Console_Write 发到 USART1：
+     u8 TRACE_SYNC, u8 帧类型, u8 长度, 内容
+帧类型见 TRACE_FRAME_*。主机端 tools/tracecv 从串口流中提取快照，转换成
+Chrome 跟踪格式（chrome://tracing 或 Perfetto 打开）。
+
+任务号是内核的 uxTCBNumber（与 TaskStatus_t.xTaskNumber 相同），队列号由
+Trace_NameObject() 在 rtos_objects.c 创建对象时分配，0 表示未命名的内核队列。
+TRACE_RECORDER 为 0 时所有宏和函数都是空的，不占 RAM。
+*/
+#ifndef __TRACE_RECORDER_H
+#define __TRACE_RECORDER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "config.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define TRACE_SYNC                  0xFE    // 与 DLOG_SYNC 一样不会出现在 ASCII 文本中
+#define TRACE_VERSION               1
+#define TRACE_RECORD_SIZE           8
+#define TRACE_LABEL_MAX             21      // 标记文字最多 3 条续记录，每条 7 字节
+#define TRACE_MAX_OBJECTS           12      // 可命名的队列/互斥量/信号量数
+
+#define TRACE_FRAME_HEADER          'H'     // u8 版本, u32 CPU 频率, u32 冻结时的周期计数, u32 冻结时的 tick, u32 事件总数, u16 缓冲记录数
+#define TRACE_FRAME_TASK            'T'     // u8 任务号, 任务名
+#define TRACE_FRAME_OBJECT          'Q'     // u8 队列号, 对象名
+#define TRACE_FRAME_RECORDS         'R'     // 若干条 8 字节记录，从旧到新
+#define TRACE_FRAME_END             'E'
+#define TRACE_FRAME_MAX             64      // 单帧内容的最大长度
+
+/*   名称；代码中的耗时区间，主机端显示为跟踪中的一段 */
+#define TRACE_MARK_TABLE(X) \
+    X(esp_cmd) \
+    X(esp_send) \
+    X(mqtt_publish)
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum {
+    TRACE_EV_SWITCH_IN = 1,         ///< a = 任务号
+    TRACE_EV_READY,                 ///< a = 进入就绪的任务号
+    TRACE_EV_DELAY,                 ///< 当前任务 vTaskDelay / vTaskDelayUntil
+    TRACE_EV_ISR_ENTER,             ///< a = 异常号
+    TRACE_EV_ISR_EXIT,
+    TRACE_EV_QUEUE_SEND,            ///< a = 队列号, b = 发送前的消息数
+    TRACE_EV_QUEUE_SEND_FAILED,
+    TRACE_EV_QUEUE_RECEIVE,         ///< a = 队列号, b = 接收前的消息数
+    TRACE_EV_QUEUE_RECEIVE_FAILED,
+    TRACE_EV_QUEUE_BLOCK_SEND,      ///< 队列满，当前任务阻塞
+    TRACE_EV_QUEUE_BLOCK_RECEIVE,   ///< 队列空（或互斥量被占），当前任务阻塞
+    TRACE_EV_MARK_START,            ///< a = 标记号, b = 附加值，后面可跟 TRACE_EV_TEXT
+    TRACE_EV_MARK_STOP,             ///< a = 标记号, b = 附加值
+    TRACE_EV_TEXT,                  ///< 续记录：除类型字节外的 7 字节是前一条记录的文字
+    TRACE_EV_MALLOC,                ///< a = 块长 / 8（含块头，最大 255）, b = 地址相对 SRAM 起点 / 8，0xFFFF 为失败
+    TRACE_EV_FREE,                  ///< 同上
+} Trace_Event_t;
+
+#define TRACE_ENUM_MARK(obj)        TRACE_MARK_##obj,
+typedef enum { TRACE_MARK_TABLE(TRACE_ENUM_MARK) TRACE_MARK_COUNT } Trace_Mark_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+#if TRACE_RECORDER
+/* 在调度器启动前调用一次，开始记录 */
+void Trace_Init(void);
+
+/* 记录一个事件；内核钩子、任务和中断里都可以调用（短暂关中断） */
+void Trace_Event(uint8_t type, uint8_t a, uint16_t b);
+
+/* 给队列/互斥量/信号量分配队列号并记下名字，快照中一起发出 */
+void Trace_NameObject(void *handle, const char *name);
+
+/* 堆分配/释放（traceMALLOC / traceFREE），size 为含块头的块长 */
+void Trace_Heap(uint8_t type, const void *address, size_t size);
+
+/* 区间标记；label 可为 NULL，最多记录 TRACE_LABEL_MAX 字节 */
+void Trace_MarkStart(Trace_Mark_t mark, uint16_t value, const char *label);
+void Trace_MarkStop(Trace_Mark_t mark, uint16_t value);
+
+/* 冻结缓冲，保留触发前的事件，等待 Trace_Dump 发出；已冻结时不做任何事 */
+void Trace_Trigger(void);
+
+/* 任务上下文：已触发（或 force 为真）时发出快照，清空缓冲后继续记录；
+   返回是否发出了快照。控制台缓冲满时会 vTaskDelay 等待 */
+bool Trace_Dump(bool force);
+#else
+#define Trace_Init()                            ((void)0)
+#define Trace_Event(type, a, b)                 ((void)0)
+#define Trace_NameObject(handle, name)          ((void)0)
+#define Trace_Heap(type, address, size)         ((void)0)
+#define Trace_MarkStart(mark, value, label)     ((void)0)
+#define Trace_MarkStop(mark, value)             ((void)0)
+#define Trace_Trigger()                         ((void)0)
+#define Trace_Dump(force)                       (false)
+#endif /* TRACE_RECORDER */
+
+/* FreeRTOS trace hooks ------------------------------------------------------*/
+#if TRACE_RECORDER
+#define traceTASK_SWITCHED_IN() \
+    Trace_Event(TRACE_EV_SWITCH_IN, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+    Trace_Event(TRACE_EV_READY, (uint8_t)(pxTCB)->uxTCBNumber, 0)
+#define traceTASK_DELAY() \
+    Trace_Event(TRACE_EV_DELAY, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+#define traceTASK_DELAY_UNTIL(xTimeToWake) \
+    Trace_Event(TRACE_EV_DELAY, (uint8_t)pxCurrentTCB->uxTCBNumber, 0)
+
+#define TRACE_QUEUE_(type, pxQueue) \
+    Trace_Event((type), (uint8_t)(pxQueue)->uxQueueNumber, (uint16_t)(pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND(pxQueue)                    TRACE_QUEUE_(TRACE_EV_QUEUE_SEND, pxQueue)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue)           TRACE_QUEUE_(TRACE_EV_QUEUE_SEND, pxQueue)
+#define traceQUEUE_SEND_FAILED(pxQueue)             TRACE_QUEUE_(TRACE_EV_QUEUE_SEND_FAILED, pxQueue)
+#define traceQUEUE_SEND_FROM_ISR_FAILED(pxQueue)    TRACE_QUEUE_(TRACE_EV_QUEUE_SEND_FAILED, pxQueue)
+#define traceQUEUE_RECEIVE(pxQueue)                 TRACE_QUEUE_(TRACE_EV_QUEUE_RECEIVE, pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)        TRACE_QUEUE_(TRACE_EV_QUEUE_RECEIVE, pxQueue)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue)          TRACE_QUEUE_(TRACE_EV_QUEUE_RECEIVE_FAILED, pxQueue)
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED(pxQueue) TRACE_QUEUE_(TRACE_EV_QUEUE_RECEIVE_FAILED, pxQueue)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue)        TRACE_QUEUE_(TRACE_EV_QUEUE_BLOCK_SEND, pxQueue)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue)     TRACE_QUEUE_(TRACE_EV_QUEUE_BLOCK_RECEIVE, pxQueue)
+
+#define traceMALLOC(pvAddress, uiSize)              Trace_Heap(TRACE_EV_MALLOC, (pvAddress), (uiSize))
+#define traceFREE(pvAddress, uiSize)                Trace_Heap(TRACE_EV_FREE, (pvAddress), (uiSize))
+#endif /* TRACE_RECORDER */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TRACE_RECORDER_H */
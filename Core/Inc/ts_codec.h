@@ -0,0 +1,76 @@
+/*
+================================================================================
+ts_codec.h - Gorilla 风格时间序列压缩（时间戳 delta-of-delta + 数值 XOR）
+================================================================================
+*/
+#ifndef __TS_CODEC_H
+#define __TS_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Exported constants --------------------------------------------------------*/
+/* Worst case bits for one sample: '1111'+32 timestamp, '11'+5+5+32 value */
+#define TS_CODEC_MAX_SAMPLE_BITS    80
+
+/* Define TS_CODEC_PROFILE to accumulate DWT cycles spent in TS_Encode_Append */
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @brief Encoder state. The caller owns the buffer; it is append-only and
+ *        every append costs a bounded number of bit writes (O(1)).
+ */
+typedef struct {
+    uint8_t  *buf;
+    uint32_t  capacity_bits;
+    uint32_t  bit_pos;
+    uint16_t  count;
+    uint32_t  t_prev;
+    int32_t   t_delta;
+    uint32_t  v_prev;
+    uint8_t   v_lead;           ///< previous XOR window, leading zeros
+    uint8_t   v_len;            ///< previous XOR window, meaningful bits (0 = none)
+#ifdef TS_CODEC_PROFILE
+    uint32_t  cycles;
+#endif
+} TS_Encoder_t;
+
+typedef struct {
+    const uint8_t *buf;
+    uint32_t  size_bits;
+    uint32_t  bit_pos;
+    uint16_t  count;
+    uint16_t  index;
+    uint32_t  t_prev;
+    int32_t   t_delta;
+    uint32_t  v_prev;
+    uint8_t   v_lead;
+    uint8_t   v_len;
+    bool      error;        // 读过 size_bits 或遇到非法字段，之后的 Next 都返回 false
+} TS_Decoder_t;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void TS_Encode_Init(TS_Encoder_t *enc, uint8_t *buf, uint16_t size);
+
+/**
+ * @brief 追加一个样本（整数时间戳 + 整数值）
+ * @retval false 缓冲区剩余空间不足，样本未写入
+ */
+bool TS_Encode_Append(TS_Encoder_t *enc, uint32_t timestamp, int32_t value);
+
+/* 已使用的字节数（最后一个字节可能只用了部分位） */
+uint16_t TS_Encode_Bytes(const TS_Encoder_t *enc);
+
+void TS_Decode_Init(TS_Decoder_t *dec, const uint8_t *buf, uint32_t size_bits, uint16_t count);
+bool TS_Decode_Next(TS_Decoder_t *dec, uint32_t *timestamp, int32_t *value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TS_CODEC_H */
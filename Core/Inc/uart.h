@@ -13,12 +13,6 @@ extern "C" {
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 
-/* Exported types ------------------------------------------------------------*/
-typedef struct {
-    char data[256];
-    uint16_t length;
-} UartMessage_t;
-
 /* Exported constants --------------------------------------------------------*/
 #define UART_BUFFER_SIZE            512
 #define UART_DMA_BUFFER_SIZE        256
@@ -27,7 +21,6 @@ typedef struct {
 
 /* Exported variables --------------------------------------------------------*/
 extern uint8_t uart2_dma_buffer[UART_DMA_BUFFER_SIZE];
-extern uint8_t uart2_process_buffer[UART_DMA_BUFFER_SIZE];
 extern volatile uint16_t uart2_last_dma_size;
 
 /* Exported functions prototypes ---------------------------------------------*/
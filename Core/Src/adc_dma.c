@@ -0,0 +1,238 @@
+/*
+================================================================================
+adc_dma.c - ADC1 定时器触发扫描 + DMA 双缓冲采样实现文件
+================================================================================
+*/
+#include "adc_dma.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+/* Private defines -----------------------------------------------------------*/
+#define ADC_DMA_HALF_LEN    (ADC_DMA_BLOCK_SCANS * ADC_DMA_NUM_CHANNELS)
+#define ADC_DMA_BUF_LEN     (ADC_DMA_HALF_LEN * 2)
+
+/* ADC_CR2 EXTSEL = 100b: TIM3 TRGO */
+#define ADC_DMA_EXTSEL_TIM3_TRGO    (ADC_CR2_EXTSEL_2)
+
+/* Private variables ---------------------------------------------------------*/
+DMA_HandleTypeDef hdma_adc1;
+TIM_HandleTypeDef htim3;
+
+static uint16_t adc_dma_buffer[ADC_DMA_BUF_LEN];
+static volatile ADC_DMA_Block_t adc_dma_block;
+
+static const uint8_t adc_dma_sequence[ADC_DMA_NUM_CHANNELS] = {
+    ADC_DMA_CH_VREFINT,
+    ADC_DMA_CH_TEMPSENSOR,
+    ADC_DMA_CH_PROBE0,
+    ADC_DMA_CH_PROBE1,
+};
+
+/* Private function prototypes -----------------------------------------------*/
+static void ADC_DMA_HalfCpltCallback(DMA_HandleTypeDef *hdma);
+static void ADC_DMA_CpltCallback(DMA_HandleTypeDef *hdma);
+static void ADC_DMA_Accumulate(const uint16_t *half);
+
+/**
+  * @brief  Configure ADC1 for scan mode, DMA1_Channel1 circular transfer and TIM3 trigger
+  * @retval HAL_StatusTypeDef
+  */
+HAL_StatusTypeDef ADC_DMA_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    TIM_MasterConfigTypeDef sMasterConfig = {0};
+    uint32_t sqr3 = 0;
+
+    /* Clocks: ADCCLK = PCLK2 / 6 = 12 MHz (max 14 MHz) */
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_TIM3_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    MODIFY_REG(RCC->CFGR, RCC_CFGR_ADCPRE, RCC_CFGR_ADCPRE_DIV6);
+
+    /* External probes as analog inputs */
+    GPIO_InitStruct.Pin = ADC_DMA_PROBE_PINS;
+    GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+    HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+    /* ADC1: scan mode, DMA requests, TIM3 TRGO trigger, internal channels on */
+    ADC1->CR1 = ADC_CR1_SCAN;
+    ADC1->CR2 = ADC_CR2_DMA | ADC_CR2_EXTTRIG | ADC_DMA_EXTSEL_TIM3_TRGO | ADC_CR2_TSVREFE;
+
+    /* 239.5 cycles on every channel: temperature sensor needs >= 17.1 us */
+    ADC1->SMPR1 = 0x00FFFFFF;
+    ADC1->SMPR2 = 0x3FFFFFFF;
+
+    for(uint8_t i = 0; i < ADC_DMA_NUM_CHANNELS; i++)
+    {
+        sqr3 |= (uint32_t)adc_dma_sequence[i] << (5U * i);
+    }
+    ADC1->SQR1 = (uint32_t)(ADC_DMA_NUM_CHANNELS - 1) << ADC_SQR1_L_Pos;
+    ADC1->SQR2 = 0;
+    ADC1->SQR3 = sqr3;
+
+    /* Power up, wait tSTAB (1 us), then calibrate. HAL tick is not running under FreeRTOS */
+    ADC1->CR2 |= ADC_CR2_ADON;
+    for(volatile uint32_t i = 0; i < 200; i++) {}
+    ADC1->CR2 |= ADC_CR2_RSTCAL;
+    while(ADC1->CR2 & ADC_CR2_RSTCAL) {}
+    ADC1->CR2 |= ADC_CR2_CAL;
+    while(ADC1->CR2 & ADC_CR2_CAL) {}
+
+    /* DMA1_Channel1: ADC1 DR -> double buffer, circular */
+    hdma_adc1.Instance = DMA1_Channel1;
+    hdma_adc1.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_adc1.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_adc1.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_adc1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_adc1.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_adc1.Init.Mode = DMA_CIRCULAR;
+    hdma_adc1.Init.Priority = DMA_PRIORITY_MEDIUM;
+    if (HAL_DMA_Init(&hdma_adc1) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+    hdma_adc1.XferHalfCpltCallback = ADC_DMA_HalfCpltCallback;
+    hdma_adc1.XferCpltCallback = ADC_DMA_CpltCallback;
+
+    HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+    if (HAL_DMA_Start_IT(&hdma_adc1, (uint32_t)&ADC1->DR, (uint32_t)adc_dma_buffer, ADC_DMA_BUF_LEN) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    /* TIM3: 72 MHz / 72 = 1 MHz tick, update event drives TRGO */
+    htim3.Instance = TIM3;
+    htim3.Init.Prescaler = (SystemCoreClock / 1000000) - 1;
+    htim3.Init.CounterMode = TIM_COUNTERMODE_UP;
+    htim3.Init.Period = (1000000 / ADC_DMA_SCAN_RATE_HZ) - 1;
+    htim3.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    htim3.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+    if (HAL_TIM_Base_Init(&htim3) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+    sMasterConfig.MasterOutputTrigger = TIM_TRGO_UPDATE;
+    sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+    if (HAL_TIMEx_MasterConfigSynchronization(&htim3, &sMasterConfig) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+
+    return HAL_TIM_Base_Start(&htim3);
+}
+
+/**
+  * @brief  Stop the trigger timer, the DMA stream and power down ADC1
+  * @retval None
+  */
+void ADC_DMA_Stop(void)
+{
+    HAL_TIM_Base_Stop(&htim3);
+    HAL_DMA_Abort_IT(&hdma_adc1);
+    ADC1->CR2 &= ~ADC_CR2_ADON;
+}
+
+/**
+  * @brief  Copy the most recent block average
+  * @param  block: destination
+  * @retval Sequence number of the block (0 = no block yet)
+  */
+uint32_t ADC_DMA_GetBlock(ADC_DMA_Block_t *block)
+{
+    taskENTER_CRITICAL();
+    memcpy(block, (const void *)&adc_dma_block, sizeof(*block));
+    taskEXIT_CRITICAL();
+
+    return block->sequence;
+}
+
+/**
+  * @brief  Sum one half buffer per channel and publish it as the latest block
+  * @note   Runs in DMA IRQ context; the other half is being filled meanwhile
+  */
+static void ADC_DMA_Accumulate(const uint16_t *half)
+{
+    uint32_t sum[ADC_DMA_NUM_CHANNELS] = {0};
+
+    for(uint32_t i = 0; i < ADC_DMA_HALF_LEN; i += ADC_DMA_NUM_CHANNELS)
+    {
+        for(uint8_t ch = 0; ch < ADC_DMA_NUM_CHANNELS; ch++)
+        {
+            sum[ch] += half[i + ch];
+        }
+    }
+
+    for(uint8_t ch = 0; ch < ADC_DMA_NUM_CHANNELS; ch++)
+    {
+        adc_dma_block.sum[ch] = sum[ch];
+    }
+    adc_dma_block.sequence++;
+}
+
+static void ADC_DMA_HalfCpltCallback(DMA_HandleTypeDef *hdma)
+{
+    ADC_DMA_Accumulate(&adc_dma_buffer[0]);
+}
+
+static void ADC_DMA_CpltCallback(DMA_HandleTypeDef *hdma)
+{
+    ADC_DMA_Accumulate(&adc_dma_buffer[ADC_DMA_HALF_LEN]);
+}
+
+/* Sensor framework adapter --------------------------------------------------*/
+static Sensor_Status_t ADC_DMA_Sensor_Init(void *ctx)
+{
+    memset(ctx, 0, sizeof(ADC_DMA_Block_t));
+    return ADC_DMA_Init() == HAL_OK ? SENSOR_OK : SENSOR_ERROR;
+}
+
+/* A read completes with the first block that finishes after start_read */
+static Sensor_Status_t ADC_DMA_Sensor_Start(void *ctx)
+{
+    ADC_DMA_Block_t *frame = (ADC_DMA_Block_t *)ctx;
+    frame->sequence = adc_dma_block.sequence;
+    return SENSOR_OK;
+}
+
+static Sensor_Status_t ADC_DMA_Sensor_Poll(void *ctx)
+{
+    ADC_DMA_Block_t *frame = (ADC_DMA_Block_t *)ctx;
+    uint32_t requested = frame->sequence;
+
+    if(adc_dma_block.sequence == requested)
+        return SENSOR_BUSY;
+
+    ADC_DMA_GetBlock(frame);
+    return SENSOR_OK;
+}
+
+/* Voltages are ratiometric to Vrefint, so Vdda drops out of the probe values */
+static Sensor_Status_t ADC_DMA_Sensor_Decode(void *ctx, Sensor_Reading_t *out)
+{
+    const ADC_DMA_Block_t *frame = (const ADC_DMA_Block_t *)ctx;
+    uint32_t vref = frame->sum[ADC_DMA_IDX_VREFINT];
+    uint32_t ts_01mv;
+
+    if(vref == 0)
+        return SENSOR_ERROR;
+
+    out->count = 4;
+    out->value[0] = (int32_t)((uint32_t)ADC_DMA_VREFINT_MV * 4095U * ADC_DMA_BLOCK_SCANS / vref);
+    ts_01mv = (uint32_t)ADC_DMA_VREFINT_MV * 10U * frame->sum[ADC_DMA_IDX_TEMPSENSOR] / vref;
+    out->value[1] = 250 + ((int32_t)ADC_DMA_TS_V25_MV * 10 - (int32_t)ts_01mv) * 1000 / ADC_DMA_TS_SLOPE_UV;
+    out->value[2] = (int32_t)((uint32_t)ADC_DMA_VREFINT_MV * frame->sum[ADC_DMA_IDX_PROBE0] / vref);
+    out->value[3] = (int32_t)((uint32_t)ADC_DMA_VREFINT_MV * frame->sum[ADC_DMA_IDX_PROBE1] / vref);
+
+    return SENSOR_OK;
+}
+
+const Sensor_Driver_t ADC_DMA_SensorDriver = {
+    .init = ADC_DMA_Sensor_Init,
+    .start_read = ADC_DMA_Sensor_Start,
+    .poll_complete = ADC_DMA_Sensor_Poll,
+    .decode = ADC_DMA_Sensor_Decode,
+};
@@ -10,9 +10,28 @@ tasks.c - FreeRTOS任务实现文件
 #include "mqtt.h"
 #include "config.h"
 #include "dht11.h"
+#include "sensor.h"
+#include "adc_dma.h"
+#include "sensor_stats.h"
+#include "sensor_history.h"
 #include "tim1_us.h"
 #include "my_printf.h"
+#include "dlog.h"
+#include "rtos_objects.h"
+#include "msg_buf.h"
+#include "bus.h"
+#include "cpu_stats.h"
+#include "metrics.h"
+#include "console.h"
+#include "trace_recorder.h"
 #include "oled.h"
+#include "oled_text.h"
+#include "oled_spark.h"
+#if OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+#include "soft_i2c_isr.h"
+#elif OLED_TRANSPORT == OLED_TRANSPORT_SOFT
+#include "soft_i2c.h"
+#endif
 
 
 /* Private variables ---------------------------------------------------------*/
@@ -21,16 +40,58 @@ osThreadId_t MonitorTaskHandle;
 osThreadId_t ESP8266TaskHandle;
 osThreadId_t MQTTPublishTaskHandle;
 osThreadId_t DataProcessTaskHandle;
+osThreadId_t SensorTaskHandle;
 /* OLED任务句柄 */
-osThreadId oledTaskHandle;
+osThreadId_t oledTaskHandle;
 /* Queue handles */
 osMessageQueueId_t uart2QueueHandle;
 osMessageQueueId_t mqttQueueHandle;
-osMessageQueueId_t dht11QueueHandle;
-osMessageQueueId_t ledQueueHandle;
-typedef struct {
-    char* pin_state;
-} LED_Message_t;
+
+/* OLED_Task wake-up flags: set by the producer right after it queues the data */
+#define OLED_EVT_SENSOR             0x01U
+#define OLED_EVT_LED                0x02U
+#define OLED_EVT_ALL                (OLED_EVT_SENSOR | OLED_EVT_LED)
+
+/* Sensor registry -----------------------------------------------------------*/
+static DHT11_Data_t dht11_frame;
+static const Sensor_ValueDesc_t dht11_values[] = {
+    { "temperature", 1 },
+    { "humidity",    1 },
+};
+static const Sensor_Config_t dht11_sensor = {
+    .name = "dht11",
+    .driver = &DHT11_SensorDriver,
+    .ctx = &dht11_frame,
+    .period_ms = 5000,
+    .phase_ms = 0,
+    .value_count = 2,
+    .values = dht11_values,
+};
+static int dht11_sensor_id = -1;
+static int history_temp = -1;
+static int history_humi = -1;
+
+static const Stats_Window_t stats_windows[] = {
+    { "1m", STATS_WINDOW_SHORT_MS },
+    { "1h", STATS_WINDOW_LONG_MS },
+};
+
+static ADC_DMA_Block_t adc_frame;
+static const Sensor_ValueDesc_t adc_values[] = {
+    { "vdda",     3 },
+    { "mcu_temp", 1 },
+    { "ain1",     3 },
+    { "ain4",     3 },
+};
+static const Sensor_Config_t adc_sensor = {
+    .name = "adc1",
+    .driver = &ADC_DMA_SensorDriver,
+    .ctx = &adc_frame,
+    .period_ms = 5000,
+    .phase_ms = 2500,           // Half a period away from the DHT11 capture window
+    .value_count = 4,
+    .values = adc_values,
+};
 
 /* Mutex handles */
 osMutexId_t uart2MutexHandle;
@@ -39,7 +100,7 @@ osMutexId_t uart2MutexHandle;
 osTimerId_t keepAliveTimerHandle;
 
 /* Private function prototypes -----------------------------------------------*/
-void KeepAliveTimer_Callback(void *argument);
+static void Sensor_Listener(uint8_t id, Sensor_Status_t status, const Sensor_Reading_t *reading);
 /* Private variables ---------------------------------------------------------*/
 
 /**
@@ -48,52 +109,25 @@ void KeepAliveTimer_Callback(void *argument);
   */
 void Tasks_Init(void)
 {
+    /* Every object comes from the static table in rtos_objects.h; stack sizes and queue depths live there */
+    /* Create the message buffer pool before the queues that carry its pointers */
+    msgPoolHandle = Rtos_PoolNew(RTOS_POOL_msgPool);
     /* Create queues */
-    uart2QueueHandle = osMessageQueueNew(4, sizeof(UartMessage_t), NULL);
-    mqttQueueHandle = osMessageQueueNew(4, sizeof(MQTT_Message_t), NULL);
-    dht11QueueHandle = osMessageQueueNew(4, sizeof(DHT11_Data_t), NULL);
-    ledQueueHandle = osMessageQueueNew(3, sizeof(LED_Message_t), NULL);
+    uart2QueueHandle = Rtos_QueueNew(RTOS_QUEUE_uart2Queue);
+    mqttQueueHandle = Rtos_QueueNew(RTOS_QUEUE_mqttQueue);
     /* Create mutex */
-    uart2MutexHandle = osMutexNew(NULL);
+    uart2MutexHandle = Rtos_MutexNew(RTOS_MUTEX_uart2Mutex);
 
     /* Create timer */
-    keepAliveTimerHandle = osTimerNew(KeepAliveTimer_Callback, osTimerPeriodic, NULL, NULL);
+    keepAliveTimerHandle = Rtos_TimerNew(RTOS_TIMER_keepAliveTimer, NULL);
 
     /* Create threads */
-    const osThreadAttr_t defaultTask_attributes = {
-            .name = "vMonitorTask",
-            .stack_size = 256 * 4,
-            .priority = (osPriority_t) osPriorityLow,
-    };
-    MonitorTaskHandle = osThreadNew(vMonitorTask, NULL, &defaultTask_attributes);
-
-    const osThreadAttr_t ESP8266Task_attributes = {
-            .name = "ESP8266Task",
-            .stack_size = 280 * 4,
-            .priority = (osPriority_t) osPriorityHigh,
-    };
-    ESP8266TaskHandle = osThreadNew(StartESP8266Task, NULL, &ESP8266Task_attributes);
-
-    const osThreadAttr_t MQTTPublishTask_attributes = {
-            .name = "MQTTPublishTask",
-            .stack_size = 320 * 4,
-            .priority = (osPriority_t) osPriorityNormal,
-    };
-    MQTTPublishTaskHandle = osThreadNew(StartMQTTPublishTask, NULL, &MQTTPublishTask_attributes);
-
-    const osThreadAttr_t DataProcessTask_attributes = {
-            .name = "DataProcessTask",
-            .stack_size = 400 * 4,
-            .priority = (osPriority_t) osPriorityAboveNormal,
-    };
-    DataProcessTaskHandle = osThreadNew(StartDataProcessTask, NULL, &DataProcessTask_attributes);
-
-    const osThreadAttr_t vMonitorTask_attributes = {
-            .name = "OLED_Task",
-            .stack_size = 200 * 4,
-            .priority = (osPriority_t) osPriorityBelowNormal,
-    };
-    oledTaskHandle = osThreadNew(OLED_Task, NULL, &vMonitorTask_attributes);
+    MonitorTaskHandle = Rtos_ThreadNew(RTOS_TASK_MonitorTask, NULL);
+    ESP8266TaskHandle = Rtos_ThreadNew(RTOS_TASK_ESP8266Task, NULL);
+    MQTTPublishTaskHandle = Rtos_ThreadNew(RTOS_TASK_MQTTPublishTask, NULL);
+    DataProcessTaskHandle = Rtos_ThreadNew(RTOS_TASK_DataProcessTask, NULL);
+    oledTaskHandle = Rtos_ThreadNew(RTOS_TASK_OLED_Task, NULL);
+    SensorTaskHandle = Rtos_ThreadNew(RTOS_TASK_SensorTask, NULL);
 }
 
 /**
@@ -200,6 +234,7 @@ void StartESP8266Task(void *argument)
 
         if(!mqtt_connected && wifi_connected)
         {
+            Metric_Inc(METRIC_COUNTER_mqtt_reconnects);
             MQTT_Connect();
             MQTT_Subscribe(MQTT_TOPIC_SUB);
         }
@@ -213,29 +248,100 @@ void StartESP8266Task(void *argument)
   * @retval None
   */
 void StartMQTTPublishTask(void *argument) {
-    char payload[128];
+    char payload[200];
+#if STATS_PUBLISH_RAW
     uint32_t counter = 0;
-    DHT11_Data_t data;
+#endif
+    int len;
+    Stats_Aggregate_t agg;
+    TickType_t last_wake = xTaskGetTickCount();
+    TickType_t last_metrics = last_wake;
     for (;;) {
         if (mqtt_connected) {
-            if (DHT11_Read_Raw_Data(&data) == DHT11_OK) {
-                // Create sensor data payload (example)
-                GPIO_PinState pin_state = HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13);
-                snprintf(payload, sizeof(payload),
-                         "{\"timestamp\":%lu,\"temperature\":%d,\"humidity\":%d,\"led_state\":%s,\"counter\":%lu}",
-                         osKernelGetTickCount(), data.temperature_int, data.humidity_int, pin_state==0?"ON":"OFF", counter++);
+#if STATS_PUBLISH_RAW
+            // Create sensor data payload from every registered sensor
+            GPIO_PinState pin_state = HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13);
+            len = snprintf(payload, sizeof(payload), "{\"timestamp\":%lu,", osKernelGetTickCount());
+            // Leave room for the led_state/counter trailer
+            len += Sensor_FormatJson(payload + len, sizeof(payload) - len - 40);
+            if (payload[len - 1] != ',')
+                payload[len++] = ',';
+            snprintf(payload + len, sizeof(payload) - len,
+                     "\"led_state\":%s,\"counter\":%lu}", pin_state==0?"ON":"OFF", counter++);
+
+            // Publish data
+            MQTT_Publish(MQTT_TOPIC_PUB, payload);
+#endif
+            // Publish aggregates of every window closed since the last cycle
+            while (Stats_GetClosed(&agg, 0)) {
+                if (Stats_FormatJson(&agg, payload, sizeof(payload)) > 0)
+                    MQTT_Publish(MQTT_TOPIC_AGG, payload);
+            }
 
-                // Publish data
-                MQTT_Publish(MQTT_TOPIC_PUB, payload);
-                osMessageQueuePut(dht11QueueHandle, &data, 0, 0);
+            // Device health metrics, binary (see metrics_table.h), at a low rate
+            if (xTaskGetTickCount() - last_metrics >= pdMS_TO_TICKS(METRICS_PUBLISH_MS)) {
+                last_metrics = xTaskGetTickCount();
+                len = Metrics_Serialize((uint8_t *)payload, sizeof(payload));
+                if (len > 0)
+                    MQTT_PublishRaw(MQTT_TOPIC_SYS, (const uint8_t *)payload, (uint16_t)len);
             }
         }
 
-        osDelay(5000); // Publish every 30 seconds
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(5000)); // Publish every 5 seconds, without drift
     }
 }
 
+/**
+  * @brief  Sensor scheduler task: interleaves non-blocking reads of all registered sensors
+  * @param  argument: Not used
+  * @retval None
+  */
+void StartSensorTask(void *argument)
+{
+    Sensor_Init();
+    Stats_Init(stats_windows, sizeof(stats_windows) / sizeof(stats_windows[0]));
+    dht11_sensor_id = Sensor_Register(&dht11_sensor);
+    history_temp = History_AddChannel(dht11_sensor_id, 0);
+    history_humi = History_AddChannel(dht11_sensor_id, 1);
+    Sensor_Register(&adc_sensor);
+    Sensor_SetListener(Sensor_Listener);
+
+    for(;;)
+    {
+        // Sleep until an absolute tick so sampling instants stay on the k * period + phase grid
+        TickType_t wake = Sensor_Schedule();
+        TickType_t now = xTaskGetTickCount();
+        if((int32_t)(wake - now) > 0)
+            vTaskDelayUntil(&now, wake - now);
+    }
+}
+
+/**
+  * @brief  Feed completed sensor readings to the statistics engine and the display
+  * @retval None
+  */
+static void Sensor_Listener(uint8_t id, Sensor_Status_t status, const Sensor_Reading_t *reading)
+{
+    Sensor_Event_t event;
+
+    if(status != SENSOR_OK)
+    {
+        Metric_Inc(METRIC_COUNTER_sensor_errors);
+        return;
+    }
+
+    Metric_Inc(METRIC_COUNTER_sensor_events);
+    Stats_Update(id, reading);
+    History_Update(id, reading);
 
+    // The display only shows the DHT11 values; other sensors must not wake it
+    if(id != dht11_sensor_id)
+        return;
+
+    event.id = id;
+    event.reading = *reading;
+    Bus_Publish_sensor(&event);
+}
 
 /**
   * @brief  Data processing task
@@ -247,25 +353,29 @@ void StartDataProcessTask(void *argument)
     for(;;)
     {
         // Process MQTT messages
-        MQTT_Message_t mqtt_msg;
         LED_Message_t led_state;
-        if(osMessageQueueGet(mqttQueueHandle, &mqtt_msg, NULL, 100) == osOK)
+        MsgBuf_t *msg = MsgBuf_Receive(mqttQueueHandle, 100);
+        if(msg != NULL)
         {
+            /* The payload points into the buffer the UART ISR filled; skip the 10-byte prefix if present */
+            const char *command = (msg->length - msg->offset > 10) ? MsgBuf_Payload(msg) + 10 : "";
+            Metric_Inc(METRIC_COUNTER_mqtt_commands);
             // Handle received MQTT command
-            if(strstr(mqtt_msg.payload + 10, "LED_ON") != NULL)
+            if(strstr(command, "LED_ON") != NULL)
             {
                 HAL_GPIO_WritePin(LED_GPIO_PORT, LED_PIN, GPIO_PIN_RESET);
                 GPIO_PinState pin_state = HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13);
                 led_state.pin_state=pin_state==0?"ON":"OFF";
-                osMessageQueuePut(ledQueueHandle, &led_state, 0, 0);
+                Bus_Publish_led(&led_state);
             }
-            else if(strstr(mqtt_msg.payload + 10, "LED_OFF") != NULL)
+            else if(strstr(command, "LED_OFF") != NULL)
             {
                 HAL_GPIO_WritePin(LED_GPIO_PORT, LED_PIN, GPIO_PIN_SET);
                 GPIO_PinState pin_state = HAL_GPIO_ReadPin(GPIOC, GPIO_PIN_13);
                 led_state.pin_state=pin_state==1?"OFF":"ON";
-                osMessageQueuePut(ledQueueHandle, &led_state, 0, 0);
+                Bus_Publish_led(&led_state);
             }
+            MsgBuf_Release(msg);
         }
     }
 }
@@ -280,59 +390,259 @@ void OLED_Task(void  * argument)
     OLED_Init();
     OLED_Clear();
 
-    DHT11_Data_t sensor_data = {0};
+    /* 四行 8x16 文本字段；温湿度行只占 12 个字符，右侧 32 列留给趋势图 */
+    int field_temp = OLED_Text_AddField(0, 0, 12, 16);
+    int field_humi = OLED_Text_AddField(0, 2, 12, 16);
+    int field_cnt = OLED_Text_AddField(0, 4, 16, 16);
+    int field_tick = OLED_Text_AddField(0, 6, 16, 16);
+
+    History_Bucket_t history[HISTORY_BUCKETS];
+    const Sensor_Event_t *event;
+    const LED_Message_t *led;
+    uint32_t sensor_cursor = 0;
+    uint32_t led_cursor = 0;
+    int32_t temperature = 0;
+    int32_t humidity = 0;
     LED_Message_t led_state = {"ON"};
     uint8_t need_refresh = 1;
+    uint32_t last_frame = osKernelGetTickCount() - pdMS_TO_TICKS(OLED_FRAME_MIN_MS);
+
+    /* 订阅之前发布的值仍在主题的环里，首帧按游标 0 读到 */
+    Bus_Subscribe(BUS_TOPIC_sensor, osThreadGetId(), OLED_EVT_SENSOR);
+    Bus_Subscribe(BUS_TOPIC_led, osThreadGetId(), OLED_EVT_LED);
 
     for(;;)
     {
-        /* 非阻塞轮询两个队列，互不干扰 */
-        if(osMessageQueueGet(dht11QueueHandle, &sensor_data, NULL, 0) == osOK)
+        /* 没有新数据时一直阻塞，空闲时不再周期性唤醒；首帧直接绘制 */
+        if(!need_refresh)
+        {
+            osThreadFlagsWait(OLED_EVT_ALL, osFlagsWaitAny, osWaitForever);
+            Metric_Inc(METRIC_COUNTER_oled_wakeups);
+
+            /* 帧率上限：距上一帧不足 OLED_FRAME_MIN_MS 时先等一等，期间到达的事件合并到这一帧 */
+            uint32_t elapsed = osKernelGetTickCount() - last_frame;
+            if(elapsed < pdMS_TO_TICKS(OLED_FRAME_MIN_MS))
+                osDelay(pdMS_TO_TICKS(OLED_FRAME_MIN_MS) - elapsed);
+
+            /* 先清标志再读总线：读完之后才发布的数据会重新置位，不会漏掉 */
+            osThreadFlagsClear(OLED_EVT_ALL);
+        }
+
+        /* 只要最新值，直接读主题环里的槽；读的过程中被新发布改写了就再取一次 */
+        while((event = Bus_Latest_sensor(&sensor_cursor)) != NULL)
+        {
+            temperature = event->reading.value[0] / 10;
+            humidity = event->reading.value[1] / 10;
             need_refresh = 1;
+            if(Bus_Valid(BUS_TOPIC_sensor, sensor_cursor))
+                break;
+        }
 
-        if(osMessageQueueGet(ledQueueHandle, &led_state, NULL, 0) == osOK)
+        while((led = Bus_Latest_led(&led_cursor)) != NULL)
+        {
+            led_state = *led;
             need_refresh = 1;
+            if(Bus_Valid(BUS_TOPIC_led, led_cursor))
+                break;
+        }
 
         if(need_refresh)
         {
             need_refresh = 0;
             counter++;
+            Metric_Inc(METRIC_COUNTER_oled_frames);
+            last_frame = osKernelGetTickCount();
+            uint32_t frame_start = DWT->CYCCNT;
 
-            snprintf(str, sizeof(str), "Temp: %d \x7F""C     ", sensor_data.temperature_int);
-            OLED_ShowString(0, 0, str, 16);
+            /* 硬件 I2C 传输时，上一帧 DMA 完成后才能改写显存 */
+            OLED_WaitIdle();
 
-            snprintf(str, sizeof(str), "Humi: %d %%RH    ", sensor_data.humidity_int);
-            OLED_ShowString(0, 2, str, 16);
+            /* 文本层逐字符比较，只重绘变化的字符格，不足一行自动补空格 */
+            snprintf(str, sizeof(str), "Temp: %ld \x7F""C", (long)temperature);
+            OLED_Text_Set(field_temp, str);
 
-            snprintf(str, sizeof(str), "Cnt:%-5lu  %s   ", counter, led_state.pin_state);
-            OLED_ShowString(0, 4, str, 16);
+            snprintf(str, sizeof(str), "Humi: %ld %%RH", (long)humidity);
+            OLED_Text_Set(field_humi, str);
+
+            snprintf(str, sizeof(str), "Cnt:%-5lu  %s", counter, led_state.pin_state);
+            OLED_Text_Set(field_cnt, str);
 
             snprintf(str, sizeof(str), "Tick: %lu", osKernelGetTickCount());
-            OLED_ShowString(0, 6, str, 16);
+            OLED_Text_Set(field_tick, str);
+
+            /* 最近 HISTORY_BUCKETS 个桶的趋势图，与文本行的下半页对齐，每个只占一页 */
+            if(History_Read(history_temp, history, HISTORY_BUCKETS))
+                OLED_Spark_Draw(X_WIDTH - HISTORY_BUCKETS, 1, history, HISTORY_BUCKETS);
+            if(History_Read(history_humi, history, HISTORY_BUCKETS))
+                OLED_Spark_Draw(X_WIDTH - HISTORY_BUCKETS, 3, history, HISTORY_BUCKETS);
+
+            /* 只发送与上一帧不同的列（趋势图换桶时也只多出一页） */
+            OLED_Text_Flush();
+            Metric_Observe(METRIC_HIST_oled_frame_us, (DWT->CYCCNT - frame_start) / (SystemCoreClock / 1000000U));
         }
+    }
+}
 
-        osDelay(100);
+/**
+  * @brief  Print the sampling jitter histogram of every registered sensor
+  * @retval None
+  */
+static void show_sensor_jitter(void)
+{
+    Sensor_Jitter_t j;
+    for(uint8_t id = 0; id < Sensor_Count(); id++)
+    {
+        if(!Sensor_GetJitter(id, &j))
+            continue;
+        // Buckets: <50 <100 <250 <500 <1000 <2000 <5000 >=5000 us
+        DLOG("jitter %s n:%d miss:%d max:%dus\r\n",
+             Sensor_GetConfig(id)->name, j.samples, j.missed, j.max_us);
+        DLOG("jitter hist:%d/%d/%d/%d/%d/%d/%d/%d\r\n",
+             j.hist[0], j.hist[1], j.hist[2], j.hist[3],
+             j.hist[4], j.hist[5], j.hist[6], j.hist[7]);
     }
 }
 
+/**
+  * @brief  Print CPU load (window average, 0.1% units) per task, in interrupts and idle
+  * @retval None
+  */
+static void show_cpu_stats(void)
+{
+    CpuStats_Summary_t sum;
+    CpuStats_Task_t task;
+    CpuStats_GetSummary(&sum);
+    DLOG("cpu %dms busy:%d isr:%d idle:%d (permille)\r\n", sum.window_ms, sum.busy, sum.isr, sum.idle);
+    for(uint8_t i = 0; CpuStats_GetTask(i, &task); i++)
+        DLOG("cpu %s:%d last:%d\r\n", task.name, task.load, task.last);
+}
+
+/**
+  * @brief  Print I2C bytes sent by the last OLED refresh vs. the per-byte transaction path
+  * @retval None
+  */
+static void show_oled_stats(void)
+{
+    OLED_Stats_t stats;
+    OLED_GetStats(&stats);
+    DLOG("oled task wakeups:%d frames:%d\r\n",
+         Metric_Counter(METRIC_COUNTER_oled_wakeups), Metric_Counter(METRIC_COUNTER_oled_frames));
+    DLOG("oled refresh:%d bus:%dB legacy:%dB total:%dB\r\n",
+         stats.refreshes, stats.last_bus_bytes, stats.last_legacy_bytes, stats.total_bus_bytes);
+#ifdef OLED_FONT_PROFILE
+    if(stats.glyphs)
+        DLOG("oled glyph cycles:%d\r\n", stats.glyph_cycles / stats.glyphs);
+#endif
+    // Text layer: glyph cells redrawn in the last frame and bus bytes saved vs. rewriting every line
+    OLED_TextStats_t text;
+    OLED_Text_GetStats(&text);
+    DLOG("oled text cells:%d skipped:%d saved:%dB/%dB total saved:%dB\r\n",
+         text.last_cells_drawn, text.cells_skipped, text.last_saved_bytes, text.last_full_bytes,
+         text.total_saved_bytes);
+#if OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+    // CPU cost of the background bit-bang engine over the last monitor period (~1 s)
+    I2C_ISR_Stats_t isr;
+    I2C_ISR_GetStats(&isr, true);
+    DLOG("i2c isr bytes:%d nack:%d cpu:%d.%d%% (%d%% while busy)\r\n",
+         isr.bytes, isr.nacks,
+         isr.isr_cycles / (SystemCoreClock / 100), (isr.isr_cycles / (SystemCoreClock / 1000)) % 10,
+         isr.busy_cycles ? (int)((uint64_t)isr.isr_cycles * 100 / isr.busy_cycles) : 0);
+#endif
+#if OLED_TRANSPORT == OLED_TRANSPORT_SOFT && defined(SOFT_I2C_PROFILE)
+    // Bit-bang cost per bit; "gpio" excludes the fixed I2C_Delay_us half-periods
+    I2C_Profile_t prof;
+    I2C_GetProfile(&prof, 1);
+    if(prof.bits)
+    {
+        DLOG("soft i2c cyc/bit:%d gpio:%d\r\n", prof.cycles / prof.bits,
+             (prof.cycles - prof.delay_cycles) / prof.bits);
+    }
+#endif
+}
+
+/**
+  * @brief  Refresh the system gauges of the metrics registry (uptime, heap, CPU load)
+  * @retval None
+  */
+static void update_system_metrics(void)
+{
+    CpuStats_Summary_t cpu;
+    HeapStats_t heap = { 0 };
+    CpuStats_GetSummary(&cpu);
+    // heap_4 (FREERTOS_HEAP_TLSF=OFF) walks past the end of an empty free list in vPortGetHeapStats
+    if(xPortGetFreeHeapSize() > 0)
+        vPortGetHeapStats(&heap);
+    Metric_Set(METRIC_GAUGE_uptime_s, (int32_t)(xTaskGetTickCount() / configTICK_RATE_HZ));
+    Metric_Set(METRIC_GAUGE_heap_free, (int32_t)xPortGetFreeHeapSize());
+    Metric_Set(METRIC_GAUGE_heap_min_free, (int32_t)xPortGetMinimumEverFreeHeapSize());
+    Metric_Set(METRIC_GAUGE_heap_largest_free, (int32_t)heap.xSizeOfLargestFreeBlockInBytes);
+    // Fragmentation in permille: the share of free memory outside the largest free block
+    Metric_Set(METRIC_GAUGE_heap_frag, heap.xAvailableHeapSpaceInBytes == 0 ? 0 :
+               (int32_t)(1000 - heap.xSizeOfLargestFreeBlockInBytes * 1000 / heap.xAvailableHeapSpaceInBytes));
+    Metric_Set(METRIC_GAUGE_cpu_busy, cpu.busy);
+    Metric_Set(METRIC_GAUGE_cpu_isr, cpu.isr);
+}
+
 void show_task_list(void)
 {
-    char buffer[128];
-    memset(buffer, 0, sizeof(buffer));
-    vTaskList(buffer);
-    size_t freeHeap = xPortGetFreeHeapSize();
-    size_t minFreeHeap = xPortGetMinimumEverFreeHeapSize();
-    my_printf("Name\t\tState\tPrio\tStack\tNum\tfreeHeap\tminFreeHeap\r\n");
-    my_printf("%s\t\t\t\t\t\t%d\t\t%d\r\n", buffer, freeHeap, minFreeHeap);
-//    my_printf("freeHeap:%d byte\r\n", freeHeap);
-//    my_printf("minFreeHeap:%d byte\r\n", minFreeHeap);
+    // One line per task straight from the kernel: vTaskList() has no buffer size and overran 128 bytes
+    static const char state_name[] = "XRBSD?";   // eRunning..eInvalid, same letters as vTaskList
+    TaskStatus_t tasks[CPU_STATS_MAX_TASKS];
+    UBaseType_t n = uxTaskGetSystemState(tasks, CPU_STATS_MAX_TASKS, NULL);
+    uint16_t stack_min = UINT16_MAX;
+
+    DLOG("Name\t\tState\tPrio\tStack\tNum\r\n");
+    for(UBaseType_t i = 0; i < n; i++)
+    {
+        eTaskState state = tasks[i].eCurrentState <= eInvalid ? tasks[i].eCurrentState : eInvalid;
+        DLOG("%s\t\t%c\t%d\t%d\t%d\r\n", tasks[i].pcTaskName, state_name[state],
+             tasks[i].uxCurrentPriority, tasks[i].usStackHighWaterMark, tasks[i].xTaskNumber);
+        if(tasks[i].usStackHighWaterMark < stack_min)
+            stack_min = tasks[i].usStackHighWaterMark;
+    }
+    if(n == 0)
+        DLOG("more than %d tasks\r\n", CPU_STATS_MAX_TASKS);
+    else
+        Metric_Set(METRIC_GAUGE_stack_min_free, stack_min);
+
+    DLOG("freeHeap:%d minFreeHeap:%d largest:%d frag:%d rtos static:%dB\r\n",
+         xPortGetFreeHeapSize(), xPortGetMinimumEverFreeHeapSize(),
+         Metric_Gauge(METRIC_GAUGE_heap_largest_free), Metric_Gauge(METRIC_GAUGE_heap_frag), Rtos_StaticRamBytes());
+    Console_Stats_t con;
+    Console_GetStats(&con);
+    DLOG("console bytes:%d dropped:%d/%dB peak:%dB\r\n", con.bytes, con.dropped, con.dropped_bytes, con.max_used);
+    show_cpu_stats();
+    show_sensor_jitter();
+    show_oled_stats();
+}
+
+/**
+  * @brief  Send the frozen trace snapshot (slow ESP8266 command) or a periodic one
+  * @retval None
+  */
+static void dump_trace(void)
+{
+#if TRACE_RECORDER && TRACE_DUMP_MS > 0
+    static TickType_t last_dump = 0;
+
+    if(xTaskGetTickCount() - last_dump >= pdMS_TO_TICKS(TRACE_DUMP_MS))
+    {
+        last_dump = xTaskGetTickCount();
+        (void)Trace_Dump(true);
+        return;
+    }
+#endif
+    (void)Trace_Dump(false);
 }
 
 void vMonitorTask(void *pvParameters)
 {
     while (1)
     {
+        CpuStats_Sample();
+        update_system_metrics();
         show_task_list();
+        dump_trace();
         vTaskDelay(pdMS_TO_TICKS(1000));  // 每 5 秒打印一次
     }
 }
@@ -0,0 +1,122 @@
+/*
+================================================================================
+bus.c - 发布/订阅总线实现文件
+================================================================================
+发布者在关中断时写槽并递增序号，因此槽的内容和序号对读者总是一致的；读者不加
+锁，只靠序号判断自己读的槽是否已被改写。通知在开中断之后逐个发出。
+*/
+#include "bus.h"
+#include "metrics.h"
+#include <string.h>
+
+/* Private macros ------------------------------------------------------------*/
+#define BUS_STORAGE_TOPIC(name, type, depth) \
+    static type bus_ring_##name[depth];
+#define BUS_DESC_TOPIC(name, type, n) \
+    { .ring = bus_ring_##name, .size = sizeof(type), .depth = (n) },
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    void    *ring;
+    uint16_t size;
+    uint8_t  depth;
+} Bus_TopicDesc_t;
+
+typedef struct {
+    osThreadId_t thread;
+    uint32_t     flags;
+} Bus_Subscriber_t;
+
+/* Private variables ---------------------------------------------------------*/
+BUS_TOPIC_TABLE(BUS_STORAGE_TOPIC)
+
+static const Bus_TopicDesc_t g_bus_topics[BUS_TOPIC_COUNT] = { BUS_TOPIC_TABLE(BUS_DESC_TOPIC) };
+static uint32_t g_bus_head[BUS_TOPIC_COUNT];                // 已发布的条数，下一条写入 head % depth
+static Bus_Subscriber_t g_bus_subs[BUS_TOPIC_COUNT][BUS_MAX_SUBSCRIBERS];
+static uint8_t g_bus_sub_count[BUS_TOPIC_COUNT];
+
+/* Private functions ---------------------------------------------------------*/
+static const void *Bus_Slot(Bus_Topic_t topic, uint32_t seq)
+{
+    const Bus_TopicDesc_t *t = &g_bus_topics[topic];
+
+    return (const uint8_t *)t->ring + (seq % t->depth) * t->size;
+}
+
+static uint32_t Bus_Head(Bus_Topic_t topic)
+{
+    return __atomic_load_n(&g_bus_head[topic], __ATOMIC_ACQUIRE);
+}
+
+/* Public functions ----------------------------------------------------------*/
+bool Bus_Subscribe(Bus_Topic_t topic, osThreadId_t thread, uint32_t flags)
+{
+    uint32_t primask = __get_PRIMASK();
+    bool ok = false;
+
+    __disable_irq();
+    if (g_bus_sub_count[topic] < BUS_MAX_SUBSCRIBERS) {
+        g_bus_subs[topic][g_bus_sub_count[topic]].thread = thread;
+        g_bus_subs[topic][g_bus_sub_count[topic]].flags = flags;
+        g_bus_sub_count[topic]++;
+        ok = true;
+    }
+    __set_PRIMASK(primask);
+    return ok;
+}
+
+void Bus_Publish(Bus_Topic_t topic, const void *msg)
+{
+    const Bus_TopicDesc_t *t = &g_bus_topics[topic];
+    uint32_t primask = __get_PRIMASK();
+    uint32_t head;
+    uint8_t n;
+
+    __disable_irq();
+    head = g_bus_head[topic];
+    memcpy((uint8_t *)t->ring + (head % t->depth) * t->size, msg, t->size);
+    __atomic_store_n(&g_bus_head[topic], head + 1U, __ATOMIC_RELEASE);
+    n = g_bus_sub_count[topic];
+    __set_PRIMASK(primask);
+
+    /* 订阅只增不减，前 n 个登记项已经写完 */
+    for (uint8_t i = 0; i < n; i++) {
+        osThreadFlagsSet(g_bus_subs[topic][i].thread, g_bus_subs[topic][i].flags);
+    }
+}
+
+const void *Bus_Latest(Bus_Topic_t topic, uint32_t *cursor)
+{
+    uint32_t head = Bus_Head(topic);
+
+    if (head == *cursor) {
+        return NULL;
+    }
+    *cursor = head;
+    return Bus_Slot(topic, head - 1U);
+}
+
+const void *Bus_Next(Bus_Topic_t topic, uint32_t *cursor)
+{
+    uint32_t head = Bus_Head(topic);
+    uint32_t depth = g_bus_topics[topic].depth;
+    const void *slot;
+
+    if (head == *cursor) {
+        return NULL;
+    }
+    if (head - *cursor > depth) {
+        Metric_Add(METRIC_COUNTER_bus_overruns, head - depth - *cursor);
+        *cursor = head - depth;
+    }
+    slot = Bus_Slot(topic, *cursor);
+    (*cursor)++;
+    return slot;
+}
+
+bool Bus_Valid(Bus_Topic_t topic, uint32_t cursor)
+{
+    /* 读槽的访存必须先于这次读序号 */
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return Bus_Head(topic) - cursor < g_bus_topics[topic].depth;
+}
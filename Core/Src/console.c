@@ -0,0 +1,210 @@
+/*
+================================================================================
+console.c - USART1 调试输出实现文件
+================================================================================
+环形缓冲用三个自由递增的 32 位位置：
+  g_head    生产者预留到的位置（CAS 推进）
+  g_commit  已写完、可以发送的位置
+  g_tail    DMA 已发送完的位置
+生产者进入时 g_writers 加一，预留、拷贝后减一；减到 0 的那个生产者把减一之前
+看到的 g_head 发布为 g_commit（在它之前预留的写入者都已经退出，数据完整）。
+这个生产者在减到 0 与发布之间可能被打断，打断者完整写入并提交了更靠后的位置，
+所以 g_commit 只用 CAS 向前推，不会被旧的快照拉回去。
+单核上高优先级中断打断低优先级写入者时，中断的数据等被打断的写入者退出后
+一起提交，不需要自旋等待，也不关中断。
+
+DMA 一次发送从 g_tail 到 g_commit 的一段连续数据（遇到缓冲末尾截断），
+发送完成中断推进 g_tail 并启动下一段。g_busy 保证任意时刻只有一方
+（生产者或 DMA 中断）在设置 DMA 通道。
+*/
+#include "console.h"
+#include "config.h"
+#include "main.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if CONSOLE_DMA && OLED_TRANSPORT == OLED_TRANSPORT_HW
+#error "USART1 TX DMA and the OLED I2C2 TX DMA both use DMA1_Channel4: set CONSOLE_DMA to 0 or pick another OLED_TRANSPORT"
+#endif
+
+#if (CONSOLE_RING_SIZE & (CONSOLE_RING_SIZE - 1)) != 0
+#error "CONSOLE_RING_SIZE must be a power of two"
+#endif
+
+extern UART_HandleTypeDef huart1;
+
+/* Private variables ---------------------------------------------------------*/
+static Console_Stats_t g_console_stats;
+
+#if CONSOLE_DMA
+#define CONSOLE_MASK                (CONSOLE_RING_SIZE - 1U)
+
+static char g_ring[CONSOLE_RING_SIZE];
+static uint32_t g_head = 0;
+static uint32_t g_commit = 0;
+static uint32_t g_tail = 0;
+static uint32_t g_writers = 0;
+static uint32_t g_busy = 0;
+static uint32_t g_dma_len = 0;                  // 正在发送的字节数，只在持有 g_busy 时访问
+
+/* Private functions ---------------------------------------------------------*/
+/* 把 g_commit 推进到 head；已经在 head 或更靠后时不动 */
+static void Console_Commit(uint32_t head)
+{
+    uint32_t commit = __atomic_load_n(&g_commit, __ATOMIC_RELAXED);
+
+    while ((int32_t)(head - commit) > 0) {
+        if (__atomic_compare_exchange_n(&g_commit, &commit, head, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            return;
+        }
+    }
+}
+
+/* 没有在发送时，启动 g_tail 到 g_commit 之间的下一段 */
+static void Console_Kick(void)
+{
+    for (;;) {
+        uint32_t idle = 0;
+        uint32_t tail, commit, len;
+
+        if (!__atomic_compare_exchange_n(&g_busy, &idle, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return;                             // DMA 正在发送，完成中断会接着发
+        }
+
+        tail = g_tail;
+        commit = __atomic_load_n(&g_commit, __ATOMIC_ACQUIRE);
+        if ((int32_t)(commit - tail) > 0) {
+            len = commit - tail;
+            if (len > CONSOLE_RING_SIZE - (tail & CONSOLE_MASK)) {
+                len = CONSOLE_RING_SIZE - (tail & CONSOLE_MASK);
+            }
+            g_dma_len = len;
+            DMA1_Channel4->CCR &= ~DMA_CCR_EN;
+            DMA1_Channel4->CMAR = (uint32_t)&g_ring[tail & CONSOLE_MASK];
+            DMA1_Channel4->CNDTR = len;
+            DMA1_Channel4->CCR |= DMA_CCR_EN;
+            return;
+        }
+
+        /* 没有数据：放开 g_busy 后再看一次，防止与刚提交的生产者互相错过 */
+        __atomic_store_n(&g_busy, 0, __ATOMIC_RELEASE);
+        commit = __atomic_load_n(&g_commit, __ATOMIC_ACQUIRE);
+        if ((int32_t)(commit - tail) <= 0) {
+            return;
+        }
+    }
+}
+
+/* 写入者退出；最后一个退出的负责提交并启动发送 */
+static void Console_Release(void)
+{
+    for (;;) {
+        uint32_t head = __atomic_load_n(&g_head, __ATOMIC_ACQUIRE);
+
+        if (__atomic_sub_fetch(&g_writers, 1, __ATOMIC_ACQ_REL) != 0) {
+            return;
+        }
+        Console_Commit(head);
+        Console_Kick();
+
+        /* 快照之后有写入者预留并先于我们退出：重新进入一次，把它也提交掉 */
+        if (__atomic_load_n(&g_head, __ATOMIC_ACQUIRE) == head) {
+            return;
+        }
+        __atomic_add_fetch(&g_writers, 1, __ATOMIC_ACQ_REL);
+    }
+}
+#endif /* CONSOLE_DMA */
+
+/* Public functions ----------------------------------------------------------*/
+void Console_Init(void)
+{
+#if CONSOLE_DMA
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    /* DMA1_Channel4: 内存 -> USART1 DR，字节宽度，只开传输完成/错误中断 */
+    DMA1_Channel4->CCR = 0;
+    DMA1_Channel4->CPAR = (uint32_t)&USART1->DR;
+    DMA1_Channel4->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_TEIE;
+    USART1->CR3 |= USART_CR3_DMAT;
+
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 6, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+#endif
+}
+
+uint16_t Console_Write(const char *data, uint16_t len)
+{
+#if CONSOLE_DMA
+    uint32_t head, used;
+    uint16_t first;
+
+    if (len == 0) {
+        return 0;
+    }
+
+    __atomic_add_fetch(&g_writers, 1, __ATOMIC_ACQ_REL);
+    head = __atomic_load_n(&g_head, __ATOMIC_RELAXED);
+    do {
+        used = head - __atomic_load_n(&g_tail, __ATOMIC_ACQUIRE);
+        if (len > CONSOLE_RING_SIZE - used) {
+            __atomic_add_fetch(&g_console_stats.dropped, 1, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&g_console_stats.dropped_bytes, len, __ATOMIC_RELAXED);
+            Console_Release();
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&g_head, &head, head + len, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    first = (uint16_t)(CONSOLE_RING_SIZE - (head & CONSOLE_MASK));
+    if (first > len) {
+        first = len;
+    }
+    memcpy(&g_ring[head & CONSOLE_MASK], data, first);
+    memcpy(g_ring, data + first, len - first);
+
+    __atomic_add_fetch(&g_console_stats.bytes, len, __ATOMIC_RELAXED);
+    if (used + len > g_console_stats.max_used) {
+        g_console_stats.max_used = (uint16_t)(used + len);
+    }
+    Console_Release();
+    return len;
+#else
+    HAL_UART_Transmit(&huart1, (uint8_t *)data, len, HAL_MAX_DELAY);
+    g_console_stats.bytes += len;
+    return len;
+#endif
+}
+
+void Console_GetStats(Console_Stats_t *stats)
+{
+    *stats = g_console_stats;
+}
+
+/* newlib 的 printf 整段调用 _write（覆盖 syscalls.c 中逐字符的弱定义） */
+int _write(int file, char *ptr, int len)
+{
+    (void)file;
+    for (int left = len; left > 0; ) {
+        uint16_t n = left > CONSOLE_RING_SIZE ? CONSOLE_RING_SIZE : (uint16_t)left;
+        Console_Write(ptr, n);
+        ptr += n;
+        left -= n;
+    }
+    return len;
+}
+
+#if CONSOLE_DMA
+void Console_DMA_IRQHandler(void)
+{
+    if ((DMA1->ISR & (DMA_ISR_TCIF4 | DMA_ISR_TEIF4)) == 0) {
+        return;
+    }
+    DMA1->IFCR = DMA_IFCR_CGIF4;
+    DMA1_Channel4->CCR &= ~DMA_CCR_EN;
+
+    /* 传输错误时这一段也按已发送处理，丢掉而不是重发 */
+    __atomic_store_n(&g_tail, g_tail + g_dma_len, __ATOMIC_RELEASE);
+    __atomic_store_n(&g_busy, 0, __ATOMIC_RELEASE);
+    Console_Kick();
+}
+#endif
@@ -0,0 +1,207 @@
+/*
+================================================================================
+cpu_stats.c - 任务/中断 CPU 占用统计实现文件
+================================================================================
+每个跟踪中的任务占一个槽：句柄、上次采样时的 ulRunTimeCounter、最近
+CPU_STATS_WINDOW 次采样的千分比。槽按句柄匹配（uxTaskGetSystemState 返回的
+顺序不固定），采样时没出现的任务（已删除）释放其槽。采样方和查询方都是任务，
+更新/读取时挂起调度器而不是关中断：采样里有 64 位除法，没必要让中断等待。
+*/
+#include "cpu_stats.h"
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    TaskHandle_t handle;                        // NULL 表示空槽
+    const char  *name;
+    uint32_t     counter;                       // 上次采样的 ulRunTimeCounter
+    uint16_t     load[CPU_STATS_WINDOW];        // 每次采样间隔的占用（‰）
+} CpuStats_Slot_t;
+
+/* Private variables ---------------------------------------------------------*/
+volatile uint32_t g_cpu_isr_cycles = 0;
+volatile uint32_t g_cpu_isr_start = 0;
+volatile uint8_t  g_cpu_isr_depth = 0;
+
+static CpuStats_Slot_t g_cpu_slots[CPU_STATS_MAX_TASKS];
+static uint16_t g_cpu_isr_load[CPU_STATS_WINDOW];
+static uint32_t g_cpu_wall[CPU_STATS_WINDOW];    // 每次采样间隔的周期数
+static uint32_t g_cpu_last_cycles = 0;
+static uint32_t g_cpu_last_isr = 0;
+static uint8_t  g_cpu_head = 0;                  // 下一次采样写入的位置
+static uint8_t  g_cpu_filled = 0;
+
+/* Private functions ---------------------------------------------------------*/
+static uint16_t CpuStats_Permille(uint32_t part, uint32_t whole)
+{
+    uint32_t v;
+
+    if (whole == 0) {
+        return 0;
+    }
+    v = (uint32_t)(((uint64_t)part * 1000U) / whole);
+    return (uint16_t)(v > 1000U ? 1000U : v);
+}
+
+/* 窗口平均，调用方已挂起调度器 */
+static uint16_t CpuStats_Average(const uint16_t *load)
+{
+    uint32_t sum = 0;
+
+    if (g_cpu_filled == 0) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < g_cpu_filled; i++) {
+        sum += load[i];
+    }
+    return (uint16_t)(sum / g_cpu_filled);
+}
+
+static CpuStats_Slot_t *CpuStats_Find(TaskHandle_t task)
+{
+    for (uint8_t i = 0; i < CPU_STATS_MAX_TASKS; i++) {
+        if (g_cpu_slots[i].handle == task) {
+            return &g_cpu_slots[i];
+        }
+    }
+    return NULL;
+}
+
+/* Public functions ----------------------------------------------------------*/
+void CpuStats_InitCounter(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    g_cpu_last_cycles = DWT->CYCCNT;
+    g_cpu_last_isr = g_cpu_isr_cycles;
+}
+
+uint32_t CpuStats_Counter(void)
+{
+    return DWT->CYCCNT - g_cpu_isr_cycles;
+}
+
+void CpuStats_Sample(void)
+{
+    TaskStatus_t status[CPU_STATS_MAX_TASKS];
+    bool seen[CPU_STATS_MAX_TASKS];
+    UBaseType_t n;
+    uint32_t now, isr, wall;
+
+    /* 超过 CPU_STATS_MAX_TASKS 个任务时返回 0，本次不计 */
+    n = uxTaskGetSystemState(status, CPU_STATS_MAX_TASKS, NULL);
+    now = DWT->CYCCNT;
+    isr = g_cpu_isr_cycles;
+    if (n == 0) {
+        return;
+    }
+
+    memset(seen, 0, sizeof(seen));
+    vTaskSuspendAll();
+
+    wall = now - g_cpu_last_cycles;
+    g_cpu_wall[g_cpu_head] = wall;
+    g_cpu_isr_load[g_cpu_head] = CpuStats_Permille(isr - g_cpu_last_isr, wall);
+    g_cpu_last_cycles = now;
+    g_cpu_last_isr = isr;
+
+    for (UBaseType_t t = 0; t < n; t++) {
+        CpuStats_Slot_t *slot = CpuStats_Find(status[t].xHandle);
+
+        if (slot == NULL) {
+            /* 新任务：从这次采样开始计，之前的窗口记为 0 */
+            slot = CpuStats_Find(NULL);
+            if (slot == NULL) {
+                continue;
+            }
+            memset(slot, 0, sizeof(*slot));
+            slot->handle = status[t].xHandle;
+            slot->counter = status[t].ulRunTimeCounter;
+        }
+        slot->name = status[t].pcTaskName;
+        slot->load[g_cpu_head] = CpuStats_Permille(status[t].ulRunTimeCounter - slot->counter, wall);
+        slot->counter = status[t].ulRunTimeCounter;
+        seen[slot - g_cpu_slots] = true;
+    }
+
+    for (uint8_t i = 0; i < CPU_STATS_MAX_TASKS; i++) {
+        if (!seen[i]) {
+            g_cpu_slots[i].handle = NULL;
+        }
+    }
+
+    g_cpu_head = (uint8_t)((g_cpu_head + 1) % CPU_STATS_WINDOW);
+    if (g_cpu_filled < CPU_STATS_WINDOW) {
+        g_cpu_filled++;
+    }
+
+    (void)xTaskResumeAll();
+}
+
+bool CpuStats_GetTask(uint8_t index, CpuStats_Task_t *out)
+{
+    bool found = false;
+
+    vTaskSuspendAll();
+    for (uint8_t i = 0; i < CPU_STATS_MAX_TASKS; i++) {
+        const CpuStats_Slot_t *slot = &g_cpu_slots[i];
+
+        if (slot->handle == NULL) {
+            continue;
+        }
+        if (index-- == 0) {
+            out->name = slot->name;
+            out->handle = slot->handle;
+            out->load = CpuStats_Average(slot->load);
+            out->last = slot->load[(g_cpu_head + CPU_STATS_WINDOW - 1) % CPU_STATS_WINDOW];
+            found = true;
+            break;
+        }
+    }
+    (void)xTaskResumeAll();
+    return found;
+}
+
+uint16_t CpuStats_TaskLoad(TaskHandle_t task)
+{
+    const CpuStats_Slot_t *slot;
+    uint16_t load = 0;
+
+    if (task == NULL) {
+        return 0;
+    }
+    vTaskSuspendAll();
+    slot = CpuStats_Find(task);
+    if (slot != NULL) {
+        load = CpuStats_Average(slot->load);
+    }
+    (void)xTaskResumeAll();
+    return load;
+}
+
+void CpuStats_GetSummary(CpuStats_Summary_t *out)
+{
+    const CpuStats_Slot_t *idle;
+    uint64_t cycles = 0;
+
+    memset(out, 0, sizeof(*out));
+    vTaskSuspendAll();
+    out->samples = g_cpu_filled;
+    out->isr = CpuStats_Average(g_cpu_isr_load);
+    idle = CpuStats_Find(xTaskGetIdleTaskHandle());
+    if (idle != NULL) {
+        out->idle = CpuStats_Average(idle->load);
+    }
+    for (uint8_t i = 0; i < CPU_STATS_MAX_TASKS; i++) {
+        if (g_cpu_slots[i].handle != NULL) {
+            out->tasks++;
+        }
+    }
+    for (uint8_t i = 0; i < g_cpu_filled; i++) {
+        cycles += g_cpu_wall[i];
+    }
+    (void)xTaskResumeAll();
+
+    out->busy = (uint16_t)(out->samples ? 1000U - out->idle : 0U);
+    out->window_ms = (uint32_t)(cycles / (SystemCoreClock / 1000U));
+}
@@ -4,12 +4,18 @@
  */
 
 #include "dht11.h"
+#include "gpio_pin.hpp"
 #include <string.h>
 
+/* 数据引脚：端口和引脚都取自 dht11.h，HAL 初始化与 Pin<> 访问的是同一个引脚 */
+using DHT11_Pin = Pin<DHT11_GPIO_BASE, pin_index(DHT11_GPIO_PIN)>;
+
 // ================================ 私有变量 ================================
 static SemaphoreHandle_t xDHT11_Mutex = NULL;
-static DHT11_Data_t g_dht11_data = {0};
+static DHT11_Data_t g_dht11_data = {};
 static TaskHandle_t xDHT11_TaskHandle = NULL;
+static TickType_t xDHT11_StartTick = 0;
+static uint8_t dht11_read_pending = 0;
 
 // ================================ 私有函数声明 ================================
 static void DHT11_GPIO_Init(void);
@@ -23,12 +29,13 @@ static DHT11_Status_t DHT11_Start_Signal(void);
 static DHT11_Status_t DHT11_Wait_Response(void);
 static uint8_t DHT11_Read_Bit(void);
 static uint8_t DHT11_Read_Byte(void);
+static DHT11_Status_t DHT11_Capture(DHT11_Data_t *data);
 
 static void DHT11_Task(void *pvParameters);
 
 // ================================ 硬件抽象层实现 ================================
 static void DHT11_GPIO_Init(void) {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    GPIO_InitTypeDef GPIO_InitStruct = {};
 
             DHT11_GPIO_CLK();
 
@@ -41,33 +48,25 @@ static void DHT11_GPIO_Init(void) {
     HAL_GPIO_WritePin(DHT11_GPIO_PORT, DHT11_GPIO_PIN, GPIO_PIN_SET);
 }
 
-static void DHT11_Set_Output(void) {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-    GPIO_InitStruct.Pin = DHT11_GPIO_PIN;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStruct.Pull = GPIO_PULLUP;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-    HAL_GPIO_Init(DHT11_GPIO_PORT, &GPIO_InitStruct);
+// 方向切换只改写 CRL 中本引脚的配置位，采样循环中的读写均内联为单条访存
+static inline void DHT11_Set_Output(void) {
+    DHT11_Pin::output_pp();
 }
 
-static void DHT11_Set_Input(void) {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-    GPIO_InitStruct.Pin = DHT11_GPIO_PIN;
-    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
-    GPIO_InitStruct.Pull = GPIO_PULLUP;
-    HAL_GPIO_Init(DHT11_GPIO_PORT, &GPIO_InitStruct);
+static inline void DHT11_Set_Input(void) {
+    DHT11_Pin::input_pullup();
 }
 
-static void DHT11_Pin_High(void) {
-    HAL_GPIO_WritePin(DHT11_GPIO_PORT, DHT11_GPIO_PIN, GPIO_PIN_SET);
+static inline void DHT11_Pin_High(void) {
+    DHT11_Pin::high();
 }
 
-static void DHT11_Pin_Low(void) {
-    HAL_GPIO_WritePin(DHT11_GPIO_PORT, DHT11_GPIO_PIN, GPIO_PIN_RESET);
+static inline void DHT11_Pin_Low(void) {
+    DHT11_Pin::low();
 }
 
-static uint8_t DHT11_Pin_Read(void) {
-    return HAL_GPIO_ReadPin(DHT11_GPIO_PORT, DHT11_GPIO_PIN);
+static inline uint8_t DHT11_Pin_Read(void) {
+    return DHT11_Pin::read();
 }
 
 // 微秒级精确延时
@@ -89,18 +88,8 @@ static void DHT11_Delay_us(uint32_t us) {
 
 // ================================ DHT11通信协议实现 ================================
 static DHT11_Status_t DHT11_Start_Signal(void) {
-    DHT11_Set_Output();
-    DHT11_Pin_High();
-    DHT11_Delay_us(10);
-
-    // 主机发送起始信号：拉低至少18ms
-    DHT11_Pin_Low();
-    vTaskDelay(pdMS_TO_TICKS(20));
-
-    // 主机拉高20-40us，然后释放总线
-    DHT11_Pin_High();
-    DHT11_Delay_us(30);
-    DHT11_Set_Input();
+    DHT11_Start_Read();
+    vTaskDelay(pdMS_TO_TICKS(DHT11_START_LOW_MS));
 
     return DHT11_OK;
 }
@@ -165,23 +154,21 @@ static uint8_t DHT11_Read_Byte(void) {
     uint8_t byte_data = 0;
 
     for (int i = 7; i >= 0; i--) {
-        byte_data |= (DHT11_Read_Bit() << i);
+        byte_data |= (uint8_t)(DHT11_Read_Bit() << i);
     }
 
     return byte_data;
 }
 
 // ================================ 主要接口函数实现 ================================
- DHT11_Status_t DHT11_Read_Raw_Data(DHT11_Data_t *data) {
-    if (data == NULL) return DHT11_ERROR_TIMEOUT;
-
+// 起始信号结束后读取应答和40位数据，整个过程约4ms，必须连续执行
+static DHT11_Status_t DHT11_Capture(DHT11_Data_t *data) {
     uint8_t raw_data[5] = {0};
 
-    //vPortEnterCritical();
-    // 发送起始信号
-    if (DHT11_Start_Signal() != DHT11_OK) {
-        return DHT11_ERROR_TIMEOUT;
-    }
+    // 主机拉高20-40us，然后释放总线
+    DHT11_Pin_High();
+    DHT11_Delay_us(30);
+    DHT11_Set_Input();
 
     // 等待DHT11响应
     if (DHT11_Wait_Response() != DHT11_OK) {
@@ -192,7 +179,7 @@ static uint8_t DHT11_Read_Byte(void) {
     for (int i = 0; i < 5; i++) {
         raw_data[i] = DHT11_Read_Byte();
     }
-    //vPortExitCritical();
+
     // 校验和检查
     uint8_t checksum = raw_data[0] + raw_data[1] + raw_data[2] + raw_data[3];
     if (checksum != raw_data[4]) {
@@ -215,6 +202,42 @@ static uint8_t DHT11_Read_Byte(void) {
     return DHT11_OK;
 }
 
+DHT11_Status_t DHT11_Start_Read(void) {
+    DHT11_Set_Output();
+    DHT11_Pin_High();
+    DHT11_Delay_us(10);
+
+    // 主机发送起始信号：拉低至少18ms，期间不占用CPU
+    DHT11_Pin_Low();
+    xDHT11_StartTick = xTaskGetTickCount();
+    dht11_read_pending = 1;
+
+    return DHT11_OK;
+}
+
+DHT11_Status_t DHT11_Poll_Data(DHT11_Data_t *data) {
+    if (data == NULL || !dht11_read_pending) return DHT11_ERROR_TIMEOUT;
+
+    if ((xTaskGetTickCount() - xDHT11_StartTick) < pdMS_TO_TICKS(DHT11_START_LOW_MS)) {
+        return DHT11_ERROR_BUSY;
+    }
+
+    dht11_read_pending = 0;
+    return DHT11_Capture(data);
+}
+
+DHT11_Status_t DHT11_Read_Raw_Data(DHT11_Data_t *data) {
+    if (data == NULL) return DHT11_ERROR_TIMEOUT;
+
+    // 发送起始信号
+    if (DHT11_Start_Signal() != DHT11_OK) {
+        return DHT11_ERROR_TIMEOUT;
+    }
+
+    dht11_read_pending = 0;
+    return DHT11_Capture(data);
+}
+
 // ================================ FreeRTOS任务实现 ================================
 static void DHT11_Task(void *pvParameters) {
     DHT11_Data_t temp_data;
@@ -326,4 +349,44 @@ uint8_t DHT11_Is_Data_Valid(void) {
     }
 
     return valid;
-}
\ No newline at end of file
+}
+
+// ================================ 传感器框架适配 ================================
+static Sensor_Status_t DHT11_Sensor_Init(void *ctx) {
+    (void)ctx;
+    return DHT11_Init() == DHT11_OK ? SENSOR_OK : SENSOR_ERROR;
+}
+
+static Sensor_Status_t DHT11_Sensor_Start(void *ctx) {
+    (void)ctx;
+    return DHT11_Start_Read() == DHT11_OK ? SENSOR_OK : SENSOR_ERROR;
+}
+
+static Sensor_Status_t DHT11_Sensor_Poll(void *ctx) {
+    switch (DHT11_Poll_Data((DHT11_Data_t *)ctx)) {
+        case DHT11_OK:             return SENSOR_OK;
+        case DHT11_ERROR_BUSY:     return SENSOR_BUSY;
+        case DHT11_ERROR_CHECKSUM: return SENSOR_ERROR_CHECKSUM;
+        default:                   return SENSOR_ERROR_TIMEOUT;
+    }
+}
+
+// 输出: value[0] 温度(0.1°C), value[1] 湿度(0.1%RH)
+static Sensor_Status_t DHT11_Sensor_Decode(void *ctx, Sensor_Reading_t *out) {
+    const DHT11_Data_t *data = (const DHT11_Data_t *)ctx;
+
+    out->timestamp = data->timestamp;
+    out->count = 2;
+    out->value[0] = (int32_t)data->temperature_int * 10 + data->temperature_dec;
+    out->value[1] = (int32_t)data->humidity_int * 10 + data->humidity_dec;
+
+    return SENSOR_OK;
+}
+
+// C++17 不支持指定初始化器，按 init/start_read/poll_complete/decode 顺序填写
+const Sensor_Driver_t DHT11_SensorDriver = {
+    DHT11_Sensor_Init,
+    DHT11_Sensor_Start,
+    DHT11_Sensor_Poll,
+    DHT11_Sensor_Decode,
+};
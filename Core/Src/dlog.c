@@ -0,0 +1,61 @@
+/*
+================================================================================
+dlog.c - 延迟格式化的二进制日志：记录编码
+================================================================================
+一条记录先在调用方栈上编码好，再一次性交给 Console_Write，不会和其他任务或
+中断的输出穿插；控制台缓冲满时整条丢弃，计入控制台的丢弃计数。
+*/
+#include "dlog.h"
+#include "console.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+
+/* Private functions ---------------------------------------------------------*/
+static uint8_t *DLog_Put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/* Public functions ----------------------------------------------------------*/
+void DLog_Write(uint16_t id, const DLog_Arg_t *args, uint8_t nargs)
+{
+    uint8_t rec[DLOG_RECORD_MAX];
+    uint8_t *p = rec;
+    uint8_t mask = 0;
+
+    if (nargs > DLOG_MAX_ARGS) {
+        nargs = DLOG_MAX_ARGS;
+    }
+
+    *p++ = DLOG_SYNC;
+    *p++ = (uint8_t)id;
+    *p++ = (uint8_t)(id >> 8);
+    /* 32 位 tick 的读取是原子的，中断里直接读也没问题 */
+    p = DLog_Put32(p, (uint32_t)xTaskGetTickCount());
+    *p++ = nargs;
+    *p++ = 0;                                   // 位图，下面填
+
+    for (uint8_t i = 0; i < nargs; i++) {
+        if (args[i].is_str) {
+            const char *s = (const char *)(uintptr_t)args[i].value;
+            uint8_t *len = p++;
+
+            *len = 0;
+            while (s != NULL && s[*len] != '\0' && *len < DLOG_STR_MAX) {
+                *p++ = (uint8_t)s[*len];
+                (*len)++;
+            }
+            mask |= (uint8_t)(1U << i);
+        } else {
+            p = DLog_Put32(p, args[i].value);
+        }
+    }
+    rec[8] = mask;
+
+    Console_Write((const char *)rec, (uint16_t)(p - rec));
+}
@@ -6,10 +6,12 @@ esp8266.c - ESP8266驱动实现文件
 #include "esp8266.h"
 #include "uart.h"
 #include "app_task.h"
+#include "trace_recorder.h"
 
 /* Private variables ---------------------------------------------------------*/
 volatile uint8_t esp8266_ready = 0;
 volatile uint8_t wifi_connected = 0;
+static uint32_t esp8266_send_ticks = 0;     // 上一次 SendData：CIPSEND 到发送完成，不含之后的固定等待
 
 /* Private function prototypes -----------------------------------------------*/
 static ESP8266_StatusTypeDef ESP8266_WaitResponse(const char* expected, uint32_t timeout);
@@ -55,15 +57,26 @@ ESP8266_StatusTypeDef ESP8266_Init(void)
   */
 ESP8266_StatusTypeDef ESP8266_SendCommand(const char* cmd, const char* expected_response, uint32_t timeout)
 {
+    ESP8266_StatusTypeDef status = ESP8266_TIMEOUT;
+    uint32_t start = osKernelGetTickCount();
+
+    Trace_MarkStart(TRACE_MARK_esp_cmd, 0, cmd);
+
     // Send command
     UART2_SendString(cmd);
     UART2_SendString("\r\n");
 
     // Wait for response
     if(UART2_WaitForResponse(expected_response, timeout) == HAL_OK)
-        return ESP8266_OK;
+        status = ESP8266_OK;
+
+    Trace_MarkStop(TRACE_MARK_esp_cmd, status);
+
+    // Keep the events leading up to a slow command for the trace dump
+    if(osKernelGetTickCount() - start > TRACE_SLOW_CMD_MS)
+        Trace_Trigger();
 
-    return ESP8266_TIMEOUT;
+    return status;
 }
 
 /**
@@ -142,6 +155,7 @@ ESP8266_StatusTypeDef ESP8266_ConnectTCP(const char* host, const char* port)
 ESP8266_StatusTypeDef ESP8266_SendData(const uint8_t* data, uint16_t length)
 {
     char cmd_buffer[32];
+    uint32_t start = osKernelGetTickCount();
 
     snprintf(cmd_buffer, sizeof(cmd_buffer), "AT+CIPSEND=0,%d", length);
 
@@ -149,8 +163,11 @@ ESP8266_StatusTypeDef ESP8266_SendData(const uint8_t* data, uint16_t length)
     {
         if(osMutexAcquire(uart2MutexHandle, osWaitForever) == osOK)
         {
+            Trace_MarkStart(TRACE_MARK_esp_send, length, NULL);
             HAL_UART_Transmit(&huart2, data, length, HAL_MAX_DELAY);
+            Trace_MarkStop(TRACE_MARK_esp_send, length);
             osMutexRelease(uart2MutexHandle);
+            esp8266_send_ticks = osKernelGetTickCount() - start;
             osDelay(1000);
             return ESP8266_OK;
         }
@@ -159,6 +176,16 @@ ESP8266_StatusTypeDef ESP8266_SendData(const uint8_t* data, uint16_t length)
     return ESP8266_ERROR;
 }
 
+/**
+  * @brief  Duration of the last successful ESP8266_SendData
+  * @retval Kernel ticks from AT+CIPSEND to the end of the UART transmit,
+  *         excluding the fixed settle delay that follows
+  */
+uint32_t ESP8266_GetSendTime(void)
+{
+    return esp8266_send_ticks;
+}
+
 /**
   * @brief  Check ESP8266 connection status
   * @retval ESP8266_StatusTypeDef
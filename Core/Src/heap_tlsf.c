@@ -0,0 +1,148 @@
+/*
+================================================================================
+heap_tlsf.c - FreeRTOS 堆的 TLSF 实现（替代 heap_4.c）
+================================================================================
+接口与 heap_4 相同：pvPortMalloc / vPortFree / xPortGetFreeHeapSize /
+xPortGetMinimumEverFreeHeapSize / vPortGetHeapStats，堆同样是
+configTOTAL_HEAP_SIZE 字节的静态数组。heap_4 分配时沿空闲链表找第一个够大的
+块，耗时随碎片增多而变长；这里分配和释放都是常数时间（tlsf.h），挂起调度器
+的时间也就固定了。选哪个实现由 CMake 的 FREERTOS_HEAP_TLSF 选项决定，
+两个文件只会编译一个。
+
+traceMALLOC / traceFREE 的参数与 heap_4 一致（块长含 8 字节块头），
+TRACE_RECORDER 打开时记录的分配序列可以交给 tools/heap_bench 回放。
+*/
+#include <stdlib.h>
+
+/* 与 heap_4.c 相同：阻止 task.h 把 API 换成 MPU 包装 */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "tlsf.h"
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+_Static_assert(portBYTE_ALIGNMENT <= TLSF_ALIGN, "TLSF heap: portBYTE_ALIGNMENT above TLSF_ALIGN");
+_Static_assert(configTOTAL_HEAP_SIZE <= TLSF_MAX_POOL, "TLSF heap: configTOTAL_HEAP_SIZE above TLSF_MAX_POOL");
+
+/* Private macros ------------------------------------------------------------*/
+/* heap_4 传给 traceMALLOC 的长度：请求 + 块头，按对齐上取整 */
+#define HEAP_TRACE_SIZE(size)       (((size) + TLSF_HEADER_SIZE + TLSF_ALIGN - 1U) & ~(size_t)(TLSF_ALIGN - 1U))
+
+/* Private variables ---------------------------------------------------------*/
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+extern uint8_t ucHeap[configTOTAL_HEAP_SIZE];
+#else
+static uint8_t ucHeap[configTOTAL_HEAP_SIZE] __attribute__((aligned(TLSF_ALIGN)));
+#endif
+
+static Tlsf_t g_heap;
+static bool g_heap_ready = false;
+static size_t g_heap_min_free = 0;
+static size_t g_heap_allocs = 0;
+static size_t g_heap_frees = 0;
+
+/* Private functions ---------------------------------------------------------*/
+/* 调用方已挂起调度器 */
+static void Heap_Init(void)
+{
+    bool ok = Tlsf_Init(&g_heap, ucHeap, configTOTAL_HEAP_SIZE);
+
+    configASSERT(ok);
+    (void)ok;
+    g_heap_min_free = g_heap.free_bytes;
+    g_heap_ready = true;
+}
+
+/* Public functions ----------------------------------------------------------*/
+void *pvPortMalloc(size_t xWantedSize)
+{
+    void *pvReturn;
+
+    vTaskSuspendAll();
+    {
+        if (!g_heap_ready) {
+            Heap_Init();
+        }
+        pvReturn = Tlsf_Alloc(&g_heap, xWantedSize);
+        if (pvReturn != NULL) {
+            g_heap_allocs++;
+            if (g_heap.free_bytes < g_heap_min_free) {
+                g_heap_min_free = g_heap.free_bytes;
+            }
+        }
+        traceMALLOC(pvReturn, HEAP_TRACE_SIZE(xWantedSize));
+    }
+    (void)xTaskResumeAll();
+
+#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+    if (pvReturn == NULL) {
+        extern void vApplicationMallocFailedHook(void);
+        vApplicationMallocFailedHook();
+    }
+#endif
+
+    configASSERT((((size_t)pvReturn) & (size_t)portBYTE_ALIGNMENT_MASK) == 0);
+    return pvReturn;
+}
+
+void vPortFree(void *pv)
+{
+    bool ok;
+
+    if (pv == NULL) {
+        return;
+    }
+    vTaskSuspendAll();
+    {
+        traceFREE(pv, Tlsf_BlockSize(&g_heap, pv));
+        ok = Tlsf_Free(&g_heap, pv);
+        if (ok) {
+            g_heap_frees++;
+        }
+    }
+    (void)xTaskResumeAll();
+    configASSERT(ok);               // 重复释放或不是堆里的指针
+    (void)ok;
+}
+
+size_t xPortGetFreeHeapSize(void)
+{
+    return g_heap.free_bytes;
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+    return g_heap_min_free;
+}
+
+void vPortInitialiseBlocks(void)
+{
+    /* 与 heap_4 一样什么也不做，堆在第一次分配时初始化 */
+}
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats)
+{
+    Tlsf_Stats_t stats = { 0 };
+
+    vTaskSuspendAll();
+    {
+        if (g_heap_ready) {
+            Tlsf_GetStats(&g_heap, &stats);
+        }
+        pxHeapStats->xAvailableHeapSpaceInBytes = stats.free_bytes;
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = stats.largest_free;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = stats.smallest_free;
+        pxHeapStats->xNumberOfFreeBlocks = stats.free_blocks;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = g_heap_min_free;
+        pxHeapStats->xNumberOfSuccessfulAllocations = g_heap_allocs;
+        pxHeapStats->xNumberOfSuccessfulFrees = g_heap_frees;
+    }
+    (void)xTaskResumeAll();
+}
@@ -9,8 +9,8 @@ main.c - 主程序文件
 #include "task_monitor.h"
 #include "dht11.h"
 #include "tim1_us.h"
-
-#include "SEGGER_SYSVIEW.h"
+#include "console.h"
+#include "trace_recorder.h"
 
 /* Private variables ---------------------------------------------------------*/
 UART_HandleTypeDef huart1;
@@ -51,8 +51,9 @@ int main(void)
     /* Initialize UART handler */
     MX_DMA_Init();
     MX_USART1_UART_Init();
+    Console_Init();
     MX_USART2_UART_Init();
-    SEGGER_SYSVIEW_Conf();
+    Trace_Init();
     /* Init scheduler */
     osKernelInitialize();
 
@@ -222,9 +223,8 @@ static void MX_USART2_UART_Init(void)
   */
 PUTCHAR_PROTOTYPE
 {
-    /*Place your implementation of fputc here
-    e.g. write a character to the USART1 and Loop until the end of transmission */
-    HAL_UART_Transmit(&huart1, (uint8_t *)&ch, 1, 0xFFFF);
+    char c = (char)ch;
+    Console_Write(&c, 1);
 
     return ch;
 }
@@ -0,0 +1,87 @@
+/*
+================================================================================
+metrics.c - 设备指标存储与二进制编码
+================================================================================
+编码时逐个读取指标，不加锁：各指标本身是原子更新的，一包里的不同指标之间
+相差几微秒对周期上报没有影响。
+*/
+#include "metrics.h"
+
+/* Private macros ------------------------------------------------------------*/
+#define METRICS_BOUNDS_ROW(obj, ...)        { __VA_ARGS__ },
+
+/* Private variables ---------------------------------------------------------*/
+uint32_t g_metric_counters[METRIC_COUNTER_COUNT];
+int32_t  g_metric_gauges[METRIC_GAUGE_COUNT];
+uint32_t g_metric_hist[METRIC_HIST_COUNT][METRICS_HIST_BOUNDS + 1];
+
+const uint32_t g_metric_hist_bounds[METRIC_HIST_COUNT][METRICS_HIST_BOUNDS] = {
+    METRICS_HIST_TABLE(METRICS_BOUNDS_ROW)
+};
+
+static const char g_metrics_schema_text[] = METRICS_SCHEMA_TEXT;
+static uint16_t g_metrics_schema = 0;
+static uint32_t g_metrics_seq = 0;
+
+/* Private functions ---------------------------------------------------------*/
+/* 无符号 LEB128，空间不足返回 NULL */
+static uint8_t *Metrics_PutVar(uint8_t *p, const uint8_t *end, uint32_t v)
+{
+    do {
+        if (p == end) {
+            return NULL;
+        }
+        *p = (uint8_t)(v & 0x7F);
+        v >>= 7;
+        if (v != 0) {
+            *p |= 0x80;
+        }
+        p++;
+    } while (v != 0);
+    return p;
+}
+
+/* Public functions ----------------------------------------------------------*/
+uint16_t Metrics_Schema(void)
+{
+    uint32_t h = 2166136261UL;
+
+    if (g_metrics_schema != 0) {
+        return g_metrics_schema;
+    }
+    for (const char *s = g_metrics_schema_text; *s; s++) {
+        h = (h ^ (uint8_t)*s) * 16777619UL;
+    }
+    g_metrics_schema = (uint16_t)((h >> 16) ^ h);
+    return g_metrics_schema;
+}
+
+int Metrics_Serialize(uint8_t *buf, size_t size)
+{
+    const uint8_t *end = buf + size;
+    uint16_t schema = Metrics_Schema();
+    uint8_t *p = buf;
+
+    if (size < 3) {
+        return -1;
+    }
+    *p++ = METRICS_WIRE_VERSION;
+    *p++ = (uint8_t)(schema & 0xFF);
+    *p++ = (uint8_t)(schema >> 8);
+
+    p = Metrics_PutVar(p, end, g_metrics_seq++);
+    for (int i = 0; p != NULL && i < METRIC_COUNTER_COUNT; i++) {
+        p = Metrics_PutVar(p, end, Metric_Counter((Metric_Counter_t)i));
+    }
+    for (int i = 0; p != NULL && i < METRIC_GAUGE_COUNT; i++) {
+        int32_t v = Metric_Gauge((Metric_Gauge_t)i);
+        p = Metrics_PutVar(p, end, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+    }
+    for (int i = 0; p != NULL && i < METRIC_HIST_COUNT; i++) {
+        for (int b = 0; p != NULL && b <= METRICS_HIST_BOUNDS; b++) {
+            p = Metrics_PutVar(p, end, __atomic_load_n(&g_metric_hist[i][b], __ATOMIC_RELAXED));
+        }
+    }
+
+    return p != NULL ? (int)(p - buf) : -1;
+}
@@ -6,6 +6,9 @@ mqtt_client.c - MQTT客户端实现文件
 #include "mqtt.h"
 #include "app_task.h"
 #include "config.h"
+#include "metrics.h"
+#include "trace_recorder.h"
+#include "msg_buf.h"
 
 /* Private variables ---------------------------------------------------------*/
 volatile uint8_t mqtt_connected = 0;
@@ -102,17 +105,39 @@ MQTT_StatusTypeDef MQTT_Disconnect(void)
   * @retval MQTT_StatusTypeDef
   */
 MQTT_StatusTypeDef MQTT_Publish(const char* topic, const char* payload)
+{
+    return MQTT_PublishRaw(topic, (const uint8_t*)payload, strlen(payload));
+}
+
+/**
+  * @brief  Publish a binary payload (may contain zero bytes) to MQTT topic
+  * @param  topic: Topic name
+  * @param  payload: Payload bytes
+  * @param  payload_len: Payload length
+  * @retval MQTT_StatusTypeDef
+  */
+MQTT_StatusTypeDef MQTT_PublishRaw(const char* topic, const uint8_t* payload, uint16_t payload_len)
 {
     if(!mqtt_connected) return MQTT_NOT_CONNECTED;
 
     uint8_t publish_packet[256];
     uint16_t packet_len = 0;
     uint16_t topic_len = strlen(topic);
-    uint16_t payload_len = strlen(payload);
+    uint16_t remaining_len = 2 + topic_len + payload_len;
+
+    if(remaining_len + 3 > sizeof(publish_packet)) return MQTT_ERROR;
+
+    Trace_MarkStart(TRACE_MARK_mqtt_publish, payload_len, topic);
 
     // Fixed header
     publish_packet[packet_len++] = 0x30; // PUBLISH message type
-    publish_packet[packet_len++] = 2 + topic_len + payload_len; // Remaining length
+    do // Remaining length (variable length encoding, 7 bits per byte)
+    {
+        uint8_t encoded = remaining_len & 0x7F;
+        remaining_len >>= 7;
+        if(remaining_len > 0) encoded |= 0x80;
+        publish_packet[packet_len++] = encoded;
+    } while(remaining_len > 0);
 
     // Variable header - Topic name
     publish_packet[packet_len++] = (topic_len >> 8) & 0xFF;
@@ -125,8 +150,16 @@ MQTT_StatusTypeDef MQTT_Publish(const char* topic, const char* payload)
     packet_len += payload_len;
 
     if(ESP8266_SendData(publish_packet, packet_len) == ESP8266_OK)
+    {
+        Trace_MarkStop(TRACE_MARK_mqtt_publish, 1);
+        Metric_Inc(METRIC_COUNTER_mqtt_publish_ok);
+        /* 只计 CIPSEND 提示符等待 + 发送；SendData 之后固定的 1 s 等待不计入 */
+        Metric_Observe(METRIC_HIST_mqtt_publish_ms, ESP8266_GetSendTime());
         return MQTT_OK;
+    }
 
+    Trace_MarkStop(TRACE_MARK_mqtt_publish, 0);
+    Metric_Inc(METRIC_COUNTER_mqtt_publish_fail);
     return MQTT_ERROR;
 }
 
@@ -213,10 +246,13 @@ void MQTT_ProcessMessage(const char* data, uint16_t length)
     if(strstr(data, "+IPD") != NULL)
     {
         // Parse received MQTT message
-        MQTT_Message_t mqtt_msg;
-        strcpy(mqtt_msg.topic, MQTT_TOPIC_SUB);
-        strcpy(mqtt_msg.payload, "received_command");
-        osMessageQueuePut(mqttQueueHandle, &mqtt_msg, 0, 0);
+        MsgBuf_t *msg = MsgBuf_Alloc();
+        if(msg != NULL)
+        {
+            strcpy(msg->data, "received_command");
+            msg->length = (uint16_t)strlen(msg->data);
+            MsgBuf_Send(mqttQueueHandle, msg, 0);
+        }
     }
 }
 
@@ -0,0 +1,59 @@
+/*
+================================================================================
+msg_buf.c - 固定块消息缓冲实现文件
+================================================================================
+引用计数用原子操作，中断里的生产者和任务里的消费者可以同时持有同一块。
+*/
+#include "msg_buf.h"
+#include "metrics.h"
+
+/* Exported variables --------------------------------------------------------*/
+osMemoryPoolId_t msgPoolHandle;
+
+/* Public functions ----------------------------------------------------------*/
+MsgBuf_t *MsgBuf_Alloc(void)
+{
+    MsgBuf_t *buf = (MsgBuf_t *)osMemoryPoolAlloc(msgPoolHandle, 0);
+
+    if (buf == NULL) {
+        Metric_Inc(METRIC_COUNTER_msg_pool_empty);
+        return NULL;
+    }
+    buf->length = 0;
+    buf->offset = 0;
+    buf->refs = 1;
+    buf->data[0] = '\0';
+    return buf;
+}
+
+MsgBuf_t *MsgBuf_Ref(MsgBuf_t *buf)
+{
+    __atomic_add_fetch(&buf->refs, 1, __ATOMIC_RELAXED);
+    return buf;
+}
+
+void MsgBuf_Release(MsgBuf_t *buf)
+{
+    if (buf != NULL && __atomic_sub_fetch(&buf->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        osMemoryPoolFree(msgPoolHandle, buf);
+    }
+}
+
+bool MsgBuf_Send(osMessageQueueId_t queue, MsgBuf_t *buf, uint32_t timeout)
+{
+    if (osMessageQueuePut(queue, &buf, 0, timeout) == osOK) {
+        return true;
+    }
+    MsgBuf_Release(buf);
+    return false;
+}
+
+MsgBuf_t *MsgBuf_Receive(osMessageQueueId_t queue, uint32_t timeout)
+{
+    MsgBuf_t *buf;
+
+    if (osMessageQueueGet(queue, &buf, NULL, timeout) != osOK) {
+        return NULL;
+    }
+    return buf;
+}
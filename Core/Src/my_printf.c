@@ -1,24 +1,42 @@
 #include "stm32f1xx_hal.h"  // 或你的芯片头文件
+#include "console.h"
+#include "my_printf.h"
 
-extern UART_HandleTypeDef huart1;  // 串口句柄
+#define MY_PRINTF_CHUNK     64  // 攒够一块再写入控制台缓冲，一行通常一次写完
 
-void uart_send_char(char c) {
-    HAL_UART_Transmit(&huart1, (uint8_t *)&c, 1, HAL_MAX_DELAY);
+/* 每次调用各自的输出缓冲（在调用方栈上），多个任务同时打印也互不穿插 */
+typedef struct {
+    char     buf[MY_PRINTF_CHUNK];
+    uint16_t len;
+} printf_out_t;
+
+static void uart_flush(printf_out_t *out) {
+    if (out->len) {
+        Console_Write(out->buf, out->len);
+        out->len = 0;
+    }
+}
+
+static void uart_send_char(printf_out_t *out, char c) {
+    out->buf[out->len++] = c;
+    if (out->len == sizeof(out->buf)) {
+        uart_flush(out);
+    }
 }
 
-void uart_send_str(const char *s) {
+static void uart_send_str(printf_out_t *out, const char *s) {
     while (*s) {
-        uart_send_char(*s++);
+        uart_send_char(out, *s++);
     }
 }
 
-void uart_send_hex(unsigned int num) {
+static void uart_send_hex(printf_out_t *out, unsigned int num) {
     char hex_chars[] = "0123456789abcdef";
     char buffer[8];
     int i = 0;
 
     if (num == 0) {
-        uart_send_char('0');
+        uart_send_char(out, '0');
         return;
     }
 
@@ -28,24 +46,16 @@ void uart_send_hex(unsigned int num) {
     }
 
     while (i--) {
-        uart_send_char(buffer[i]);
+        uart_send_char(out, buffer[i]);
     }
 }
 
-void uart_send_dec(int num) {
+static void uart_send_udec(printf_out_t *out, unsigned int n) {
     char buffer[10];
     int i = 0;
-    unsigned int n;
-
-    if (num < 0) {
-        uart_send_char('-');
-        n = -num;
-    } else {
-        n = num;
-    }
 
     if (n == 0) {
-        uart_send_char('0');
+        uart_send_char(out, '0');
         return;
     }
 
@@ -55,57 +65,73 @@ void uart_send_dec(int num) {
     }
 
     while (i--) {
-        uart_send_char(buffer[i]);
+        uart_send_char(out, buffer[i]);
     }
 }
 
-
-
+static void uart_send_dec(printf_out_t *out, int num) {
+    if (num < 0) {
+        uart_send_char(out, '-');
+        uart_send_udec(out, 0U - (unsigned int)num);
+    } else {
+        uart_send_udec(out, (unsigned int)num);
+    }
+}
 
 void my_printf(const char *fmt, ...) {
-    char *arg_ptr = (char *)(&fmt);
-    arg_ptr += sizeof(fmt);  // 指向第一个变参
+    printf_out_t out;
+    va_list ap;
+
+    out.len = 0;
+    va_start(ap, fmt);  // 不能按地址推算变参：寄存器传参且优化后参数不一定在栈上
 
     while (*fmt) {
         if (*fmt == '%') {
             fmt++;
+            while (*fmt == 'l' || *fmt == 'h') {
+                fmt++;  // 长度修饰：int 与 long 在 Cortex-M3 上同为 32 位
+            }
             switch (*fmt) {
-                case 'd': {
-                    int val = *((int *)arg_ptr);
-                    arg_ptr += sizeof(int);
-                    uart_send_dec(val);
+                case 'd':
+                case 'i': {
+                    uart_send_dec(&out, va_arg(ap, int));
+                    break;
+                }
+                case 'u': {
+                    uart_send_udec(&out, va_arg(ap, unsigned int));
                     break;
                 }
                 case 'x': {
-                    int val = *((int *)arg_ptr);
-                    arg_ptr += sizeof(int);
-                    uart_send_hex(val);
+                    uart_send_hex(&out, va_arg(ap, unsigned int));
                     break;
                 }
                 case 'c': {
-                    char ch = *((char *)arg_ptr);
-                    arg_ptr += sizeof(int);  // 注意：char 也按 int 对齐
-                    uart_send_char(ch);
+                    uart_send_char(&out, (char)va_arg(ap, int));  // char 按 int 提升传递
                     break;
                 }
                 case 's': {
-                    char *str = *((char **)arg_ptr);
-                    arg_ptr += sizeof(char *);
-                    uart_send_str(str);
+                    const char *str = va_arg(ap, const char *);
+                    uart_send_str(&out, str != NULL ? str : "(null)");
                     break;
                 }
                 case '%': {
-                    uart_send_char('%');
+                    uart_send_char(&out, '%');
+                    break;
+                }
+                case '\0': {
+                    fmt--;  // 结尾的单个 '%'
                     break;
                 }
                 default: {
-                    uart_send_char('?');
+                    uart_send_char(&out, '?');
                     break;
                 }
             }
         } else {
-            uart_send_char(*fmt);
+            uart_send_char(&out, *fmt);
         }
         fmt++;
     }
+    va_end(ap);
+    uart_flush(&out);
 }
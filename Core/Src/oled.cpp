@@ -0,0 +1,728 @@
+//////////////////////////////////////////////////////////////////////////////////
+//±¾³ÌÐòÖ»¹©Ñ§Ï°Ê¹ÓÃ£¬Î´¾­×÷ÕßÐí¿É£¬²»µÃÓÃÓÚÆäËüÈÎºÎÓÃÍ¾
+//ÖÐ¾°Ô°µç×Ó
+//µêÆÌµØÖ·£ºhttp://shop73023976.taobao.com/?spm=2013.1.0.0.M4PqC2
+//
+//  ÎÄ ¼þ Ãû   : main.c
+//  °æ ±¾ ºÅ   : v2.0
+//  ×÷    Õß   : Evk123
+//  Éú³ÉÈÕÆÚ   : 2014-0101
+//  ×î½üÐÞ¸Ä   :
+//  ¹¦ÄÜÃèÊö   : 0.69´çOLED ½Ó¿ÚÑÝÊ¾Àý³Ì(STM32F103ZEÏµÁÐIIC)
+//              ËµÃ÷:
+//              ----------------------------------------------------------------
+//              GND   µçÔ´µØ
+//              VCC   ½Ó5V»ò3.3vµçÔ´
+//              SCL   ½ÓPD6£¨SCL£©
+//              SDA   ½ÓPD7£¨SDA£©
+//              ----------------------------------------------------------------
+//Copyright(C) ÖÐ¾°Ô°µç×Ó2014/3/16
+//All rights reserved
+//////////////////////////////////////////////////////////////////////////////////£
+
+
+#include "stdlib.h"
+#include "oled_font.h"
+#include "oled.h"
+#include "soft_i2c.h"
+#include "config.h"
+#if OLED_TRANSPORT == OLED_TRANSPORT_HW
+#include "oled_i2c_dma.h"
+#elif OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+#include "soft_i2c_isr.h"
+#include "cmsis_os2.h"
+#include "rtos_objects.h"
+#endif
+#include "gpio_pin.hpp"
+#include <string.h>
+
+/* 旧版逐位 IIC 函数（IIC_Start 等）使用的引脚，直接写 BSRR/BRR */
+using OLED_SCL = Pin<I2C_SCL_GPIO_BASE, pin_index(I2C_SCL_Pin)>;
+using OLED_SDA = Pin<I2C_SDA_GPIO_BASE, pin_index(I2C_SDA_Pin)>;
+#define OLED_SCLK_Clr()     OLED_SCL::low()
+#define OLED_SCLK_Set()     OLED_SCL::high()
+#define OLED_SDIN_Clr()     OLED_SDA::low()
+#define OLED_SDIN_Set()     OLED_SDA::high()
+
+static uint8_t g_oled_i2c_addr = 0x78;
+
+/* 显存：OLED_FB(page, x)，每字节为一列中的 8 个像素，LSB 在上。
+   每页前放一个 0x40 控制字节，整页可直接作为一个 I2C 数据事务交给 DMA */
+static uint8_t g_oled_fb[OLED_PAGES][1 + X_WIDTH];
+#define OLED_FB(page, x)    g_oled_fb[page][1 + (x)]
+/* 每页的脏列区间 [lo, hi]，lo > hi 表示该页与屏幕一致 */
+static uint8_t g_oled_dirty_lo[OLED_PAGES];
+static uint8_t g_oled_dirty_hi[OLED_PAGES];
+
+/* SSD1306 上电初始化命令，一个事务连续发送 */
+static const uint8_t g_oled_init_cmds[] = {
+    0xAE,       //--display off
+    0x00,       //---set low column address
+    0x10,       //---set high column address
+    0x40,       //--set start line address
+    0xB0,       //--set page address
+    0x81, 0xFF, // contract control --128
+    0xA1,       //set segment remap
+    0xA6,       //--normal / reverse
+    0xA8, 0x3F, //--set multiplex ratio(1 to 64) --1/32 duty
+    0xC8,       //Com scan direction
+    0xD3, 0x00, //-set display offset
+    0xD5, 0x80, //set osc division
+    0xD8, 0x05, //set area color mode off
+    0xD9, 0xF1, //Set Pre-Charge Period
+    0xDA, 0x12, //set com pin configuartion
+    0xDB, 0x30, //set Vcomh
+    0x8D, 0x14, //set charge pump enable
+    0xAF,       //--turn on oled panel
+};
+
+static OLED_Stats_t g_oled_stats;
+static uint32_t g_oled_legacy_bytes = 0;    // 自上次刷新以来，逐字节写屏方式需要的总线字节数
+
+static void OLED_I2C_Delay(void)
+{
+    volatile uint16_t i;
+    for(i = 0; i < 60; i++)
+    {
+        __NOP();
+    }
+}
+
+/* OLED_I2C_WriteFrame 的结果：只有无应答才说明地址可能不对 */
+#define OLED_I2C_OK         0
+#define OLED_I2C_NACK       1
+#define OLED_I2C_FAIL       2       // 超时、总线忙或总线错误
+
+#if OLED_TRANSPORT == OLED_TRANSPORT_HW
+#define OLED_CMD_TX_MAX     32
+static uint8_t g_oled_cmd_tx[1 + OLED_CMD_TX_MAX];
+
+/* 一次事务：地址 + 控制字节 + len 字节，经 I2C2 DMA 发送并等待完成 */
+static uint8_t OLED_I2C_WriteFrame(uint8_t addr, uint8_t control, const uint8_t *payload, uint16_t len)
+{
+    if(len > OLED_CMD_TX_MAX || OLED_I2C_DMA_Wait(OLED_I2C_DMA_TIMEOUT_MS) == HAL_TIMEOUT)
+        return OLED_I2C_FAIL;
+
+    g_oled_cmd_tx[0] = control;
+    memcpy(&g_oled_cmd_tx[1], payload, len);
+    g_oled_stats.total_bus_bytes += 2U + len;
+    if(OLED_I2C_DMA_WriteBlocks(addr, g_oled_cmd_tx, 1 + len, 0, 1) != HAL_OK)
+        return OLED_I2C_FAIL;
+    if(OLED_I2C_DMA_Wait(OLED_I2C_DMA_TIMEOUT_MS) == HAL_OK)
+        return OLED_I2C_OK;
+    return OLED_I2C_DMA_Nacked() ? OLED_I2C_NACK : OLED_I2C_FAIL;
+}
+#elif OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+#define OLED_ISR_TIMEOUT_MS 300     // 1 KB 整屏在 100 kHz 下约 95 ms
+
+/* 后台刷新：每个脏页一个设置地址的命令事务 + 一个数据事务 */
+static I2C_ISR_Xfer_t g_oled_xfer[2 * OLED_PAGES];
+static uint8_t g_oled_pos_cmd[OLED_PAGES][3];
+static osSemaphoreId_t g_oled_done_sem = NULL;
+static volatile I2C_ISR_Status_t g_oled_xfer_status = I2C_ISR_OK;
+
+/* 描述符链完成回调（TIM4 中断上下文） */
+static void OLED_I2C_Done(I2C_ISR_Status_t status, void *arg)
+{
+    g_oled_xfer_status = status;
+    osSemaphoreRelease(g_oled_done_sem);
+}
+
+/* 等待上一条描述符链完成 */
+static uint8_t OLED_I2C_WaitDone(void)
+{
+    if(I2C_ISR_Busy() && osSemaphoreAcquire(g_oled_done_sem, OLED_ISR_TIMEOUT_MS) != osOK)
+        return OLED_I2C_FAIL;
+    (void)osSemaphoreAcquire(g_oled_done_sem, 0);
+    return g_oled_xfer_status == I2C_ISR_OK ? OLED_I2C_OK : OLED_I2C_NACK;
+}
+
+/* 一次事务：由 TIM4 中断在后台发送，本函数等待完成后返回 */
+static uint8_t OLED_I2C_WriteFrame(uint8_t addr, uint8_t control, const uint8_t *payload, uint16_t len)
+{
+    static I2C_ISR_Xfer_t xfer;
+
+    (void)OLED_I2C_WaitDone();
+    xfer = I2C_ISR_Xfer_t{ NULL, payload, len, addr, control };
+    g_oled_stats.total_bus_bytes += 2U + len;
+    if(I2C_ISR_Submit(&xfer, OLED_I2C_Done, NULL) != I2C_ISR_OK)
+        return OLED_I2C_FAIL;
+    return OLED_I2C_WaitDone();
+}
+#else
+/* 一次事务：地址 + 控制字节 + len 字节连续数据流，并计入总线统计 */
+static uint8_t OLED_I2C_WriteFrame(uint8_t addr, uint8_t control, const uint8_t *payload, uint16_t len)
+{
+    g_oled_stats.total_bus_bytes += 2U + len;
+    return I2C_Write_Buffer(addr, control, payload, len) == 0 ? OLED_I2C_OK : OLED_I2C_NACK;
+}
+#endif
+
+/* 写一帧，无应答时切换到另一个 SSD1306 地址重试一次 */
+static void OLED_I2C_Write(uint8_t control, const uint8_t *payload, uint16_t len)
+{
+    if(OLED_I2C_WriteFrame(g_oled_i2c_addr, control, payload, len) == OLED_I2C_NACK)
+    {
+        // Try alternate SSD1306 address (0x3D << 1 = 0x7A)
+        if(g_oled_i2c_addr == 0x78)
+        {
+            g_oled_i2c_addr = 0x7A;
+        }
+        else
+        {
+            g_oled_i2c_addr = 0x78;
+        }
+        (void)OLED_I2C_WriteFrame(g_oled_i2c_addr, control, payload, len);
+    }
+}
+
+/* 标记 page 页 [x0, x1] 列需要刷新 */
+static void OLED_MarkDirty(uint8_t page, uint8_t x0, uint8_t x1)
+{
+    if(g_oled_dirty_lo[page] > g_oled_dirty_hi[page])
+    {
+        g_oled_dirty_lo[page] = x0;
+        g_oled_dirty_hi[page] = x1;
+        return;
+    }
+    if(x0 < g_oled_dirty_lo[page]) g_oled_dirty_lo[page] = x0;
+    if(x1 > g_oled_dirty_hi[page]) g_oled_dirty_hi[page] = x1;
+}
+
+/* 写入一个显存字节，内容未变化时不标脏 */
+static void OLED_FB_Put(uint8_t x, uint8_t page, uint8_t val)
+{
+    if(x >= X_WIDTH || page >= OLED_PAGES)
+        return;
+    if(OLED_FB(page, x) != val)
+    {
+        OLED_FB(page, x) = val;
+        OLED_MarkDirty(page, x, x);
+    }
+}
+
+/* 在 page 页从 x 列开始写入 n 字节（src 为 NULL 时填充 val），同时累计旧写法的开销：
+   一次 OLED_Set_Pos（3 条命令）+ 每字节一个独立事务，每个事务 3 字节 */
+static void OLED_FB_WriteRun(uint8_t x, uint8_t page, const uint8_t *src, uint8_t val, uint8_t n)
+{
+    uint8_t i;
+
+    g_oled_legacy_bytes += 3U * (3U + n);
+    for(i = 0; i < n; i++)
+    {
+        OLED_FB_Put(x + i, page, src ? src[i] : val);
+    }
+}
+//OLEDµÄÏÔ´æ
+//´æ·Å¸ñÊ½ÈçÏÂ.
+//[0]0 1 2 3 ... 127
+//[1]0 1 2 3 ... 127
+//[2]0 1 2 3 ... 127
+//[3]0 1 2 3 ... 127
+//[4]0 1 2 3 ... 127
+//[5]0 1 2 3 ... 127
+//[6]0 1 2 3 ... 127
+//[7]0 1 2 3 ... 127
+/**********************************************
+//IIC Start
+**********************************************/
+/**********************************************
+//IIC Start
+**********************************************/
+void IIC_Start()
+{
+
+    OLED_SCLK_Set() ;
+    OLED_SDIN_Set();
+    OLED_I2C_Delay();
+    OLED_SDIN_Clr();
+    OLED_I2C_Delay();
+    OLED_SCLK_Clr();
+    OLED_I2C_Delay();
+}
+
+/**********************************************
+//IIC Stop
+**********************************************/
+void IIC_Stop()
+{
+    OLED_SCLK_Clr();
+    OLED_SDIN_Clr();
+    OLED_I2C_Delay();
+    OLED_SCLK_Set() ;
+    OLED_I2C_Delay();
+    OLED_SDIN_Set();
+    OLED_I2C_Delay();
+
+}
+
+void IIC_Wait_Ack()
+{
+
+    //GPIOB->CRH &= 0XFFF0FFFF;	//ÉèÖÃPB12ÎªÉÏÀ­ÊäÈëÄ£Ê½
+    //GPIOB->CRH |= 0x00080000;
+//	OLED_SDA = 1;
+//	delay_us(1);
+    //OLED_SCL = 1;
+    //delay_us(50000);
+/*	while(1)
+	{
+		if(!OLED_SDA)				//ÅÐ¶ÏÊÇ·ñ½ÓÊÕµ½OLED Ó¦´ðÐÅºÅ
+		{
+			//GPIOB->CRH &= 0XFFF0FFFF;	//ÉèÖÃPB12ÎªÍ¨ÓÃÍÆÃâÊä³öÄ£Ê½
+			//GPIOB->CRH |= 0x00030000;
+			return;
+		}
+	}
+*/
+    OLED_SCLK_Set() ;
+    OLED_I2C_Delay();
+    OLED_SCLK_Clr();
+    OLED_I2C_Delay();
+}
+/**********************************************
+// IIC Write byte
+**********************************************/
+
+void Write_IIC_Byte(unsigned char IIC_Byte)
+{
+    unsigned char i;
+    unsigned char m,da;
+    da=IIC_Byte;
+    OLED_SCLK_Clr();
+    OLED_I2C_Delay();
+    for(i=0;i<8;i++)
+    {
+        m=da;
+        //	OLED_SCLK_Clr();
+        m=m&0x80;
+        if(m==0x80)
+        {OLED_SDIN_Set();}
+        else OLED_SDIN_Clr();
+        da=da<<1;
+        OLED_I2C_Delay();
+        OLED_SCLK_Set();
+        OLED_I2C_Delay();
+        OLED_SCLK_Clr();
+        OLED_I2C_Delay();
+    }
+
+
+}
+/**********************************************
+// IIC Write Command
+**********************************************/
+void Write_IIC_Command(unsigned char IIC_Command)
+{
+    OLED_I2C_Write(OLED_CONTROL_CMD, &IIC_Command, 1);
+}
+/**********************************************
+// IIC Write Data
+**********************************************/
+void Write_IIC_Data(unsigned char IIC_Data)
+{
+    OLED_I2C_Write(OLED_CONTROL_DATA, &IIC_Data, 1);
+}
+void OLED_WR_Byte(unsigned dat,unsigned cmd)
+{
+    if(cmd)
+    {
+
+        Write_IIC_Data(dat);
+
+    }
+    else {
+        Write_IIC_Command(dat);
+
+    }
+
+
+}
+
+
+/********************************************
+// fill_Picture
+********************************************/
+void fill_picture(unsigned char fill_Data)
+{
+    unsigned char m;
+    for(m=0;m<OLED_PAGES;m++)
+    {
+        OLED_FB_WriteRun(0, m, NULL, fill_Data, X_WIDTH);
+    }
+    OLED_Refresh();
+}
+
+
+/***********************Delay****************************************/
+void Delay_50ms(unsigned int Del_50ms)
+{
+    unsigned int m;
+    for(;Del_50ms>0;Del_50ms--)
+        for(m=6245;m>0;m--);
+}
+
+void Delay_1ms(unsigned int Del_1ms)
+{
+    unsigned char j;
+    while(Del_1ms--)
+    {
+        for(j=0;j<123;j++);
+    }
+}
+
+//×ø±êÉèÖÃ
+
+void OLED_Set_Pos(unsigned char x, unsigned char y)
+{
+    const uint8_t cmds[3] = { (uint8_t)(0xb0+y), (uint8_t)(((x&0xf0)>>4)|0x10), (uint8_t)(x&0x0f) };
+    OLED_I2C_Write(OLED_CONTROL_CMD, cmds, sizeof(cmds));
+}
+//¿ªÆôOLEDÏÔÊ¾
+void OLED_Display_On(void)
+{
+    static const uint8_t cmds[] = {
+        0X8D,   //SET DCDCÃüÁî
+        0X14,   //DCDC ON
+        0XAF,   //DISPLAY ON
+    };
+    OLED_I2C_Write(OLED_CONTROL_CMD, cmds, sizeof(cmds));
+}
+//¹Ø±ÕOLEDÏÔÊ¾
+void OLED_Display_Off(void)
+{
+    static const uint8_t cmds[] = {
+        0X8D,   //SET DCDCÃüÁî
+        0X10,   //DCDC OFF
+        0XAE,   //DISPLAY OFF
+    };
+    OLED_I2C_Write(OLED_CONTROL_CMD, cmds, sizeof(cmds));
+}
+//ÇåÆÁº¯Êý,ÇåÍêÆÁ,Õû¸öÆÁÄ»ÊÇºÚÉ«µÄ!ºÍÃ»µãÁÁÒ»Ñù!!!
+void OLED_Clear(void)
+{
+    uint8_t i;
+    for(i=0;i<OLED_PAGES;i++)
+    {
+        OLED_FB_WriteRun(0, i, NULL, 0x00, X_WIDTH);
+        OLED_MarkDirty(i, 0, X_WIDTH - 1);    // 屏幕内容未知，强制整页刷新
+    }
+}
+void OLED_On(void)
+{
+    uint8_t i;
+    for(i=0;i<OLED_PAGES;i++)
+    {
+        OLED_FB_WriteRun(0, i, NULL, 0x01, X_WIDTH);
+    }
+}
+//ÔÚÖ¸¶¨Î»ÖÃÏÔÊ¾Ò»¸ö×Ö·û,°üÀ¨²¿·Ö×Ö·û
+//x:0~127
+//y:0~63
+//mode:0,·´°×ÏÔÊ¾;1,Õý³£ÏÔÊ¾
+//size:Ñ¡Ôñ×ÖÌå 16/12
+void OLED_ShowChar(uint8_t x,uint8_t y,uint8_t chr,uint8_t Char_Size)
+{
+    const OLED_Font_t *font = (Char_Size == 16) ? &OLED_Font8x16 : &OLED_Font6x8;
+    uint8_t glyph[16];
+#ifdef OLED_FONT_PROFILE
+    uint32_t start = DWT->CYCCNT;
+#endif
+
+    if(x>Max_Column-1){x=0;y=y+2;}
+    /* 子集字库按需解码，未收录的字符显示为空白 */
+    if(OLED_Font_Decode(font, chr, glyph) == 0)
+        memset(glyph, 0, sizeof(glyph));
+    OLED_FB_WriteRun(x, y, glyph, 0, font->width);
+    if(font->pages == 2)
+        OLED_FB_WriteRun(x, y+1, glyph + font->width, 0, font->width);
+#ifdef OLED_FONT_PROFILE
+    g_oled_stats.glyph_cycles += DWT->CYCCNT - start;
+    g_oled_stats.glyphs++;
+#endif
+}
+//m^nº¯Êý
+uint32_t oled_pow(uint8_t m,uint8_t n)
+{
+    uint32_t result=1;
+    while(n--)result*=m;
+    return result;
+}
+//ÏÔÊ¾2¸öÊý×Ö
+//x,y :Æðµã×ø±ê
+//len :Êý×ÖµÄÎ»Êý
+//size:×ÖÌå´óÐ¡
+//mode:Ä£Ê½	0,Ìî³äÄ£Ê½;1,µþ¼ÓÄ£Ê½
+//num:ÊýÖµ(0~4294967295);
+void OLED_ShowNum(uint8_t x,uint8_t y,uint32_t num,uint8_t len,uint8_t size2)
+{
+    uint8_t t,temp;
+    uint8_t enshow=0;
+    for(t=0;t<len;t++)
+    {
+        temp=(num/oled_pow(10,len-t-1))%10;
+        if(enshow==0&&t<(len-1))
+        {
+            if(temp==0)
+            {
+                OLED_ShowChar(x+(size2/2)*t,y,' ',size2);
+                continue;
+            }else enshow=1;
+
+        }
+        OLED_ShowChar(x+(size2/2)*t,y,temp+'0',size2);
+    }
+}
+//ÏÔÊ¾Ò»¸ö×Ö·ûºÅ´®
+void OLED_ShowString(uint8_t x,uint8_t y,uint8_t *chr,uint8_t Char_Size)
+{
+    unsigned char j=0;
+    while (chr[j]!='\0')
+    {		OLED_ShowChar(x,y,chr[j],Char_Size);
+        x+=8;
+        if(x>120){x=0;y+=2;}
+        j++;
+    }
+}
+//ÏÔÊ¾ºº×Ö
+void OLED_ShowCHinese(uint8_t x,uint8_t y,uint8_t no)
+{
+    uint8_t glyph[OLED_FONT_MAX_BYTES];
+
+    if(OLED_Font_Decode(&OLED_FontHz16, no, glyph) == 0)
+        memset(glyph, 0, sizeof(glyph));
+    OLED_FB_WriteRun(x, y, glyph, 0, 16);
+    OLED_FB_WriteRun(x, y+1, glyph + 16, 0, 16);
+}
+/***********¹¦ÄÜÃèÊö£ºÏÔÊ¾ÏÔÊ¾BMPÍ¼Æ¬128¡Á64ÆðÊ¼µã×ø±ê(x,y),xµÄ·¶Î§0¡«127£¬yÎªÒ³µÄ·¶Î§0¡«7*****************/
+void OLED_DrawBMP(unsigned char x0, unsigned char y0,unsigned char x1, unsigned char y1,unsigned char BMP[])
+{
+    unsigned int j=0;
+    unsigned char y;
+
+    if(y1%8==0) y=y1/8;
+    else y=y1/8+1;
+    for(y=y0;y<y1;y++)
+    {
+        OLED_FB_WriteRun(x0, y, &BMP[j], 0, x1 - x0);
+        j += x1 - x0;
+    }
+}
+
+//画点 x:0~127 y:0~63 t:1 点亮 0 熄灭
+void OLED_DrawPoint(uint8_t x,uint8_t y,uint8_t t)
+{
+    uint8_t page, val;
+    if(x >= X_WIDTH || y >= Y_WIDTH)
+        return;
+    page = y / 8;
+    val = OLED_FB(page, x);
+    if(t) val |= (uint8_t)(1U << (y % 8));
+    else  val &= (uint8_t)~(1U << (y % 8));
+    OLED_FB_Put(x, page, val);
+}
+
+//填充矩形区域 (x1,y1)~(x2,y2)，含端点
+void OLED_Fill(uint8_t x1,uint8_t y1,uint8_t x2,uint8_t y2,uint8_t dot)
+{
+    uint8_t x, y;
+    for(y = y1; y <= y2 && y < Y_WIDTH; y++)
+    {
+        for(x = x1; x <= x2 && x < X_WIDTH; x++)
+        {
+            OLED_DrawPoint(x, y, dot);
+        }
+    }
+}
+
+#if OLED_TRANSPORT == OLED_TRANSPORT_HW
+/**
+ * @brief 把显存中的脏页写到屏幕（后台 DMA）
+ * @note  水平寻址模式下把窗口设为第一个到最后一个脏页，然后每页一个 129 字节的
+ *        数据事务（控制字节 + 128 列），由 DMA 连续发送；函数立即返回，
+ *        再次修改显存前调用 OLED_WaitIdle
+ */
+void OLED_Refresh(void)
+{
+    uint32_t start = g_oled_stats.total_bus_bytes;
+    uint8_t page, first = OLED_PAGES, last = 0;
+
+    for(page = 0; page < OLED_PAGES; page++)
+    {
+        if(g_oled_dirty_lo[page] > g_oled_dirty_hi[page])
+            continue;
+        if(first == OLED_PAGES) first = page;
+        last = page;
+    }
+
+    if(first != OLED_PAGES)
+    {
+        const uint8_t cmds[] = {
+            0x20, 0x00,                 // horizontal addressing
+            0x21, 0x00, X_WIDTH - 1,    // column window
+            0x22, first, last,          // page window
+        };
+        OLED_I2C_Write(OLED_CONTROL_CMD, cmds, sizeof(cmds));
+        if(OLED_I2C_DMA_WriteBlocks(g_oled_i2c_addr, g_oled_fb[first], sizeof(g_oled_fb[0]),
+                                    sizeof(g_oled_fb[0]), last - first + 1) == HAL_OK)
+        {
+            /* 没发出去时保留脏区间，下次刷新重发 */
+            for(page = first; page <= last; page++)
+            {
+                g_oled_dirty_lo[page] = 0xFF;
+                g_oled_dirty_hi[page] = 0;
+            }
+            g_oled_stats.total_bus_bytes += (uint32_t)(last - first + 1) * (1U + sizeof(g_oled_fb[0]));
+        }
+    }
+#elif OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+/**
+ * @brief 把显存中的脏区间写到屏幕（TIM4 中断后台发送）
+ * @note  每个脏页两个描述符：设置页/列地址 + [lo, hi] 列数据；函数立即返回，
+ *        再次修改显存前调用 OLED_WaitIdle
+ */
+void OLED_Refresh(void)
+{
+    uint32_t start = g_oled_stats.total_bus_bytes;
+    I2C_ISR_Xfer_t *prev = NULL;
+    uint8_t page, lo, hi, n = 0;
+
+    (void)OLED_I2C_WaitDone();
+
+    for(page = 0; page < OLED_PAGES; page++)
+    {
+        lo = g_oled_dirty_lo[page];
+        hi = g_oled_dirty_hi[page];
+        if(lo > hi)
+            continue;
+
+        g_oled_pos_cmd[page][0] = 0xb0 + page;
+        g_oled_pos_cmd[page][1] = ((lo & 0xf0) >> 4) | 0x10;
+        g_oled_pos_cmd[page][2] = lo & 0x0f;
+
+        g_oled_xfer[n] = I2C_ISR_Xfer_t{ &g_oled_xfer[n + 1], g_oled_pos_cmd[page], 3,
+                                           g_oled_i2c_addr, OLED_CONTROL_CMD };
+        g_oled_xfer[n + 1] = I2C_ISR_Xfer_t{ NULL, &OLED_FB(page, lo), (uint16_t)(hi - lo + 1),
+                                               g_oled_i2c_addr, OLED_CONTROL_DATA };
+        if(prev != NULL)
+            prev->next = &g_oled_xfer[n];
+        prev = &g_oled_xfer[n + 1];
+        g_oled_stats.total_bus_bytes += 2U + 3U + 2U + (hi - lo + 1);
+        n += 2;
+    }
+
+    /* 没提交出去时保留脏区间，下次刷新重发 */
+    if(n != 0 && I2C_ISR_Submit(&g_oled_xfer[0], OLED_I2C_Done, NULL) == I2C_ISR_OK)
+    {
+        for(page = 0; page < OLED_PAGES; page++)
+        {
+            g_oled_dirty_lo[page] = 0xFF;
+            g_oled_dirty_hi[page] = 0;
+        }
+    }
+#else
+/**
+ * @brief 把显存中的脏区间写到屏幕
+ * @note  每个脏页：一次设置页/列地址，再用一个 I2C 事务连续发送 [lo, hi] 列数据
+ */
+void OLED_Refresh(void)
+{
+    uint32_t start = g_oled_stats.total_bus_bytes;
+    uint8_t page, lo, hi;
+
+    for(page = 0; page < OLED_PAGES; page++)
+    {
+        lo = g_oled_dirty_lo[page];
+        hi = g_oled_dirty_hi[page];
+        if(lo > hi)
+            continue;
+
+        OLED_Set_Pos(lo, page);
+        OLED_I2C_Write(OLED_CONTROL_DATA, &OLED_FB(page, lo), (uint16_t)(hi - lo + 1));
+
+        g_oled_dirty_lo[page] = 0xFF;
+        g_oled_dirty_hi[page] = 0;
+    }
+#endif
+
+    g_oled_stats.refreshes++;
+    g_oled_stats.last_bus_bytes = g_oled_stats.total_bus_bytes - start;
+    g_oled_stats.last_legacy_bytes = g_oled_legacy_bytes;
+    g_oled_legacy_bytes = 0;
+}
+
+/* 等待后台刷新完成（软件 I2C 下刷新是同步的，直接返回） */
+void OLED_WaitIdle(void)
+{
+#if OLED_TRANSPORT == OLED_TRANSPORT_HW
+    (void)OLED_I2C_DMA_Wait(OLED_I2C_DMA_TIMEOUT_MS);
+#elif OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+    (void)OLED_I2C_WaitDone();
+#endif
+}
+
+/* 读取总线字节统计 */
+void OLED_GetStats(OLED_Stats_t *stats)
+{
+    *stats = g_oled_stats;
+}
+
+//³õÊ¼»¯SSD1306
+void OLED_Init(void)
+{
+#if OLED_TRANSPORT == OLED_TRANSPORT_HW
+    OLED_I2C_DMA_Init();
+#elif OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+    I2C_ISR_Init();
+    if(g_oled_done_sem == NULL)
+        g_oled_done_sem = Rtos_SemaphoreNew(RTOS_SEM_oledDone);
+#else
+    Soft_I2C_Init();
+#endif
+    g_oled_i2c_addr = 0x78;
+    memset(g_oled_fb, 0, sizeof(g_oled_fb));
+    for(uint8_t i = 0; i < OLED_PAGES; i++)
+        g_oled_fb[i][0] = OLED_CONTROL_DATA;
+    memset(g_oled_dirty_lo, 0xFF, sizeof(g_oled_dirty_lo));
+    memset(g_oled_dirty_hi, 0, sizeof(g_oled_dirty_hi));
+
+
+    osDelay(800);
+    OLED_I2C_Write(OLED_CONTROL_CMD, g_oled_init_cmds, sizeof(g_oled_init_cmds));
+
+    // Power-on self-test pattern: full on for a short period, then clear.
+    fill_picture(0xFF);
+    osDelay(200);
+    OLED_WaitIdle();
+    OLED_Clear();
+    OLED_Refresh();
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
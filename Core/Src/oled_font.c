@@ -0,0 +1,35 @@
+/*
+================================================================================
+oled_font.c - 子集字库字形解码
+================================================================================
+与 tools/fontgen 共用，生成器用它回读校验生成的表。
+*/
+#include "oled_font.h"
+#include <string.h>
+
+uint8_t OLED_Font_Decode(const OLED_Font_t *font, uint8_t chr, uint8_t *out)
+{
+    uint8_t n = (uint8_t)(font->width * font->pages);
+    const uint8_t *mask, *p;
+    uint8_t g;
+
+    if (chr < font->first || (uint8_t)(chr - font->first) >= font->count) {
+        return 0;
+    }
+    g = font->map[chr - font->first];
+    if (g == OLED_FONT_NONE) {
+        return 0;
+    }
+
+    if (!font->packed) {
+        memcpy(out, font->data + (uint16_t)g * n, n);
+        return n;
+    }
+
+    mask = font->data + font->offset[g];
+    p = mask + (n + 7) / 8;
+    for (uint8_t i = 0; i < n; i++) {
+        out[i] = (mask[i >> 3] & (1U << (i & 7))) ? *p++ : 0;
+    }
+    return n;
+}
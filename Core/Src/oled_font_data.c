@@ -0,0 +1,107 @@
+/*
+================================================================================
+oled_font_data.c - 子集字库，由 tools/fontgen 根据 charset.txt 生成，请勿手工修改
+================================================================================
+格式：非零字节掩码压缩（见 oled_font.h）
+*/
+#include "oled_font.h"
+#include <stddef.h>
+
+/* OLED_Font6x8: 1/92 glyphs */
+static const uint8_t g_font8_map[1] = {
+    0x00,
+};
+static const uint16_t g_font8_offset[1] = {
+    0,
+};
+static const uint8_t g_font8_data[1] = {
+    /* 0x20 */ 0x00,
+};
+const OLED_Font_t OLED_Font6x8 = {
+    .width = 6,
+    .pages = 1,
+    .packed = 1,
+    .first = 0x20,
+    .count = 1,
+    .map = g_font8_map,
+    .offset = g_font8_offset,
+    .data = g_font8_data,
+};
+
+/* OLED_Font8x16: 33/96 glyphs */
+static const uint8_t g_font16_map[96] = {
+    0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0x03, 0xFF,
+    0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x0F, 0xFF, 0xFF, 0x10, 0xFF, 0x11, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x12, 0x13,
+    0xFF, 0xFF, 0x14, 0xFF, 0x15, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x16, 0xFF, 0x17, 0xFF, 0xFF, 0x18, 0x19, 0xFF, 0x1A, 0xFF, 0x1B, 0x1C, 0xFF,
+    0x1D, 0xFF, 0xFF, 0xFF, 0x1E, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x20,
+};
+static const uint16_t g_font16_offset[33] = {
+    0, 2, 15, 24, 28, 42, 52, 66, 80, 92, 106, 119,
+    128, 142, 155, 161, 177, 190, 206, 221, 237, 253, 265, 276,
+    288, 301, 311, 325, 340, 353, 366, 376, 389,
+};
+static const uint8_t g_font16_data[395] = {
+    /* 0x20 */ 0x00, 0x00,
+    /* '%' */ 0x37, 0x7E, 0xF0, 0x08, 0xF0, 0xE0, 0x18, 0x21, 0x1C, 0x03, 0x1E, 0x21, 0x1E,
+    /* '-' */ 0x00, 0xFE, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    /* '.' */ 0x00, 0x06, 0x30, 0x30,
+    /* '0' */ 0x7E, 0x7E, 0xE0, 0x10, 0x08, 0x08, 0x10, 0xE0, 0x0F, 0x10, 0x20, 0x20, 0x10, 0x0F,
+    /* '1' */ 0x0E, 0x3E, 0x10, 0x10, 0xF8, 0x20, 0x20, 0x3F, 0x20, 0x20,
+    /* '2' */ 0x7E, 0x7E, 0x70, 0x08, 0x08, 0x08, 0x88, 0x70, 0x30, 0x28, 0x24, 0x22, 0x21, 0x30,
+    /* '3' */ 0x7E, 0x7E, 0x30, 0x08, 0x88, 0x88, 0x48, 0x30, 0x18, 0x20, 0x20, 0x20, 0x11, 0x0E,
+    /* '4' */ 0x3C, 0x7E, 0xC0, 0x20, 0x10, 0xF8, 0x07, 0x04, 0x24, 0x24, 0x3F, 0x24,
+    /* '5' */ 0x7E, 0x7E, 0xF8, 0x08, 0x88, 0x88, 0x08, 0x08, 0x19, 0x21, 0x20, 0x20, 0x11, 0x0E,
+    /* '6' */ 0x3E, 0x7E, 0xE0, 0x10, 0x88, 0x88, 0x18, 0x0F, 0x11, 0x20, 0x20, 0x11, 0x0E,
+    /* '7' */ 0x7E, 0x08, 0x38, 0x08, 0x08, 0xC8, 0x38, 0x08, 0x3F,
+    /* '8' */ 0x7E, 0x7E, 0x70, 0x88, 0x08, 0x08, 0x88, 0x70, 0x1C, 0x22, 0x21, 0x21, 0x22, 0x1C,
+    /* '9' */ 0x7E, 0x7C, 0xE0, 0x10, 0x08, 0x08, 0x10, 0xE0, 0x31, 0x22, 0x22, 0x11, 0x0F,
+    /* ':' */ 0x18, 0x18, 0xC0, 0xC0, 0x30, 0x30,
+    /* 'C' */ 0x7F, 0x7F, 0xC0, 0x30, 0x08, 0x08, 0x08, 0x08, 0x38, 0x07, 0x18, 0x20, 0x20, 0x20, 0x10, 0x08,
+    /* 'F' */ 0x7F, 0x17, 0x08, 0xF8, 0x88, 0x88, 0xE8, 0x08, 0x10, 0x20, 0x3F, 0x20, 0x03,
+    /* 'H' */ 0xE7, 0xFF, 0x08, 0xF8, 0x08, 0x08, 0xF8, 0x08, 0x20, 0x3F, 0x21, 0x01, 0x01, 0x21, 0x3F, 0x20,
+    /* 'N' */ 0xEF, 0x77, 0x08, 0xF8, 0x30, 0xC0, 0x08, 0xF8, 0x08, 0x20, 0x3F, 0x20, 0x07, 0x18, 0x3F,
+    /* 'O' */ 0x7F, 0x7F, 0xE0, 0x10, 0x08, 0x08, 0x08, 0x10, 0xE0, 0x0F, 0x10, 0x20, 0x20, 0x20, 0x10, 0x0F,
+    /* 'R' */ 0x7F, 0xF7, 0x08, 0xF8, 0x88, 0x88, 0x88, 0x88, 0x70, 0x20, 0x3F, 0x20, 0x03, 0x0C, 0x30, 0x20,
+    /* 'T' */ 0x7F, 0x1C, 0x18, 0x08, 0x08, 0xF8, 0x08, 0x08, 0x18, 0x20, 0x3F, 0x20,
+    /* 'c' */ 0x38, 0x7E, 0x80, 0x80, 0x80, 0x0E, 0x11, 0x20, 0x20, 0x20, 0x11,
+    /* 'e' */ 0x3C, 0x7E, 0x80, 0x80, 0x80, 0x80, 0x1F, 0x22, 0x22, 0x22, 0x22, 0x13,
+    /* 'h' */ 0x3B, 0xE7, 0x08, 0xF8, 0x80, 0x80, 0x80, 0x20, 0x3F, 0x21, 0x20, 0x3F, 0x20,
+    /* 'i' */ 0x0E, 0x3E, 0x80, 0x98, 0x98, 0x20, 0x20, 0x3F, 0x20, 0x20,
+    /* 'k' */ 0x73, 0x7F, 0x08, 0xF8, 0x80, 0x80, 0x80, 0x20, 0x3F, 0x24, 0x02, 0x2D, 0x30, 0x20,
+    /* 'm' */ 0x7F, 0xB7, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x20, 0x3F, 0x20, 0x3F, 0x20, 0x3F,
+    /* 'n' */ 0x3B, 0xE7, 0x80, 0x80, 0x80, 0x80, 0x80, 0x20, 0x3F, 0x21, 0x20, 0x3F, 0x20,
+    /* 'p' */ 0x1B, 0x7F, 0x80, 0x80, 0x80, 0x80, 0x80, 0xFF, 0xA1, 0x20, 0x20, 0x11, 0x0E,
+    /* 't' */ 0x3E, 0x38, 0x80, 0x80, 0xE0, 0x80, 0x80, 0x1F, 0x20, 0x20,
+    /* 'u' */ 0x63, 0xFE, 0x80, 0x80, 0x80, 0x80, 0x1F, 0x20, 0x20, 0x20, 0x10, 0x3F, 0x20,
+    /* 0x7F */ 0x1E, 0x00, 0x0E, 0x11, 0x11, 0x0E,
+};
+const OLED_Font_t OLED_Font8x16 = {
+    .width = 8,
+    .pages = 2,
+    .packed = 1,
+    .first = 0x20,
+    .count = 96,
+    .map = g_font16_map,
+    .offset = g_font16_offset,
+    .data = g_font16_data,
+};
+
+/* OLED_FontHz16: 0/10 glyphs */
+static const uint8_t g_hz16_map[1] = {
+    0xFF,
+};
+static const uint8_t g_hz16_data[1] = {
+    0x00,
+};
+const OLED_Font_t OLED_FontHz16 = {
+    .width = 16,
+    .pages = 2,
+    .packed = 1,
+    .first = 0x00,
+    .count = 1,
+    .map = g_hz16_map,
+    .offset = NULL,
+    .data = g_hz16_data,
+};
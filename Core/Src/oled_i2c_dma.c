@@ -0,0 +1,278 @@
+/*
+================================================================================
+oled_i2c_dma.c - 硬件 I2C + DMA 显示传输实现文件
+================================================================================
+I2C2 主机模式，起始/地址阶段由事件中断推进，数据字节全部由 DMA 搬运，
+最后一个字节移出（BTF）后在中断里发停止或重复起始，CPU 只处理每个块
+的 3 次中断。
+
+发停止后不等它真正出现在总线上就报告完成，所以下一次传输开始前先短暂等
+STOP/BUSY 清零（400 kHz 下只有几微秒），而不是直接返回 HAL_BUSY。
+*/
+#include "oled_i2c_dma.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "cmsis_os2.h"
+#include "rtos_objects.h"
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    OLED_I2C_DMA_IDLE = 0,
+    OLED_I2C_DMA_START,         // START requested, waiting for SB
+    OLED_I2C_DMA_ADDR,          // address sent, waiting for ADDR
+    OLED_I2C_DMA_DATA,          // DMA feeding DR
+    OLED_I2C_DMA_DRAIN          // DMA done, waiting for BTF on the last byte
+} OLED_I2C_DMA_State_t;
+
+typedef struct {
+    volatile OLED_I2C_DMA_State_t state;
+    volatile HAL_StatusTypeDef    result;
+    volatile uint32_t             error;        // SR1 error bits of the failed transfer
+    uint8_t        addr;
+    const uint8_t *next;
+    uint16_t       len;
+    uint16_t       stride;
+    uint8_t        remaining;
+} OLED_I2C_DMA_Xfer_t;
+
+/* Private variables ---------------------------------------------------------*/
+DMA_HandleTypeDef hdma_i2c2_tx;
+
+static OLED_I2C_DMA_Xfer_t oled_i2c_xfer;
+static osSemaphoreId_t oledI2cDoneHandle = NULL;
+
+/* Private function prototypes -----------------------------------------------*/
+static bool OLED_I2C_DMA_WaitBusFree(void);
+static void OLED_I2C_DMA_StartBlock(void);
+static void OLED_I2C_DMA_Finish(HAL_StatusTypeDef result);
+static void OLED_I2C_DMA_CpltCallback(DMA_HandleTypeDef *hdma);
+
+/**
+  * @brief  Configure I2C2 as a 400 kHz master with DMA1_Channel4 TX and event/error interrupts
+  * @retval HAL_StatusTypeDef
+  */
+HAL_StatusTypeDef OLED_I2C_DMA_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    uint32_t pclk1_mhz = HAL_RCC_GetPCLK1Freq() / 1000000U;
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_I2C2_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    GPIO_InitStruct.Pin = OLED_I2C_DMA_SCL_Pin | OLED_I2C_DMA_SDA_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_AF_OD;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(OLED_I2C_DMA_GPIO_Port, &GPIO_InitStruct);
+
+    /* Reset the peripheral to clear a BUSY flag left by a glitch on the lines */
+    __HAL_RCC_I2C2_FORCE_RESET();
+    __HAL_RCC_I2C2_RELEASE_RESET();
+
+    /* Fast mode, Tlow/Thigh = 2: CCR = PCLK1 / (3 * 400 kHz) = 30 at 36 MHz; rise time 300 ns */
+    I2C2->CR2 = pclk1_mhz;
+    I2C2->CCR = I2C_CCR_FS | (HAL_RCC_GetPCLK1Freq() / (3U * OLED_I2C_DMA_SPEED_HZ));
+    I2C2->TRISE = (pclk1_mhz * 300U) / 1000U + 1U;
+    I2C2->CR1 = I2C_CR1_PE;
+
+    /* DMA1_Channel4: buffer -> I2C2 DR, one block at a time */
+    hdma_i2c2_tx.Instance = DMA1_Channel4;
+    hdma_i2c2_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_i2c2_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_i2c2_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_i2c2_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_i2c2_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_i2c2_tx.Init.Mode = DMA_NORMAL;
+    hdma_i2c2_tx.Init.Priority = DMA_PRIORITY_LOW;
+    if (HAL_DMA_Init(&hdma_i2c2_tx) != HAL_OK)
+    {
+        return HAL_ERROR;
+    }
+    hdma_i2c2_tx.XferCpltCallback = OLED_I2C_DMA_CpltCallback;
+
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+    HAL_NVIC_SetPriority(I2C2_EV_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C2_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C2_ER_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C2_ER_IRQn);
+
+#if OLED_TRANSPORT == OLED_TRANSPORT_HW
+    if (oledI2cDoneHandle == NULL)
+    {
+        oledI2cDoneHandle = Rtos_SemaphoreNew(RTOS_SEM_oledDone);
+    }
+#endif
+    oled_i2c_xfer.state = OLED_I2C_DMA_IDLE;
+    oled_i2c_xfer.result = HAL_OK;
+
+    return oledI2cDoneHandle != NULL ? HAL_OK : HAL_ERROR;
+}
+
+/**
+  * @brief  Start a chained block write in the background
+  * @param  addr: 8-bit device address (write)
+  * @param  first: first block, including its leading control byte
+  * @param  len: bytes per block
+  * @param  stride: distance between block starts
+  * @param  count: number of blocks
+  * @retval HAL_OK when started, HAL_BUSY if a transfer is still active or the bus
+  *         stays busy past OLED_I2C_DMA_BUS_FREE_US
+  */
+HAL_StatusTypeDef OLED_I2C_DMA_WriteBlocks(uint8_t addr, const uint8_t *first, uint16_t len,
+                                           uint16_t stride, uint8_t count)
+{
+    if (len == 0 || count == 0)
+    {
+        return HAL_ERROR;
+    }
+    if (oled_i2c_xfer.state != OLED_I2C_DMA_IDLE || !OLED_I2C_DMA_WaitBusFree())
+    {
+        return HAL_BUSY;
+    }
+
+    /* Drop a completion left over from a transfer nobody waited for */
+    (void)osSemaphoreAcquire(oledI2cDoneHandle, 0);
+
+    oled_i2c_xfer.addr = addr;
+    oled_i2c_xfer.next = first;
+    oled_i2c_xfer.len = len;
+    oled_i2c_xfer.stride = stride;
+    oled_i2c_xfer.remaining = count;
+    oled_i2c_xfer.result = HAL_OK;
+    oled_i2c_xfer.error = 0;
+
+    I2C2->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+    OLED_I2C_DMA_StartBlock();
+    return HAL_OK;
+}
+
+/**
+  * @brief  Wait for the background transfer, aborting it on timeout
+  * @param  timeout: kernel ticks
+  * @retval Result of the last transfer
+  */
+HAL_StatusTypeDef OLED_I2C_DMA_Wait(uint32_t timeout)
+{
+    if (oled_i2c_xfer.state == OLED_I2C_DMA_IDLE)
+    {
+        return oled_i2c_xfer.result;
+    }
+
+    if (osSemaphoreAcquire(oledI2cDoneHandle, timeout) != osOK)
+    {
+        taskENTER_CRITICAL();
+        if (oled_i2c_xfer.state != OLED_I2C_DMA_IDLE)
+        {
+            HAL_DMA_Abort(&hdma_i2c2_tx);
+            I2C2->CR1 |= I2C_CR1_STOP;
+            OLED_I2C_DMA_Finish(HAL_TIMEOUT);
+        }
+        taskEXIT_CRITICAL();
+        (void)osSemaphoreAcquire(oledI2cDoneHandle, 0);
+    }
+
+    return oled_i2c_xfer.result;
+}
+
+bool OLED_I2C_DMA_Busy(void)
+{
+    return oled_i2c_xfer.state != OLED_I2C_DMA_IDLE;
+}
+
+bool OLED_I2C_DMA_Nacked(void)
+{
+    return oled_i2c_xfer.state == OLED_I2C_DMA_IDLE && (oled_i2c_xfer.error & I2C_SR1_AF) != 0;
+}
+
+/* The previous transfer reports completion as soon as STOP is requested; wait for
+   the stop condition to leave the bus. Bounded by a loop count: every pass costs
+   at least one cycle, so this gives up after at most OLED_I2C_DMA_BUS_FREE_US. */
+static bool OLED_I2C_DMA_WaitBusFree(void)
+{
+    for (uint32_t n = (SystemCoreClock / 1000000U) * OLED_I2C_DMA_BUS_FREE_US; n != 0; n--)
+    {
+        if (!(I2C2->CR1 & I2C_CR1_STOP) && !(I2C2->SR2 & I2C_SR2_BUSY))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Arm DMA for the next block and request a (repeated) start */
+static void OLED_I2C_DMA_StartBlock(void)
+{
+    HAL_DMA_Start_IT(&hdma_i2c2_tx, (uint32_t)oled_i2c_xfer.next, (uint32_t)&I2C2->DR, oled_i2c_xfer.len);
+    I2C2->CR2 |= I2C_CR2_DMAEN;
+    oled_i2c_xfer.state = OLED_I2C_DMA_START;
+    I2C2->CR1 |= I2C_CR1_START;
+}
+
+static void OLED_I2C_DMA_Finish(HAL_StatusTypeDef result)
+{
+    I2C2->CR2 &= ~(I2C_CR2_DMAEN | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN);
+    oled_i2c_xfer.result = result;
+    oled_i2c_xfer.state = OLED_I2C_DMA_IDLE;
+    osSemaphoreRelease(oledI2cDoneHandle);
+}
+
+/* Last byte handed to the shift register; BTF marks the end of the block */
+static void OLED_I2C_DMA_CpltCallback(DMA_HandleTypeDef *hdma)
+{
+    oled_i2c_xfer.state = OLED_I2C_DMA_DRAIN;
+}
+
+/**
+  * @brief  I2C2 event interrupt: SB -> send address, ADDR -> hand over to DMA,
+  *         BTF after the last byte -> repeated start for the next block or stop
+  */
+void OLED_I2C_DMA_EV_IRQHandler(void)
+{
+    uint32_t sr1 = I2C2->SR1;
+
+    if (sr1 & I2C_SR1_SB)
+    {
+        I2C2->DR = oled_i2c_xfer.addr;
+        oled_i2c_xfer.state = OLED_I2C_DMA_ADDR;
+    }
+    else if (sr1 & I2C_SR1_ADDR)
+    {
+        (void)I2C2->SR2;
+        oled_i2c_xfer.state = OLED_I2C_DMA_DATA;
+    }
+    else if ((sr1 & I2C_SR1_BTF) && oled_i2c_xfer.state == OLED_I2C_DMA_DRAIN)
+    {
+        I2C2->CR2 &= ~I2C_CR2_DMAEN;
+        if (--oled_i2c_xfer.remaining != 0)
+        {
+            oled_i2c_xfer.next += oled_i2c_xfer.stride;
+            OLED_I2C_DMA_StartBlock();
+        }
+        else
+        {
+            I2C2->CR1 |= I2C_CR1_STOP;
+            OLED_I2C_DMA_Finish(HAL_OK);
+        }
+    }
+}
+
+/**
+  * @brief  I2C2 error interrupt: NACK, bus error or arbitration loss ends the transfer
+  */
+void OLED_I2C_DMA_ER_IRQHandler(void)
+{
+    uint32_t sr1 = I2C2->SR1;
+
+    I2C2->SR1 = sr1 & ~(I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR);
+    oled_i2c_xfer.error = sr1 & (I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR);
+    HAL_DMA_Abort(&hdma_i2c2_tx);
+    if (!(sr1 & I2C_SR1_ARLO))
+    {
+        I2C2->CR1 |= I2C_CR1_STOP;
+    }
+    if (oled_i2c_xfer.state != OLED_I2C_DMA_IDLE)
+    {
+        OLED_I2C_DMA_Finish(HAL_ERROR);
+    }
+}
@@ -0,0 +1,61 @@
+/*
+================================================================================
+oled_spark.c - OLED 趋势图实现文件
+================================================================================
+一页 8 个像素行，显存字节的 bit0 在最上面。每个桶画成从 max 到 min 的一段竖线，
+直接拼成整页的列字节后一次写入显存，不经过逐点的 OLED_DrawPoint。
+数据范围小于 8 个单位时按 1 单位/像素居中显示，避免 1 度的波动被放大成满幅。
+*/
+#include "oled_spark.h"
+
+/* Private functions ---------------------------------------------------------*/
+/* 数值 v 对应的像素行（0 在上，7 在下） */
+static uint8_t OLED_Spark_Row(int16_t v, int16_t base, int16_t span)
+{
+    return (uint8_t)(7 - (v - base) * 7 / span);
+}
+
+/* Public functions ----------------------------------------------------------*/
+void OLED_Spark_Draw(uint8_t x, uint8_t page, const History_Bucket_t *b, uint8_t n)
+{
+    uint8_t cols[OLED_SPARK_MAX_COLS];
+    int16_t lo = INT8_MAX, hi = INT8_MIN;
+    int16_t base, span;
+
+    if (n > OLED_SPARK_MAX_COLS) {
+        b += n - OLED_SPARK_MAX_COLS;   // 只保留最新的部分
+        n = OLED_SPARK_MAX_COLS;
+    }
+    if (n == 0 || x + n > X_WIDTH || page >= OLED_PAGES) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < n; i++) {
+        if (!History_BucketValid(&b[i])) {
+            continue;
+        }
+        if (b[i].min < lo) lo = b[i].min;
+        if (b[i].max > hi) hi = b[i].max;
+    }
+
+    span = hi - lo;
+    base = lo;
+    if (span < 7) {
+        base = lo - (7 - span) / 2;
+        span = 7;
+    }
+
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t top, bottom;
+
+        if (!History_BucketValid(&b[i])) {
+            cols[i] = 0x00;
+            continue;
+        }
+        top = OLED_Spark_Row(b[i].max, base, span);
+        bottom = OLED_Spark_Row(b[i].min, base, span);
+        cols[i] = (uint8_t)((0xFFU << top) & (0xFFU >> (7 - bottom)));
+    }
+
+    OLED_DrawBMP(x, page, (uint8_t)(x + n), (uint8_t)(page + 1), cols);
+}
@@ -0,0 +1,139 @@
+/*
+================================================================================
+oled_text.c - OLED 文本字段层实现文件
+================================================================================
+每个字段保存上次写入显存的字符串。Set 时逐字符比较，只对内容变化的字符格
+调用 OLED_ShowChar，其余字符格既不重新取模也不产生脏列，例如 "Tick: 12345"
+每帧通常只改变末尾一两位数字。
+*/
+#include "oled_text.h"
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint8_t x;
+    uint8_t page;
+    uint8_t width;                  // 字符数
+    uint8_t size;                   // 8 或 16
+    uint8_t valid;                  // last[] 与显存一致
+    char    last[OLED_TEXT_MAX_CHARS];
+} OLED_TextField_t;
+
+/* Private variables ---------------------------------------------------------*/
+static OLED_TextField_t g_text_fields[OLED_TEXT_MAX_FIELDS];
+static uint8_t g_text_field_count = 0;
+static OLED_TextStats_t g_text_stats;
+static uint16_t g_text_frame_cells = 0;     // 自上次 Flush 以来重绘的字符格
+
+/* 定位事务（地址 + 控制字节 + 3 条命令）与数据事务的固定开销 */
+#define OLED_TEXT_POS_BYTES         (2U + 3U)
+#define OLED_TEXT_DATA_OVERHEAD     2U
+
+/* Private functions ---------------------------------------------------------*/
+static uint8_t OLED_Text_CellWidth(uint8_t size)
+{
+    return size == 16 ? 8 : 6;
+}
+
+static uint8_t OLED_Text_CellPages(uint8_t size)
+{
+    return size == 16 ? 2 : 1;
+}
+
+/* Public functions ----------------------------------------------------------*/
+int OLED_Text_AddField(uint8_t x, uint8_t page, uint8_t width, uint8_t size)
+{
+    OLED_TextField_t *f;
+
+    if (g_text_field_count >= OLED_TEXT_MAX_FIELDS || width == 0 || width > OLED_TEXT_MAX_CHARS) {
+        return -1;
+    }
+    if (size != 8 && size != 16) {
+        return -1;
+    }
+    if ((uint16_t)x + (uint16_t)width * OLED_Text_CellWidth(size) > X_WIDTH ||
+        page + OLED_Text_CellPages(size) > OLED_PAGES) {
+        return -1;
+    }
+
+    f = &g_text_fields[g_text_field_count];
+    memset(f, 0, sizeof(*f));
+    f->x = x;
+    f->page = page;
+    f->width = width;
+    f->size = size;
+
+    return g_text_field_count++;
+}
+
+void OLED_Text_Set(uint8_t field, const char *str)
+{
+    OLED_TextField_t *f;
+    uint8_t cell;
+    uint8_t ended = 0;
+
+    if (field >= g_text_field_count || str == NULL) {
+        return;
+    }
+    f = &g_text_fields[field];
+    cell = OLED_Text_CellWidth(f->size);
+
+    for (uint8_t i = 0; i < f->width; i++) {
+        char c = ended ? '\0' : str[i];
+
+        if (c == '\0') {
+            ended = 1;
+            c = ' ';
+        } else if ((uint8_t)c < ' ' || (uint8_t)c > 0x7F) {
+            c = ' ';                // 字库只有 0x20..0x7F
+        }
+
+        if (f->valid && f->last[i] == c) {
+            g_text_stats.cells_skipped++;
+            continue;
+        }
+
+        OLED_ShowChar(f->x + i * cell, f->page, (uint8_t)c, f->size);
+        f->last[i] = c;
+        g_text_stats.cells_drawn++;
+        g_text_frame_cells++;
+    }
+    f->valid = 1;
+}
+
+void OLED_Text_Flush(void)
+{
+    OLED_Stats_t oled;
+    uint32_t full = 0;
+
+    OLED_Refresh();
+    OLED_GetStats(&oled);
+
+    /* 基准：每个字段覆盖的每一页都整行重新发送 */
+    for (uint8_t i = 0; i < g_text_field_count; i++) {
+        const OLED_TextField_t *f = &g_text_fields[i];
+        uint32_t row = OLED_TEXT_POS_BYTES + OLED_TEXT_DATA_OVERHEAD +
+                       (uint32_t)f->width * OLED_Text_CellWidth(f->size);
+        full += row * OLED_Text_CellPages(f->size);
+    }
+
+    g_text_stats.frames++;
+    g_text_stats.last_cells_drawn = g_text_frame_cells;
+    g_text_stats.last_full_bytes = (uint16_t)full;
+    g_text_stats.last_bus_bytes = (uint16_t)oled.last_bus_bytes;
+    g_text_stats.last_saved_bytes = full > oled.last_bus_bytes ? (uint16_t)(full - oled.last_bus_bytes) : 0;
+    g_text_stats.total_saved_bytes += g_text_stats.last_saved_bytes;
+    g_text_frame_cells = 0;
+}
+
+void OLED_Text_Invalidate(void)
+{
+    for (uint8_t i = 0; i < g_text_field_count; i++) {
+        g_text_fields[i].valid = 0;
+    }
+}
+
+void OLED_Text_GetStats(OLED_TextStats_t *stats)
+{
+    *stats = g_text_stats;
+}
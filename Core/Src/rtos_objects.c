@@ -0,0 +1,233 @@
+/*
+================================================================================
+rtos_objects.c - RTOS 对象静态分配实现文件
+================================================================================
+按 rtos_objects.h 中的表展开出每个对象的存储，符号统一命名为
+rtos_<类别>_<对象名>，tools/ram_report 据此从 ELF 中统计每个对象的 RAM。
+定时器不经过 osTimerNew：它即使给了 cb_mem 也会为回调参数 pvPortMalloc
+8 字节，这里直接用 xTimerCreateStatic 和自己的回调跳板。
+*/
+#include "rtos_objects.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "app_task.h"
+#include "uart.h"
+#include "mqtt.h"
+#include "sensor_stats.h"
+#include "msg_buf.h"
+#include "trace_recorder.h"
+#include "freertos_mpool.h"
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    osTimerFunc_t func;
+    void         *arg;
+} Rtos_TimerCallback_t;
+
+/* Private function prototypes -----------------------------------------------*/
+void KeepAliveTimer_Callback(void *argument);
+
+/* Private variables ---------------------------------------------------------*/
+/* 空闲任务与定时器服务任务（由内核通过 vApplicationGet*TaskMemory 取用） */
+static StaticTask_t rtos_tcb_IdleTask;
+static StackType_t  rtos_stack_IdleTask[RTOS_IDLE_STACK_WORDS];
+static StaticTask_t rtos_tcb_TimerTask;
+static StackType_t  rtos_stack_TimerTask[RTOS_TIMER_STACK_WORDS];
+
+#define RTOS_STORAGE_TASK(obj, entry, words, prio) \
+    static StaticTask_t rtos_tcb_##obj; \
+    static StackType_t  rtos_stack_##obj[words];
+#define RTOS_STORAGE_QUEUE(obj, depth, type) \
+    static StaticQueue_t rtos_qcb_##obj; \
+    static uint8_t       rtos_qbuf_##obj[(depth) * sizeof(type)];
+#define RTOS_STORAGE_POOL(obj, count, type) \
+    static MemPool_t     rtos_pool_##obj; \
+    static uint32_t      rtos_pblk_##obj[MEMPOOL_ARR_SIZE(count, sizeof(type)) / sizeof(uint32_t)];
+#define RTOS_STORAGE_MUTEX(obj) \
+    static StaticSemaphore_t rtos_mutex_##obj;
+#define RTOS_STORAGE_SEMAPHORE(obj, max, initial) \
+    static StaticSemaphore_t rtos_sem_##obj;
+#define RTOS_STORAGE_TIMER(obj, func, type) \
+    static StaticTimer_t        rtos_timer_##obj; \
+    static Rtos_TimerCallback_t rtos_timercb_##obj;
+
+RTOS_TASK_TABLE(RTOS_STORAGE_TASK)
+RTOS_QUEUE_TABLE(RTOS_STORAGE_QUEUE)
+RTOS_POOL_TABLE(RTOS_STORAGE_POOL)
+RTOS_MUTEX_TABLE(RTOS_STORAGE_MUTEX)
+RTOS_SEMAPHORE_TABLE(RTOS_STORAGE_SEMAPHORE)
+RTOS_TIMER_TABLE(RTOS_STORAGE_TIMER)
+
+/* 创建参数，只读，放在 flash */
+#define RTOS_ATTR_TASK(obj, entry, words, prio) \
+    { .name = #obj, .cb_mem = &rtos_tcb_##obj, .cb_size = sizeof(StaticTask_t), \
+      .stack_mem = rtos_stack_##obj, .stack_size = sizeof(rtos_stack_##obj), .priority = (prio) },
+#define RTOS_ENTRY_TASK(obj, entry, words, prio)    entry,
+#define RTOS_ATTR_QUEUE(obj, depth, type) \
+    { .name = #obj, .cb_mem = &rtos_qcb_##obj, .cb_size = sizeof(StaticQueue_t), \
+      .mq_mem = rtos_qbuf_##obj, .mq_size = sizeof(rtos_qbuf_##obj) },
+#define RTOS_SHAPE_QUEUE(obj, depth, type)          { (depth), sizeof(type) },
+#define RTOS_ATTR_POOL(obj, count, type) \
+    { .name = #obj, .cb_mem = &rtos_pool_##obj, .cb_size = sizeof(MemPool_t), \
+      .mp_mem = rtos_pblk_##obj, .mp_size = sizeof(rtos_pblk_##obj) },
+#define RTOS_SHAPE_POOL(obj, count, type)           { (count), sizeof(type) },
+#define RTOS_ATTR_MUTEX(obj) \
+    { .name = #obj, .cb_mem = &rtos_mutex_##obj, .cb_size = sizeof(StaticSemaphore_t) },
+#define RTOS_ATTR_SEMAPHORE(obj, max, initial) \
+    { .name = #obj, .cb_mem = &rtos_sem_##obj, .cb_size = sizeof(StaticSemaphore_t) },
+#define RTOS_COUNT_SEMAPHORE(obj, max, initial)     { (max), (initial) },
+#define RTOS_DEF_TIMER(obj, func, type) \
+    { #obj, func, (type) == osTimerPeriodic ? pdTRUE : pdFALSE, &rtos_timer_##obj, &rtos_timercb_##obj },
+
+static const osThreadAttr_t g_rtos_task_attr[] = { RTOS_TASK_TABLE(RTOS_ATTR_TASK) };
+static const osThreadFunc_t g_rtos_task_entry[] = { RTOS_TASK_TABLE(RTOS_ENTRY_TASK) };
+
+static const osMessageQueueAttr_t g_rtos_queue_attr[] = { RTOS_QUEUE_TABLE(RTOS_ATTR_QUEUE) };
+static const struct {
+    uint32_t depth;
+    uint32_t size;
+} g_rtos_queue_shape[] = { RTOS_QUEUE_TABLE(RTOS_SHAPE_QUEUE) };
+
+static const osMemoryPoolAttr_t g_rtos_pool_attr[] = { RTOS_POOL_TABLE(RTOS_ATTR_POOL) };
+static const struct {
+    uint32_t count;
+    uint32_t size;
+} g_rtos_pool_shape[] = { RTOS_POOL_TABLE(RTOS_SHAPE_POOL) };
+
+static const osMutexAttr_t g_rtos_mutex_attr[] = { RTOS_MUTEX_TABLE(RTOS_ATTR_MUTEX) };
+
+#if OLED_TRANSPORT != OLED_TRANSPORT_SOFT
+static const osSemaphoreAttr_t g_rtos_sem_attr[] = { RTOS_SEMAPHORE_TABLE(RTOS_ATTR_SEMAPHORE) };
+static const struct {
+    uint32_t max;
+    uint32_t initial;
+} g_rtos_sem_count[] = { RTOS_SEMAPHORE_TABLE(RTOS_COUNT_SEMAPHORE) };
+#endif
+
+static const struct {
+    const char           *name;
+    osTimerFunc_t         func;
+    UBaseType_t           reload;
+    StaticTimer_t        *cb;
+    Rtos_TimerCallback_t *callback;
+} g_rtos_timer_def[] = { RTOS_TIMER_TABLE(RTOS_DEF_TIMER) };
+
+/* 编译期预算：表内全部对象（不计链接器对齐填充） */
+#define RTOS_BYTES_TASK(obj, entry, words, prio)    + sizeof(StaticTask_t) + (words) * sizeof(StackType_t)
+#define RTOS_BYTES_QUEUE(obj, depth, type)          + sizeof(StaticQueue_t) + (depth) * sizeof(type)
+#define RTOS_BYTES_POOL(obj, count, type)           + sizeof(MemPool_t) + MEMPOOL_ARR_SIZE(count, sizeof(type))
+#define RTOS_BYTES_MUTEX(obj)                       + sizeof(StaticSemaphore_t)
+#define RTOS_BYTES_SEMAPHORE(obj, max, initial)     + sizeof(StaticSemaphore_t)
+#define RTOS_BYTES_TIMER(obj, func, type)           + sizeof(StaticTimer_t) + sizeof(Rtos_TimerCallback_t)
+
+#define RTOS_STATIC_RAM_BYTES ( \
+    2 * sizeof(StaticTask_t) + (RTOS_IDLE_STACK_WORDS + RTOS_TIMER_STACK_WORDS) * sizeof(StackType_t) \
+    RTOS_TASK_TABLE(RTOS_BYTES_TASK) \
+    RTOS_QUEUE_TABLE(RTOS_BYTES_QUEUE) \
+    RTOS_POOL_TABLE(RTOS_BYTES_POOL) \
+    RTOS_MUTEX_TABLE(RTOS_BYTES_MUTEX) \
+    RTOS_SEMAPHORE_TABLE(RTOS_BYTES_SEMAPHORE) \
+    RTOS_TIMER_TABLE(RTOS_BYTES_TIMER))
+
+_Static_assert(RTOS_STATIC_RAM_BYTES <= RTOS_RAM_BUDGET,
+               "RTOS objects exceed RTOS_RAM_BUDGET: shrink a stack or queue in rtos_objects.h");
+
+/* Private functions ---------------------------------------------------------*/
+static void Rtos_TimerTrampoline(TimerHandle_t timer)
+{
+    Rtos_TimerCallback_t *cb = (Rtos_TimerCallback_t *)pvTimerGetTimerID(timer);
+
+    cb->func(cb->arg);
+}
+
+/* Public functions ----------------------------------------------------------*/
+osThreadId_t Rtos_ThreadNew(Rtos_TaskId_t id, void *argument)
+{
+    if (id >= RTOS_TASK_COUNT) {
+        return NULL;
+    }
+    return osThreadNew(g_rtos_task_entry[id], argument, &g_rtos_task_attr[id]);
+}
+
+osMessageQueueId_t Rtos_QueueNew(Rtos_QueueId_t id)
+{
+    osMessageQueueId_t queue;
+
+    if (id >= RTOS_QUEUE_COUNT) {
+        return NULL;
+    }
+    queue = osMessageQueueNew(g_rtos_queue_shape[id].depth, g_rtos_queue_shape[id].size, &g_rtos_queue_attr[id]);
+    Trace_NameObject(queue, g_rtos_queue_attr[id].name);
+    return queue;
+}
+
+osMemoryPoolId_t Rtos_PoolNew(Rtos_PoolId_t id)
+{
+    if (id >= RTOS_POOL_COUNT) {
+        return NULL;
+    }
+    return osMemoryPoolNew(g_rtos_pool_shape[id].count, g_rtos_pool_shape[id].size, &g_rtos_pool_attr[id]);
+}
+
+osMutexId_t Rtos_MutexNew(Rtos_MutexId_t id)
+{
+    osMutexId_t mutex;
+
+    if (id >= RTOS_MUTEX_COUNT) {
+        return NULL;
+    }
+    mutex = osMutexNew(&g_rtos_mutex_attr[id]);
+    Trace_NameObject(mutex, g_rtos_mutex_attr[id].name);
+    return mutex;
+}
+
+osSemaphoreId_t Rtos_SemaphoreNew(Rtos_SemaphoreId_t id)
+{
+#if OLED_TRANSPORT != OLED_TRANSPORT_SOFT
+    osSemaphoreId_t sem;
+
+    if (id < RTOS_SEM_COUNT) {
+        sem = osSemaphoreNew(g_rtos_sem_count[id].max, g_rtos_sem_count[id].initial, &g_rtos_sem_attr[id]);
+        Trace_NameObject(sem, g_rtos_sem_attr[id].name);
+        return sem;
+    }
+#endif
+    (void)id;
+    return NULL;
+}
+
+osTimerId_t Rtos_TimerNew(Rtos_TimerId_t id, void *argument)
+{
+    if (id >= RTOS_TIMER_COUNT) {
+        return NULL;
+    }
+    g_rtos_timer_def[id].callback->func = g_rtos_timer_def[id].func;
+    g_rtos_timer_def[id].callback->arg = argument;
+    /* 周期先设为 1 tick，与 osTimerNew 相同，osTimerStart 时再设置真正的周期 */
+    return (osTimerId_t)xTimerCreateStatic(g_rtos_timer_def[id].name, 1, g_rtos_timer_def[id].reload,
+                                           g_rtos_timer_def[id].callback, Rtos_TimerTrampoline,
+                                           g_rtos_timer_def[id].cb);
+}
+
+uint32_t Rtos_StaticRamBytes(void)
+{
+    return RTOS_STATIC_RAM_BYTES;
+}
+
+/* 覆盖 cmsis_os2.c 中的弱定义，使空闲/定时器任务的内存也出现在同一张表里 */
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+                                   uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer = &rtos_tcb_IdleTask;
+    *ppxIdleTaskStackBuffer = rtos_stack_IdleTask;
+    *pulIdleTaskStackSize = RTOS_IDLE_STACK_WORDS;
+}
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer,
+                                    uint32_t *pulTimerTaskStackSize)
+{
+    *ppxTimerTaskTCBBuffer = &rtos_tcb_TimerTask;
+    *ppxTimerTaskStackBuffer = rtos_stack_TimerTask;
+    *pulTimerTaskStackSize = RTOS_TIMER_STACK_WORDS;
+}
@@ -1,35 +1,327 @@
+/*
+================================================================================
+sensor.c - 传感器驱动框架实现文件
+================================================================================
+*/
 #include "sensor.h"
-#include "FreeRTOS.h"
 #include "task.h"
 #include "stdio.h"
-#include "stdlib.h"
-/* 模拟传感器初始化 */
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+typedef enum {
+    SENSOR_STATE_IDLE = 0,
+    SENSOR_STATE_READING
+} Sensor_State_t;
+
+typedef struct {
+    const Sensor_Config_t *config;
+    Sensor_State_t   state;
+    uint8_t          valid;
+    TickType_t       next_due;
+    TickType_t       slot;          // 当前读取对应的名义采样时刻
+    TickType_t       started;
+    uint32_t         errors;
+    Sensor_Jitter_t  jitter;
+    Sensor_Reading_t latest;
+} Sensor_Channel_t;
+
+/* Private variables ---------------------------------------------------------*/
+static Sensor_Channel_t g_sensors[SENSOR_MAX_DEVICES];
+static uint8_t g_sensor_count = 0;
+static Sensor_Listener_t g_sensor_listener = NULL;
+
+static const int32_t g_pow10[] = {1, 10, 100, 1000, 10000};
+static const uint32_t g_jitter_bounds[SENSOR_JITTER_BUCKETS - 1] = SENSOR_JITTER_BOUNDS_US;
+
+#define SENSOR_US_PER_TICK          (1000000U / configTICK_RATE_HZ)
+
+/* Private function prototypes -----------------------------------------------*/
+static void Sensor_Complete(uint8_t id, Sensor_Status_t status, const Sensor_Reading_t *reading);
+
+/**
+ * @brief 读取内核 tick 及其内部的微秒偏移
+ * @note  SysTick 由 FreeRTOS 使用，VAL 向下计数；两次读取 tick 排除中途进位，
+ *        计数已回绕但中断尚未处理（临界区内）时补上一个 tick
+ */
+static TickType_t Sensor_TickNow(uint32_t *sub_us) {
+    TickType_t tick;
+    uint32_t val, load = SysTick->LOAD + 1U;
+    uint8_t pending;
+
+    do {
+        tick = xTaskGetTickCount();
+        val = SysTick->VAL;
+        pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0;
+    } while (tick != xTaskGetTickCount());
+
+    if (pending && val > load / 2) {
+        tick++;
+    }
+    *sub_us = (uint32_t)(((uint64_t)(load - 1U - val) * SENSOR_US_PER_TICK) / load);
+    return tick;
+}
+
+/* 把一次启动延迟计入抖动直方图 */
+static void Sensor_RecordJitter(Sensor_Jitter_t *j, uint32_t late_us) {
+    uint8_t b = 0;
+
+    while (b < SENSOR_JITTER_BUCKETS - 1 && late_us >= g_jitter_bounds[b]) {
+        b++;
+    }
+    if (j->hist[b] < UINT16_MAX) j->hist[b]++;
+    if (late_us > j->max_us) j->max_us = late_us;
+    j->samples++;
+}
+
+/* 初始化（清空）传感器注册表 */
 bool Sensor_Init(void) {
-    printf("传感器初始化...\r\n");
+    memset(g_sensors, 0, sizeof(g_sensors));
+    g_sensor_count = 0;
+    g_sensor_listener = NULL;
+    return true;
+}
+
+/* 注册一个传感器，驱动 init 失败时不注册 */
+int Sensor_Register(const Sensor_Config_t *config) {
+    if (config == NULL || config->driver == NULL || g_sensor_count >= SENSOR_MAX_DEVICES) {
+        return -1;
+    }
+    if (config->value_count > SENSOR_MAX_VALUES) {
+        return -1;
+    }
+    if (config->driver->init != NULL && config->driver->init(config->ctx) != SENSOR_OK) {
+        return -1;
+    }
+
+    Sensor_Channel_t *ch = &g_sensors[g_sensor_count];
+    TickType_t now = xTaskGetTickCount();
+    TickType_t period = pdMS_TO_TICKS(config->period_ms);
+    TickType_t phase = pdMS_TO_TICKS(config->phase_ms);
+
+    memset(ch, 0, sizeof(*ch));
+    ch->config = config;
+    ch->state = SENSOR_STATE_IDLE;
+
+    /* 第一个采样时刻：now 之后最近的 k * period + phase */
+    if (period == 0) {
+        ch->next_due = now;
+    } else {
+        phase %= period;
+        ch->next_due = now - (now % period) + phase;
+        if ((int32_t)(ch->next_due - now) <= 0) {
+            ch->next_due += period;
+        }
+    }
+
+    return g_sensor_count++;
+}
+
+void Sensor_SetListener(Sensor_Listener_t listener) {
+    g_sensor_listener = listener;
+}
+
+/* 一次读取结束：更新最新值、推进下一次到期时间并通知监听者 */
+static void Sensor_Complete(uint8_t id, Sensor_Status_t status, const Sensor_Reading_t *reading) {
+    Sensor_Channel_t *ch = &g_sensors[id];
+
+    ch->state = SENSOR_STATE_IDLE;
+
+    /* 始终从名义时刻推进，读取耗时不会累积成相位漂移 */
+    ch->next_due = ch->slot + pdMS_TO_TICKS(ch->config->period_ms);
+
+    if (status == SENSOR_OK) {
+        taskENTER_CRITICAL();
+        ch->latest = *reading;
+        ch->valid = 1;
+        taskEXIT_CRITICAL();
+    } else {
+        ch->errors++;
+    }
+
+    if (g_sensor_listener != NULL) {
+        g_sensor_listener(id, status, status == SENSOR_OK ? reading : NULL);
+    }
+}
+
+/**
+ * @brief 执行一轮调度：对到期的传感器发起读取，对进行中的读取轮询完成状态
+ * @note  启动时刻相对名义采样时刻的延迟计入抖动直方图；错过的整周期跳过并计数，
+ *        不做补采
+ * @retval 下一次需要调度的绝对 tick
+ */
+TickType_t Sensor_Schedule(void) {
+    TickType_t wake = xTaskGetTickCount() + pdMS_TO_TICKS(SENSOR_IDLE_WAIT_MAX_MS);
 
-    /* 这里是传感器初始化代码 */
-    /* 实际项目中应替换为真实传感器的初始化代码 */
+    for (uint8_t id = 0; id < g_sensor_count; id++) {
+        Sensor_Channel_t *ch = &g_sensors[id];
+        const Sensor_Driver_t *drv = ch->config->driver;
+        TickType_t now = xTaskGetTickCount();
+        Sensor_Status_t status;
 
-    /* 模拟初始化成功 */
+        if (ch->state == SENSOR_STATE_IDLE && (int32_t)(now - ch->next_due) >= 0) {
+            TickType_t period = pdMS_TO_TICKS(ch->config->period_ms);
+            uint32_t sub_us;
+
+            /* 落后一个周期以上：跳到最近一个已过去的采样时刻 */
+            if (period != 0 && (now - ch->next_due) >= period) {
+                TickType_t skipped = (now - ch->next_due) / period;
+                ch->jitter.missed += skipped;
+                ch->next_due += skipped * period;
+            }
+            ch->slot = ch->next_due;
+
+            now = Sensor_TickNow(&sub_us);
+            Sensor_RecordJitter(&ch->jitter, (now - ch->slot) * SENSOR_US_PER_TICK + sub_us);
+            status = drv->start_read(ch->config->ctx);
+            if (status == SENSOR_OK) {
+                ch->state = SENSOR_STATE_READING;
+                ch->started = now;
+            } else {
+                Sensor_Complete(id, status, NULL);
+            }
+        }
+
+        if (ch->state == SENSOR_STATE_READING) {
+            status = drv->poll_complete(ch->config->ctx);
+            now = xTaskGetTickCount();
+
+            if (status == SENSOR_BUSY) {
+                if ((now - ch->started) >= pdMS_TO_TICKS(SENSOR_READ_TIMEOUT_MS)) {
+                    Sensor_Complete(id, SENSOR_ERROR_TIMEOUT, NULL);
+                } else if ((int32_t)(wake - now) > (int32_t)pdMS_TO_TICKS(SENSOR_POLL_INTERVAL_MS)) {
+                    wake = now + pdMS_TO_TICKS(SENSOR_POLL_INTERVAL_MS);
+                }
+            } else if (status == SENSOR_OK) {
+                Sensor_Reading_t reading = {0};
+                status = drv->decode(ch->config->ctx, &reading);
+                reading.timestamp = ch->slot;
+                Sensor_Complete(id, status, &reading);
+            } else {
+                Sensor_Complete(id, status, NULL);
+            }
+        }
+
+        if (ch->state == SENSOR_STATE_IDLE && (int32_t)(ch->next_due - wake) < 0) {
+            wake = ch->next_due;
+        }
+    }
+
+    return wake;
+}
+
+/* 读取采样抖动统计 */
+bool Sensor_GetJitter(uint8_t id, Sensor_Jitter_t *jitter) {
+    if (id >= g_sensor_count || jitter == NULL) {
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    *jitter = g_sensors[id].jitter;
+    taskEXIT_CRITICAL();
     return true;
 }
 
-/* 读取传感器数据 */
-bool Sensor_ReadData(float *temperature, float *humidity, uint16_t *pressure) {
-    if (temperature == NULL || humidity == NULL || pressure == NULL) {
+void Sensor_ResetJitter(uint8_t id) {
+    if (id < g_sensor_count) {
+        taskENTER_CRITICAL();
+        memset(&g_sensors[id].jitter, 0, sizeof(g_sensors[id].jitter));
+        taskEXIT_CRITICAL();
+    }
+}
+
+/* 微秒分辨率的单调时间，用于测量采样时刻 */
+uint64_t Sensor_TimeUs(void) {
+    uint32_t sub_us;
+    TickType_t tick = Sensor_TickNow(&sub_us);
+    return (uint64_t)tick * SENSOR_US_PER_TICK + sub_us;
+}
+
+uint8_t Sensor_Count(void) {
+    return g_sensor_count;
+}
+
+const Sensor_Config_t *Sensor_GetConfig(uint8_t id) {
+    return id < g_sensor_count ? g_sensors[id].config : NULL;
+}
+
+/* 读取最近一次有效数据 */
+bool Sensor_GetLatest(uint8_t id, Sensor_Reading_t *reading) {
+    bool valid = false;
+
+    if (id >= g_sensor_count || reading == NULL) {
         return false;
     }
 
-    /* 这里是读取传感器数据的代码 */
-    /* 实际项目中应替换为真实传感器的读取代码 */
+    taskENTER_CRITICAL();
+    if (g_sensors[id].valid) {
+        *reading = g_sensors[id].latest;
+        valid = true;
+    }
+    taskEXIT_CRITICAL();
 
-    /* 模拟传感器数据 */
-    *temperature = 25.5 + (float)(rand() % 100) / 10.0;  // 25.5~35.4°C
-    *humidity = 40.0 + (float)(rand() % 300) / 10.0;   // 40.0~69.9%
-    *pressure = 1013 + (rand() % 20);                // 1013~1033 hPa
+    return valid;
+}
 
-    printf("读取传感器数据 - 温度: %.1f°C, 湿度: %.1f%%, 气压: %u hPa\r\n",
-           *temperature, *humidity, *pressure);
+/**
+ * @brief 按 decimals 位小数格式化一个定点数值
+ * @retval 写入的字符数（被截断时为 0）
+ */
+int Sensor_FormatValue(char *buf, size_t size, int32_t value, uint8_t decimals) {
+    uint32_t mag = value < 0 ? 0U - (uint32_t)value : (uint32_t)value;     // INT32_MIN 取负会溢出
+    int n;
 
-    return true;
-}
\ No newline at end of file
+    if (decimals == 0 || decimals >= sizeof(g_pow10) / sizeof(g_pow10[0])) {
+        n = snprintf(buf, size, "%ld", (long)value);
+    } else {
+        uint32_t div = (uint32_t)g_pow10[decimals];
+        n = snprintf(buf, size, "%s%lu.%0*lu", value < 0 ? "-" : "",
+                     (unsigned long)(mag / div), (int)decimals, (unsigned long)(mag % div));
+    }
+
+    if (n < 0 || (size_t)n >= size) {
+        if (size) buf[0] = '\0';
+        return 0;
+    }
+    return n;
+}
+
+/**
+ * @brief 把所有传感器的最新有效数据格式化为 "name":value,... 列表（无外层花括号）
+ * @note  放不下的字段整体丢弃，不会输出半截 JSON
+ * @retval 写入的字符数
+ */
+int Sensor_FormatJson(char *buf, size_t size) {
+    size_t len = 0;
+
+    if (buf == NULL || size == 0) {
+        return 0;
+    }
+    buf[0] = '\0';
+
+    for (uint8_t id = 0; id < g_sensor_count; id++) {
+        const Sensor_Config_t *cfg = g_sensors[id].config;
+        Sensor_Reading_t reading;
+
+        if (!Sensor_GetLatest(id, &reading)) {
+            continue;
+        }
+
+        for (uint8_t i = 0; i < cfg->value_count && i < reading.count; i++) {
+            const Sensor_ValueDesc_t *desc = &cfg->values[i];
+            int n = snprintf(buf + len, size - len, "%s\"%s\":", len ? "," : "", desc->name);
+            int v = 0;
+
+            if (n > 0 && (size_t)n < size - len) {
+                v = Sensor_FormatValue(buf + len + n, size - len - n, reading.value[i], desc->decimals);
+            }
+            if (v == 0) {
+                buf[len] = '\0';
+                return (int)len;
+            }
+            len += (size_t)(n + v);
+        }
+    }
+
+    return (int)len;
+}
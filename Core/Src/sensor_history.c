@@ -0,0 +1,147 @@
+/*
+================================================================================
+sensor_history.c - 传感器历史环形缓冲实现文件
+================================================================================
+时间轴按 HISTORY_BUCKET_MS 划分为固定的桶（桶序号 = 时间戳 / 桶长），每个通道
+只保存最近 HISTORY_BUCKETS 个桶的 min/max（int8），全部通道共用一张静态表，
+RAM 占用在编译期检查不超过 256 字节。写入方为传感器调度任务，读取方为
+OLED 任务，两边都只在临界区内做几十字节以内的拷贝/更新。
+*/
+#include "sensor_history.h"
+#include "config.h"
+#include "task.h"
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint8_t          used;
+    uint8_t          sensor_id;
+    uint8_t          value_index;
+    uint8_t          head;                      // 最新桶在 bucket[] 中的位置
+    int32_t          divisor;                   // 10^decimals
+    uint32_t         head_seq;                  // 最新桶的序号
+    History_Bucket_t bucket[HISTORY_BUCKETS];
+} History_Channel_t;
+
+/* Private variables ---------------------------------------------------------*/
+static History_Channel_t g_history_channels[HISTORY_MAX_CHANNELS];
+
+_Static_assert(sizeof(g_history_channels) <= 256, "sensor history must stay under 256 bytes of RAM");
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t History_Seq(TickType_t t)
+{
+    return (uint32_t)(t / pdMS_TO_TICKS(HISTORY_BUCKET_MS));
+}
+
+static void History_ClearBucket(History_Bucket_t *b)
+{
+    b->min = INT8_MAX;
+    b->max = INT8_MIN;
+}
+
+/* 定点读数四舍五入到整数并限幅到 int8 */
+static int8_t History_Scale(int32_t v, int32_t divisor)
+{
+    v = (v >= 0 ? v + divisor / 2 : v - divisor / 2) / divisor;
+    if (v > INT8_MAX) v = INT8_MAX;
+    if (v < INT8_MIN) v = INT8_MIN;
+    return (int8_t)v;
+}
+
+/* Public functions ----------------------------------------------------------*/
+int History_AddChannel(uint8_t sensor_id, uint8_t value_index)
+{
+    const Sensor_Config_t *cfg = Sensor_GetConfig(sensor_id);
+    History_Channel_t *ch;
+
+    if (cfg == NULL || value_index >= cfg->value_count) {
+        return -1;
+    }
+
+    for (int i = 0; i < HISTORY_MAX_CHANNELS; i++) {
+        ch = &g_history_channels[i];
+        if (ch->used) {
+            continue;
+        }
+
+        ch->sensor_id = sensor_id;
+        ch->value_index = value_index;
+        ch->head = 0;
+        ch->head_seq = 0;
+        ch->divisor = 1;
+        for (uint8_t d = 0; d < cfg->values[value_index].decimals; d++) {
+            ch->divisor *= 10;
+        }
+        for (uint8_t b = 0; b < HISTORY_BUCKETS; b++) {
+            History_ClearBucket(&ch->bucket[b]);
+        }
+        ch->used = 1;
+        return i;
+    }
+    return -1;
+}
+
+void History_Update(uint8_t sensor_id, const Sensor_Reading_t *reading)
+{
+    uint32_t seq = History_Seq(reading->timestamp);
+
+    for (uint8_t i = 0; i < HISTORY_MAX_CHANNELS; i++) {
+        History_Channel_t *ch = &g_history_channels[i];
+        History_Bucket_t *b;
+        int8_t v;
+
+        if (!ch->used || ch->sensor_id != sensor_id || ch->value_index >= reading->count) {
+            continue;
+        }
+        v = History_Scale(reading->value[ch->value_index], ch->divisor);
+
+        taskENTER_CRITICAL();
+        if (seq > ch->head_seq) {
+            /* 前进到新桶，中间没有读数的桶清空（最多清一圈） */
+            uint32_t skip = seq - ch->head_seq;
+            if (skip > HISTORY_BUCKETS) {
+                skip = HISTORY_BUCKETS;
+            }
+            while (skip--) {
+                ch->head = (uint8_t)((ch->head + 1) % HISTORY_BUCKETS);
+                History_ClearBucket(&ch->bucket[ch->head]);
+            }
+            ch->head_seq = seq;
+        } else if (ch->head_seq - seq >= HISTORY_BUCKETS) {
+            taskEXIT_CRITICAL();
+            continue;               // 比环里最旧的桶还早
+        }
+
+        b = &ch->bucket[(ch->head + HISTORY_BUCKETS - (ch->head_seq - seq)) % HISTORY_BUCKETS];
+        if (v < b->min) b->min = v;
+        if (v > b->max) b->max = v;
+        taskEXIT_CRITICAL();
+    }
+}
+
+uint8_t History_Read(int channel, History_Bucket_t *out, uint8_t n)
+{
+    const History_Channel_t *ch;
+    uint32_t now;
+
+    if (channel < 0 || channel >= HISTORY_MAX_CHANNELS || !g_history_channels[channel].used || n == 0) {
+        return 0;
+    }
+    ch = &g_history_channels[channel];
+    now = History_Seq(xTaskGetTickCount());
+
+    taskENTER_CRITICAL();
+    for (uint8_t k = 0; k < n; k++) {
+        /* out[k] 对应桶序号 now - (n - 1 - k)；传感器停报时旧数据照样向左移出 */
+        uint32_t seq = now - (n - 1 - k);
+
+        if (seq > ch->head_seq || ch->head_seq - seq >= HISTORY_BUCKETS) {
+            History_ClearBucket(&out[k]);
+        } else {
+            out[k] = ch->bucket[(ch->head + HISTORY_BUCKETS - (ch->head_seq - seq)) % HISTORY_BUCKETS];
+        }
+    }
+    taskEXIT_CRITICAL();
+    return n;
+}
@@ -0,0 +1,201 @@
+/*
+================================================================================
+sensor_stats.c - 传感器滚动窗口统计实现文件
+================================================================================
+每个 (通道, 窗口) 只保存 count/min/max/sum/sumsq，内存与窗口长度无关。
+累加前先减去窗口内第一个样本（偏移量），使 sum/sumsq 保持较小并避免
+大数相减带来的精度损失；全部为整数运算，不使用 FPU。
+*/
+#include "sensor_stats.h"
+#include "rtos_objects.h"
+#include "metrics.h"
+#include "cmsis_os2.h"
+#include "task.h"
+#include "stdio.h"
+#include <string.h>
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    TickType_t start;
+    uint16_t   count;
+    int32_t    offset;
+    int32_t    min;
+    int32_t    max;
+    int64_t    sum;
+    int64_t    sumsq;
+} Stats_Accum_t;
+
+typedef struct {
+    uint8_t       used;
+    uint8_t       sensor_id;
+    uint8_t       value_index;
+    Stats_Accum_t acc[STATS_MAX_WINDOWS];
+} Stats_Channel_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const Stats_Window_t *g_stats_windows = NULL;
+static uint8_t g_stats_window_count = 0;
+static Stats_Channel_t g_stats_channels[STATS_MAX_CHANNELS];
+static osMessageQueueId_t statsQueueHandle = NULL;
+
+/* Private functions ---------------------------------------------------------*/
+static uint32_t Stats_Isqrt(uint64_t x)
+{
+    uint64_t res = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > x) bit >>= 2;
+    while (bit != 0) {
+        if (x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+static Stats_Channel_t *Stats_FindChannel(uint8_t sensor_id, uint8_t value_index)
+{
+    Stats_Channel_t *free_slot = NULL;
+
+    for (uint8_t i = 0; i < STATS_MAX_CHANNELS; i++) {
+        Stats_Channel_t *ch = &g_stats_channels[i];
+        if (ch->used && ch->sensor_id == sensor_id && ch->value_index == value_index) {
+            return ch;
+        }
+        if (!ch->used && free_slot == NULL) {
+            free_slot = ch;
+        }
+    }
+
+    if (free_slot != NULL) {
+        memset(free_slot, 0, sizeof(*free_slot));
+        free_slot->used = 1;
+        free_slot->sensor_id = sensor_id;
+        free_slot->value_index = value_index;
+    }
+    return free_slot;
+}
+
+/* 关闭窗口：计算聚合值并放入待发布队列 */
+static void Stats_Close(const Stats_Channel_t *ch, uint8_t w, const Stats_Accum_t *acc)
+{
+    Stats_Aggregate_t agg;
+    int64_t n = acc->count;
+    int64_t var_n2;
+
+    agg.sensor_id = ch->sensor_id;
+    agg.value_index = ch->value_index;
+    agg.window = w;
+    agg.count = acc->count;
+    agg.min = acc->min;
+    agg.max = acc->max;
+    agg.start = acc->start;
+
+    /* 四舍五入的均值；方差 = (n*sumsq - sum^2) / n^2 */
+    agg.mean = acc->offset + (int32_t)((acc->sum * 2 + (acc->sum >= 0 ? n : -n)) / (2 * n));
+    var_n2 = n * acc->sumsq - acc->sum * acc->sum;
+    agg.stddev = var_n2 > 0 ? (int32_t)(Stats_Isqrt((uint64_t)var_n2) / (uint32_t)n) : 0;
+
+    if (osMessageQueuePut(statsQueueHandle, &agg, 0, 0) != osOK) {
+        Metric_Inc(METRIC_COUNTER_stats_dropped);
+    }
+}
+
+/* Public functions ----------------------------------------------------------*/
+void Stats_Init(const Stats_Window_t *windows, uint8_t window_count)
+{
+    if (window_count > STATS_MAX_WINDOWS) {
+        window_count = STATS_MAX_WINDOWS;
+    }
+
+    memset(g_stats_channels, 0, sizeof(g_stats_channels));
+    g_stats_windows = windows;
+    g_stats_window_count = window_count;
+
+    if (statsQueueHandle == NULL) {
+        statsQueueHandle = Rtos_QueueNew(RTOS_QUEUE_statsQueue);
+    }
+}
+
+void Stats_Update(uint8_t sensor_id, const Sensor_Reading_t *reading)
+{
+    TickType_t now = reading->timestamp;
+
+    for (uint8_t i = 0; i < reading->count; i++) {
+        Stats_Channel_t *ch = Stats_FindChannel(sensor_id, i);
+        int32_t v = reading->value[i];
+
+        if (ch == NULL) {
+            return;
+        }
+
+        for (uint8_t w = 0; w < g_stats_window_count; w++) {
+            Stats_Accum_t *acc = &ch->acc[w];
+            TickType_t length = pdMS_TO_TICKS(g_stats_windows[w].length_ms);
+            int64_t d;
+
+            if (acc->count != 0 && (now - acc->start) >= length) {
+                Stats_Close(ch, w, acc);
+                /* 新窗口按窗口长度对齐，保持固定相位 */
+                acc->start += ((now - acc->start) / length) * length;
+                acc->count = 0;
+            }
+
+            if (acc->count == 0) {
+                if (acc->start == 0) {
+                    acc->start = now;
+                }
+                acc->offset = v;
+                acc->min = v;
+                acc->max = v;
+                acc->sum = 0;
+                acc->sumsq = 0;
+            }
+
+            d = (int64_t)v - acc->offset;
+            if (v < acc->min) acc->min = v;
+            if (v > acc->max) acc->max = v;
+            acc->sum += d;
+            acc->sumsq += d * d;
+            if (acc->count < UINT16_MAX) acc->count++;
+        }
+    }
+}
+
+bool Stats_GetClosed(Stats_Aggregate_t *agg, uint32_t timeout)
+{
+    if (statsQueueHandle == NULL) {
+        return false;
+    }
+    return osMessageQueueGet(statsQueueHandle, agg, NULL, timeout) == osOK;
+}
+
+int Stats_FormatJson(const Stats_Aggregate_t *agg, char *buf, size_t size)
+{
+    const Sensor_Config_t *cfg = Sensor_GetConfig(agg->sensor_id);
+    const Sensor_ValueDesc_t *desc;
+    char min[16], max[16], mean[16], stddev[16];
+    int n;
+
+    if (cfg == NULL || agg->value_index >= cfg->value_count || agg->window >= g_stats_window_count) {
+        return 0;
+    }
+    desc = &cfg->values[agg->value_index];
+
+    Sensor_FormatValue(min, sizeof(min), agg->min, desc->decimals);
+    Sensor_FormatValue(max, sizeof(max), agg->max, desc->decimals);
+    Sensor_FormatValue(mean, sizeof(mean), agg->mean, desc->decimals);
+    Sensor_FormatValue(stddev, sizeof(stddev), agg->stddev, desc->decimals);
+
+    n = snprintf(buf, size,
+                 "{\"start\":%lu,\"window\":\"%s\",\"name\":\"%s\",\"n\":%u,"
+                 "\"min\":%s,\"max\":%s,\"mean\":%s,\"std\":%s}",
+                 (unsigned long)agg->start, g_stats_windows[agg->window].name, desc->name,
+                 (unsigned)agg->count, min, max, mean, stddev);
+
+    return (n < 0 || (size_t)n >= size) ? 0 : n;
+}
@@ -1,12 +1,34 @@
 
 /*=================================================================
- * 文件: soft_i2c.c
- * 描述: 模拟I2C实现文件
+ * 文件: soft_i2c.cpp
+ * 描述: 模拟I2C实现文件（引脚操作使用 gpio_pin.hpp 的 Pin<> 模板）
  * 作者: 开发者
  * 日期: 2025
  *=================================================================*/
 
 #include "soft_i2c.h"
+#include "gpio_pin.hpp"
+
+/* 引脚：端口和引脚都取自 soft_i2c.h，与 HAL_GPIO_Init 配置的是同一对引脚 */
+using I2C_SCL = Pin<I2C_SCL_GPIO_BASE, pin_index(I2C_SCL_Pin)>;
+using I2C_SDA = Pin<I2C_SDA_GPIO_BASE, pin_index(I2C_SDA_Pin)>;
+
+/* GPIO操作宏：每个都内联为一条 BSRR/BRR/IDR 访问 */
+#define SCL_H()     I2C_SCL::high()
+#define SCL_L()     I2C_SCL::low()
+#define SDA_H()     I2C_SDA::high()
+#define SDA_L()     I2C_SDA::low()
+#define READ_SDA()  I2C_SDA::read()
+
+#ifdef SOFT_I2C_PROFILE
+static I2C_Profile_t g_i2c_profile;
+#define PROFILE_BEGIN()     uint32_t prof_start = DWT->CYCCNT
+#define PROFILE_END(nbits)  do { g_i2c_profile.cycles += DWT->CYCCNT - prof_start; \
+                                 g_i2c_profile.bits += (nbits); } while(0)
+#else
+#define PROFILE_BEGIN()     do { } while(0)
+#define PROFILE_END(nbits)  do { } while(0)
+#endif
 
 /**
  * @brief  微秒延时函数
@@ -15,40 +37,38 @@
  */
 static void I2C_Delay_us(uint32_t us)
 {
+#ifdef SOFT_I2C_PROFILE
+    uint32_t start = DWT->CYCCNT;
+#endif
     uint32_t delay = us * (SystemCoreClock / 1000000U) / 2U;
     while(delay--)
     {
         __NOP();
     }
+#ifdef SOFT_I2C_PROFILE
+    g_i2c_profile.delay_cycles += DWT->CYCCNT - start;
+#endif
 }
 
 /**
- * @brief  设置SDA为输出模式
+ * @brief  设置SDA为输出模式（开漏，只改写 CRL 中 SDA 的 4 位）
+ * @note   开漏输出高即释放总线：第 8 个时钟后从机拉低应答时不会与主机推挽的高电平冲突
  * @param  None
  * @retval None
  */
-static void SDA_OUT(void)
+static inline void SDA_OUT(void)
 {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-    GPIO_InitStruct.Pin = I2C_SDA_Pin;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
-    GPIO_InitStruct.Pull = GPIO_NOPULL;
-    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
-    HAL_GPIO_Init(I2C_SDA_GPIO_Port, &GPIO_InitStruct);
+    I2C_SDA::output_od();
 }
 
 /**
- * @brief  设置SDA为输入模式
+ * @brief  设置SDA为输入模式（上拉输入）
  * @param  None
  * @retval None
  */
-static void SDA_IN(void)
+static inline void SDA_IN(void)
 {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
-    GPIO_InitStruct.Pin = I2C_SDA_Pin;
-    GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
-    GPIO_InitStruct.Pull = GPIO_PULLUP;
-    HAL_GPIO_Init(I2C_SDA_GPIO_Port, &GPIO_InitStruct);
+    I2C_SDA::input_pullup();
 }
 
 /**
@@ -58,7 +78,7 @@ static void SDA_IN(void)
  */
 void Soft_I2C_Init(void)
 {
-    GPIO_InitTypeDef GPIO_InitStruct = {0};
+    GPIO_InitTypeDef GPIO_InitStruct = {};
 
     /* 使能GPIOB时钟 */
     __HAL_RCC_GPIOB_CLK_ENABLE();
@@ -70,9 +90,9 @@ void Soft_I2C_Init(void)
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
     HAL_GPIO_Init(I2C_SCL_GPIO_Port, &GPIO_InitStruct);
 
-    /* 配置SDA引脚为推挽输出（初始状态） */
+    /* 配置SDA引脚为开漏输出（初始状态），依赖总线上拉 */
     GPIO_InitStruct.Pin = I2C_SDA_Pin;
-    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
     GPIO_InitStruct.Pull = GPIO_NOPULL;
     GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
     HAL_GPIO_Init(I2C_SDA_GPIO_Port, &GPIO_InitStruct);
@@ -80,6 +100,11 @@ void Soft_I2C_Init(void)
     /* 初始状态：SCL和SDA都为高电平 */
     SCL_H();
     SDA_H();
+
+#ifdef SOFT_I2C_PROFILE
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 }
 
 /**
@@ -123,6 +148,7 @@ void I2C_Stop(void)
 uint8_t I2C_Wait_Ack(void)
 {
     uint8_t ucErrTime = 0;
+    PROFILE_BEGIN();
     SDA_IN();       /* SDA设为输入模式 */
     SDA_H();
     I2C_Delay_us(1);
@@ -139,6 +165,7 @@ uint8_t I2C_Wait_Ack(void)
         }
     }
     SCL_L();
+    PROFILE_END(1);
     return 0;   /* 有应答 */
 }
 
@@ -182,6 +209,7 @@ void I2C_NAck(void)
 void I2C_Send_Byte(uint8_t data)
 {
     uint8_t t;
+    PROFILE_BEGIN();
     SDA_OUT();
     SCL_L();    /* 拉低时钟开始数据传输 */
 
@@ -198,6 +226,7 @@ void I2C_Send_Byte(uint8_t data)
         SCL_L();
         I2C_Delay_us(2);
     }
+    PROFILE_END(8);
 }
 
 /**
@@ -223,6 +252,47 @@ uint8_t I2C_Read_Byte(void)
     return receive;
 }
 
+/**
+ * @brief  连续写：一次起始/地址/控制字节之后发送任意长度的数据流
+ * @param  addr: 设备地址（8位，含写位）
+ * @param  control: 控制字节（SSD1306: 0x00 命令流, 0x40 显存数据流）
+ * @param  buf: 待发送数据
+ * @param  len: 数据长度
+ * @retval 0: 成功, 1: 无应答（已发送停止信号）
+ */
+uint8_t I2C_Write_Buffer(uint8_t addr, uint8_t control, const uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+
+    I2C_Start();
+    I2C_Send_Byte(addr);            /* 发送设备地址 */
+    if(I2C_Wait_Ack())
+        return 1;
+    I2C_Send_Byte(control);         /* 控制字节 */
+    if(I2C_Wait_Ack())
+        return 1;
+    for(i = 0; i < len; i++)
+    {
+        I2C_Send_Byte(buf[i]);
+        if(I2C_Wait_Ack())
+            return 1;
+    }
+    I2C_Stop();
+    return 0;
+}
+
+/**
+ * @brief  在一个事务中连续写入多条命令（含命令参数）
+ * @param  addr: 设备地址（8位，含写位）
+ * @param  cmds: 命令列表
+ * @param  len: 命令字节数
+ * @retval 0: 成功, 1: 无应答
+ */
+uint8_t I2C_Write_CmdList(uint8_t addr, const uint8_t *cmds, uint16_t len)
+{
+    return I2C_Write_Buffer(addr, OLED_CONTROL_CMD, cmds, len);
+}
+
 /**
  * @brief  OLED写命令
  * @param  cmd: 命令字节
@@ -230,14 +300,7 @@ uint8_t I2C_Read_Byte(void)
  */
 void OLED_Write_Cmd(uint8_t cmd)
 {
-    I2C_Start();
-    I2C_Send_Byte(OLED_ADDRESS);    /* 发送设备地址 */
-    I2C_Wait_Ack();
-    I2C_Send_Byte(0x00);            /* 写命令 */
-    I2C_Wait_Ack();
-    I2C_Send_Byte(cmd);
-    I2C_Wait_Ack();
-    I2C_Stop();
+    (void)I2C_Write_Buffer(OLED_ADDRESS, OLED_CONTROL_CMD, &cmd, 1);
 }
 
 /**
@@ -247,12 +310,24 @@ void OLED_Write_Cmd(uint8_t cmd)
  */
 void OLED_Write_Data(uint8_t data)
 {
-    I2C_Start();
-    I2C_Send_Byte(OLED_ADDRESS);    /* 发送设备地址 */
-    I2C_Wait_Ack();
-    I2C_Send_Byte(0x40);            /* 写数据 */
-    I2C_Wait_Ack();
-    I2C_Send_Byte(data);
-    I2C_Wait_Ack();
-    I2C_Stop();
-}
\ No newline at end of file
+    (void)I2C_Write_Buffer(OLED_ADDRESS, OLED_CONTROL_DATA, &data, 1);
+}
+
+#ifdef SOFT_I2C_PROFILE
+/**
+ * @brief  读取发送路径的周期统计
+ * @param  profile: 输出
+ * @param  reset: 非0时读取后清零
+ * @retval None
+ */
+void I2C_GetProfile(I2C_Profile_t *profile, uint8_t reset)
+{
+    __disable_irq();
+    *profile = g_i2c_profile;
+    if(reset)
+    {
+        g_i2c_profile = I2C_Profile_t{};
+    }
+    __enable_irq();
+}
+#endif
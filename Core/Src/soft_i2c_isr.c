@@ -0,0 +1,262 @@
+/*=================================================================
+ * 文件: soft_i2c_isr.c
+ * 描述: 定时器中断驱动的后台模拟I2C实现文件
+ * 作者: 开发者
+ * 日期: 2025
+ *
+ * 每次 TIM4 更新中断只推进半个位（改变 SCL 或 SDA 一次），调用者提交
+ * 描述符链后立即返回；中断之间 CPU 可以运行其它任务。
+ * SDA 使用开漏输出，释放后可直接读 IDR 得到 ACK，不需要切换方向。
+ *=================================================================*/
+
+#include "soft_i2c_isr.h"
+
+/* 直接写 BSRR/BRR，中断内不走 HAL */
+#define ISR_SCL_H()     (I2C_SCL_GPIO_Port->BSRR = I2C_SCL_Pin)
+#define ISR_SCL_L()     (I2C_SCL_GPIO_Port->BRR  = I2C_SCL_Pin)
+#define ISR_SDA_H()     (I2C_SDA_GPIO_Port->BSRR = I2C_SDA_Pin)
+#define ISR_SDA_L()     (I2C_SDA_GPIO_Port->BRR  = I2C_SDA_Pin)
+#define ISR_READ_SDA()  ((I2C_SDA_GPIO_Port->IDR & I2C_SDA_Pin) != 0)
+
+/* 半位状态 */
+typedef enum {
+    PH_IDLE = 0,
+    PH_START_A,     /* SCL、SDA 释放为高 */
+    PH_START_B,     /* SCL 高时 SDA 拉低：起始 */
+    PH_BIT_LOW,     /* SCL 拉低，放置下一位 */
+    PH_BIT_HIGH,    /* SCL 拉高，从机采样 */
+    PH_ACK_LOW,     /* SCL 拉低，释放 SDA */
+    PH_ACK_HIGH,    /* SCL 拉高 */
+    PH_ACK_SAMPLE,  /* 读 ACK，SCL 拉低并放置下一位或准备停止 */
+    PH_STOP_A,      /* SCL 拉高 */
+    PH_STOP_B       /* SCL 高时 SDA 拉高：停止 */
+} I2C_ISR_Phase_t;
+
+static volatile I2C_ISR_Phase_t g_phase = PH_IDLE;
+static const I2C_ISR_Xfer_t *g_xfer;
+static uint16_t g_index;        /* 0 = 地址, 1 = 控制字节, 2.. = data[index - 2] */
+static uint8_t  g_byte;
+static uint8_t  g_bit;
+static I2C_ISR_Status_t g_status;
+static I2C_ISR_Callback_t g_done;
+static void *g_done_arg;
+static uint32_t g_busy_start;
+static I2C_ISR_Stats_t g_stats;
+
+/**
+ * @brief  当前事务第 index 个字节
+ */
+static uint8_t I2C_ISR_Byte(uint16_t index)
+{
+    if(index == 0) return g_xfer->addr;
+    if(index == 1) return g_xfer->control;
+    return g_xfer->data[index - 2];
+}
+
+/**
+ * @brief  初始化引脚、DWT 与 TIM4（定时器只在传输期间运行）
+ * @param  None
+ * @retval None
+ */
+void I2C_ISR_Init(void)
+{
+    GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_TIM4_CLK_ENABLE();
+
+    /* SCL 推挽（SSD1306 不拉伸时钟），SDA 开漏 */
+    ISR_SCL_H();
+    ISR_SDA_H();
+    GPIO_InitStruct.Pin = I2C_SCL_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+    GPIO_InitStruct.Pull = GPIO_NOPULL;
+    GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(I2C_SCL_GPIO_Port, &GPIO_InitStruct);
+    GPIO_InitStruct.Pin = I2C_SDA_Pin;
+    GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+    GPIO_InitStruct.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init(I2C_SDA_GPIO_Port, &GPIO_InitStruct);
+
+    /* DWT 周期计数器，用于统计中断占用 */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* TIM4：72 MHz 计数，每 1/I2C_ISR_TICK_HZ 一次更新中断 */
+    I2C_ISR_TIM->CR1 = 0;
+    I2C_ISR_TIM->PSC = 0;
+    I2C_ISR_TIM->ARR = SystemCoreClock / I2C_ISR_TICK_HZ - 1U;
+    I2C_ISR_TIM->EGR = TIM_EGR_UG;
+    I2C_ISR_TIM->SR = 0;
+    I2C_ISR_TIM->DIER = TIM_DIER_UIE;
+
+    HAL_NVIC_SetPriority(I2C_ISR_TIM_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C_ISR_TIM_IRQn);
+
+    g_phase = PH_IDLE;
+}
+
+/**
+ * @brief  提交一条描述符链并立即返回
+ * @param  chain: 描述符链，完成回调之前必须保持有效
+ * @param  done: 完成回调（中断上下文），可为 NULL
+ * @param  arg: 回调参数
+ * @retval I2C_ISR_OK: 已开始, I2C_ISR_BUSY: 上一条链尚未完成
+ */
+I2C_ISR_Status_t I2C_ISR_Submit(const I2C_ISR_Xfer_t *chain, I2C_ISR_Callback_t done, void *arg)
+{
+    if(chain == NULL)
+        return I2C_ISR_OK;
+    if(g_phase != PH_IDLE)
+        return I2C_ISR_BUSY;
+
+    g_xfer = chain;
+    g_done = done;
+    g_done_arg = arg;
+    g_status = I2C_ISR_OK;
+    g_busy_start = DWT->CYCCNT;
+    g_phase = PH_START_A;
+
+    I2C_ISR_TIM->CNT = 0;
+    I2C_ISR_TIM->CR1 |= TIM_CR1_CEN;
+    return I2C_ISR_OK;
+}
+
+bool I2C_ISR_Busy(void)
+{
+    return g_phase != PH_IDLE;
+}
+
+/**
+ * @brief  读取统计
+ * @param  stats: 输出
+ * @param  reset: 读取后清零
+ * @retval None
+ */
+void I2C_ISR_GetStats(I2C_ISR_Stats_t *stats, bool reset)
+{
+    HAL_NVIC_DisableIRQ(I2C_ISR_TIM_IRQn);
+    *stats = g_stats;
+    if(reset)
+    {
+        g_stats.transfers = 0;
+        g_stats.bytes = 0;
+        g_stats.nacks = 0;
+        g_stats.isr_cycles = 0;
+        g_stats.busy_cycles = 0;
+    }
+    HAL_NVIC_EnableIRQ(I2C_ISR_TIM_IRQn);
+}
+
+/**
+ * @brief  当前事务结束：进入下一个描述符或结束整条链
+ */
+static void I2C_ISR_NextXfer(void)
+{
+    g_stats.transfers++;
+    if(g_status == I2C_ISR_OK && g_xfer->next != NULL)
+    {
+        g_xfer = g_xfer->next;
+        g_phase = PH_START_A;
+        return;
+    }
+
+    I2C_ISR_TIM->CR1 &= ~TIM_CR1_CEN;
+    g_phase = PH_IDLE;
+    g_stats.busy_cycles += DWT->CYCCNT - g_busy_start;
+    if(g_done != NULL)
+        g_done(g_status, g_done_arg);
+}
+
+/**
+ * @brief  TIM4 更新中断：推进半个位
+ * @param  None
+ * @retval None
+ */
+void I2C_ISR_TIM_IRQHandler(void)
+{
+    uint32_t t0 = DWT->CYCCNT;
+
+    I2C_ISR_TIM->SR = ~TIM_SR_UIF;
+
+    switch(g_phase)
+    {
+    case PH_START_A:
+        ISR_SDA_H();
+        ISR_SCL_H();
+        g_index = 0;
+        g_phase = PH_START_B;
+        break;
+
+    case PH_START_B:
+        ISR_SDA_L();
+        g_byte = I2C_ISR_Byte(0);
+        g_bit = 8;
+        g_phase = PH_BIT_LOW;
+        break;
+
+    case PH_BIT_LOW:
+        ISR_SCL_L();
+        g_bit--;
+        if(g_byte & (1U << g_bit)) ISR_SDA_H(); else ISR_SDA_L();
+        g_phase = PH_BIT_HIGH;
+        break;
+
+    case PH_BIT_HIGH:
+        ISR_SCL_H();
+        g_phase = g_bit ? PH_BIT_LOW : PH_ACK_LOW;
+        break;
+
+    case PH_ACK_LOW:
+        ISR_SCL_L();
+        ISR_SDA_H();
+        g_phase = PH_ACK_HIGH;
+        break;
+
+    case PH_ACK_HIGH:
+        ISR_SCL_H();
+        g_phase = PH_ACK_SAMPLE;
+        break;
+
+    case PH_ACK_SAMPLE:
+        if(ISR_READ_SDA())
+        {
+            g_status = I2C_ISR_NACK;
+            g_stats.nacks++;
+        }
+        else
+        {
+            g_stats.bytes++;
+        }
+        ISR_SCL_L();
+        if(g_status == I2C_ISR_OK && ++g_index < 2U + g_xfer->len)
+        {
+            g_byte = I2C_ISR_Byte(g_index);
+            g_bit = 7;
+            if(g_byte & 0x80) ISR_SDA_H(); else ISR_SDA_L();
+            g_phase = PH_BIT_HIGH;
+        }
+        else
+        {
+            ISR_SDA_L();
+            g_phase = PH_STOP_A;
+        }
+        break;
+
+    case PH_STOP_A:
+        ISR_SCL_H();
+        g_phase = PH_STOP_B;
+        break;
+
+    case PH_STOP_B:
+        ISR_SDA_H();
+        I2C_ISR_NextXfer();
+        break;
+
+    default:
+        I2C_ISR_TIM->CR1 &= ~TIM_CR1_CEN;
+        break;
+    }
+
+    g_stats.isr_cycles += DWT->CYCCNT - t0;
+}
@@ -24,6 +24,14 @@
 #include "task.h"
 #include "uart.h"
 #include "my_printf.h"
+#include "config.h"
+#include "cpu_stats.h"
+#include "console.h"
+#if OLED_TRANSPORT == OLED_TRANSPORT_HW
+#include "oled_i2c_dma.h"
+#elif OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+#include "soft_i2c_isr.h"
+#endif
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 /* USER CODE END Includes */
@@ -192,11 +200,11 @@ void DebugMon_Handler(void)
 void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART1_IRQn 0 */
-
+  CpuStats_IsrEnter();
   /* USER CODE END USART1_IRQn 0 */
   HAL_UART_IRQHandler(&huart1);
   /* USER CODE BEGIN USART1_IRQn 1 */
-
+  CpuStats_IsrExit();
   /* USER CODE END USART1_IRQn 1 */
 }
 
@@ -207,7 +215,7 @@ extern void HAL_UART_IRQHandler_Custom(UART_HandleTypeDef *huart);
 void USART2_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_IRQn 0 */
-//
+  CpuStats_IsrEnter();
   /* USER CODE END USART2_IRQn 0 */
   //HAL_UART_IRQHandler(&huart2);
   /* USER CODE BEGIN USART2_IRQn 1 */
@@ -217,6 +225,7 @@ void USART2_IRQHandler(void)
 
     // 调用HAL库的标准中断处理函数
     HAL_UART_IRQHandler(&huart2);
+    CpuStats_IsrExit();
   /* USER CODE END USART2_IRQn 1 */
 }
 
@@ -231,7 +240,9 @@ void USART2_IRQHandler(void)
 extern DMA_HandleTypeDef hdma_usart2_rx;
 void DMA1_Channel6_IRQHandler(void)
 {
+    CpuStats_IsrEnter();
     HAL_DMA_IRQHandler(&hdma_usart2_rx);
+    CpuStats_IsrExit();
 }
 
 /**
@@ -240,5 +251,72 @@ void DMA1_Channel6_IRQHandler(void)
 extern DMA_HandleTypeDef hdma_usart2_tx;
 void DMA1_Channel7_IRQHandler(void)
 {
+    CpuStats_IsrEnter();
     HAL_DMA_IRQHandler(&hdma_usart2_tx);
+    CpuStats_IsrExit();
+}
+
+/**
+  * @brief  DMA1 Channel1中断处理函数 (ADC1)
+  */
+extern DMA_HandleTypeDef hdma_adc1;
+void DMA1_Channel1_IRQHandler(void)
+{
+    CpuStats_IsrEnter();
+    HAL_DMA_IRQHandler(&hdma_adc1);
+    CpuStats_IsrExit();
+}
+
+#if OLED_TRANSPORT == OLED_TRANSPORT_HW
+/**
+  * @brief  DMA1 Channel4中断处理函数 (I2C2 TX, OLED)
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+    CpuStats_IsrEnter();
+    HAL_DMA_IRQHandler(&hdma_i2c2_tx);
+    CpuStats_IsrExit();
+}
+
+/**
+  * @brief  I2C2事件中断处理函数 (OLED)
+  */
+void I2C2_EV_IRQHandler(void)
+{
+    CpuStats_IsrEnter();
+    OLED_I2C_DMA_EV_IRQHandler();
+    CpuStats_IsrExit();
+}
+
+/**
+  * @brief  I2C2错误中断处理函数 (OLED)
+  */
+void I2C2_ER_IRQHandler(void)
+{
+    CpuStats_IsrEnter();
+    OLED_I2C_DMA_ER_IRQHandler();
+    CpuStats_IsrExit();
+}
+#elif OLED_TRANSPORT == OLED_TRANSPORT_SOFT_ISR
+/**
+  * @brief  TIM4中断处理函数 (后台模拟I2C, OLED)
+  */
+void TIM4_IRQHandler(void)
+{
+    CpuStats_IsrEnter();
+    I2C_ISR_TIM_IRQHandler();
+    CpuStats_IsrExit();
+}
+#endif
+
+#if CONSOLE_DMA
+/**
+  * @brief  DMA1 Channel4中断处理函数 (USART1 TX, 调试输出)
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+    CpuStats_IsrEnter();
+    Console_DMA_IRQHandler();
+    CpuStats_IsrExit();
 }
+#endif
@@ -0,0 +1,291 @@
+/*
+================================================================================
+tlsf.c - 两级分离适配（TLSF）分配器实现文件
+================================================================================
+池的布局：若干相邻的块，最后是一个长度为 0、标为已用的哨兵块头，合并时
+向后看到它就停下。块长的单位是 TLSF_ALIGN（下文称“格”），最小块 2 格
+（块头 + 8 字节）。不加锁，调用方负责互斥（heap_tlsf.c 挂起调度器）。
+*/
+#include "tlsf.h"
+
+/* Private macros ------------------------------------------------------------*/
+#define TLSF_NONE                   0xFFFFU
+#define TLSF_FREE_BIT               0x8000U
+#define TLSF_MIN_UNITS              2U
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint16_t prev_phys;             ///< 前一个相邻块的偏移，首块为 TLSF_NONE
+    uint16_t size;                  ///< 块长（格，含块头）| TLSF_FREE_BIT
+    uint16_t next_free;             ///< 仅空闲块：同一链表中的下一块 / 上一块
+    uint16_t prev_free;
+} Tlsf_Block_t;
+
+_Static_assert(sizeof(Tlsf_Block_t) == TLSF_HEADER_SIZE, "TLSF block header layout");
+_Static_assert(TLSF_SL_COUNT <= 8, "sl_bitmap is 8 bits wide");
+_Static_assert(TLSF_FL_COUNT <= 16, "fl_bitmap is 16 bits wide");
+
+/* Private functions ---------------------------------------------------------*/
+static inline Tlsf_Block_t *Tlsf_At(const Tlsf_t *tlsf, uint16_t off)
+{
+    return (Tlsf_Block_t *)(tlsf->base + (size_t)off * TLSF_ALIGN);
+}
+
+static inline uint16_t Tlsf_Units(const Tlsf_Block_t *b)
+{
+    return (uint16_t)(b->size & ~TLSF_FREE_BIT);
+}
+
+static inline unsigned Tlsf_Msb(uint32_t v)
+{
+    return 31U - (unsigned)__builtin_clz(v);
+}
+
+/* 块长 -> 所在链表 */
+static void Tlsf_MappingInsert(uint32_t units, unsigned *fl, unsigned *sl)
+{
+    if (units < TLSF_SL_COUNT) {
+        *fl = 0;
+        *sl = units;
+    } else {
+        unsigned msb = Tlsf_Msb(units);
+        *fl = msb - TLSF_SL_LOG2 + 1U;
+        *sl = (units >> (msb - TLSF_SL_LOG2)) & (TLSF_SL_COUNT - 1U);
+    }
+}
+
+/* 请求 -> 从哪条链表找起：先上取整到下一条链表的下界，这样找到的任何块都够大 */
+static void Tlsf_MappingSearch(uint32_t units, unsigned *fl, unsigned *sl)
+{
+    if (units >= TLSF_SL_COUNT) {
+        units += (1UL << (Tlsf_Msb(units) - TLSF_SL_LOG2)) - 1U;
+    }
+    Tlsf_MappingInsert(units, fl, sl);
+}
+
+static void Tlsf_Insert(Tlsf_t *tlsf, uint16_t off)
+{
+    Tlsf_Block_t *b = Tlsf_At(tlsf, off);
+    unsigned fl, sl;
+
+    Tlsf_MappingInsert(Tlsf_Units(b), &fl, &sl);
+    b->size |= TLSF_FREE_BIT;
+    b->prev_free = TLSF_NONE;
+    b->next_free = tlsf->heads[fl][sl];
+    if (b->next_free != TLSF_NONE) {
+        Tlsf_At(tlsf, b->next_free)->prev_free = off;
+    }
+    tlsf->heads[fl][sl] = off;
+    tlsf->fl_bitmap |= (uint16_t)(1U << fl);
+    tlsf->sl_bitmap[fl] |= (uint8_t)(1U << sl);
+    tlsf->free_bytes += (size_t)Tlsf_Units(b) * TLSF_ALIGN;
+}
+
+static void Tlsf_Remove(Tlsf_t *tlsf, uint16_t off)
+{
+    Tlsf_Block_t *b = Tlsf_At(tlsf, off);
+    unsigned fl, sl;
+
+    Tlsf_MappingInsert(Tlsf_Units(b), &fl, &sl);
+    if (b->next_free != TLSF_NONE) {
+        Tlsf_At(tlsf, b->next_free)->prev_free = b->prev_free;
+    }
+    if (b->prev_free != TLSF_NONE) {
+        Tlsf_At(tlsf, b->prev_free)->next_free = b->next_free;
+    } else {
+        tlsf->heads[fl][sl] = b->next_free;
+        if (b->next_free == TLSF_NONE) {
+            tlsf->sl_bitmap[fl] &= (uint8_t)~(1U << sl);
+            if (tlsf->sl_bitmap[fl] == 0) {
+                tlsf->fl_bitmap &= (uint16_t)~(1U << fl);
+            }
+        }
+    }
+    b->size &= (uint16_t)~TLSF_FREE_BIT;
+    b->next_free = TLSF_NONE;
+    b->prev_free = TLSF_NONE;
+    tlsf->free_bytes -= (size_t)Tlsf_Units(b) * TLSF_ALIGN;
+}
+
+/* 从 [fl][sl] 起第一条非空链表的表头，没有返回 TLSF_NONE */
+static uint16_t Tlsf_FindSuitable(const Tlsf_t *tlsf, unsigned fl, unsigned sl)
+{
+    uint32_t sl_map, fl_map;
+
+    if (fl >= TLSF_FL_COUNT) {
+        return TLSF_NONE;
+    }
+    sl_map = tlsf->sl_bitmap[fl] & (~0UL << sl);
+    if (sl_map == 0) {
+        fl_map = tlsf->fl_bitmap & (~0UL << (fl + 1U));
+        if (fl_map == 0) {
+            return TLSF_NONE;
+        }
+        fl = (unsigned)__builtin_ctz(fl_map);
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    return tlsf->heads[fl][__builtin_ctz(sl_map)];
+}
+
+/* 块 off 后面相邻的块的 prev_phys 指回 off */
+static void Tlsf_LinkNext(Tlsf_t *tlsf, uint16_t off)
+{
+    Tlsf_At(tlsf, (uint16_t)(off + Tlsf_Units(Tlsf_At(tlsf, off))))->prev_phys = off;
+}
+
+/* Public functions ----------------------------------------------------------*/
+bool Tlsf_Init(Tlsf_t *tlsf, void *mem, size_t size)
+{
+    uintptr_t start = ((uintptr_t)mem + TLSF_ALIGN - 1U) & ~(uintptr_t)(TLSF_ALIGN - 1U);
+    size_t units;
+    Tlsf_Block_t *first, *sentinel;
+
+    if (size < start - (uintptr_t)mem) {
+        return false;
+    }
+    size -= start - (uintptr_t)mem;
+    if (size > TLSF_MAX_POOL) {
+        size = TLSF_MAX_POOL;
+    }
+    units = size / TLSF_ALIGN;
+    if (units < TLSF_MIN_UNITS + 1U) {
+        return false;
+    }
+
+    tlsf->base = (uint8_t *)start;
+    tlsf->free_bytes = 0;
+    tlsf->fl_bitmap = 0;
+    for (unsigned i = 0; i < TLSF_FL_COUNT; i++) {
+        tlsf->sl_bitmap[i] = 0;
+        for (unsigned j = 0; j < TLSF_SL_COUNT; j++) {
+            tlsf->heads[i][j] = TLSF_NONE;
+        }
+    }
+
+    first = Tlsf_At(tlsf, 0);
+    first->prev_phys = TLSF_NONE;
+    first->size = (uint16_t)(units - 1U);
+    sentinel = Tlsf_At(tlsf, (uint16_t)(units - 1U));
+    sentinel->prev_phys = 0;
+    sentinel->size = 0;
+    sentinel->next_free = TLSF_NONE;
+    sentinel->prev_free = TLSF_NONE;
+    Tlsf_Insert(tlsf, 0);
+    return true;
+}
+
+void *Tlsf_Alloc(Tlsf_t *tlsf, size_t size)
+{
+    uint32_t units;
+    unsigned fl, sl;
+    uint16_t off;
+    Tlsf_Block_t *b;
+
+    if (size == 0 || size > TLSF_MAX_POOL) {
+        return NULL;
+    }
+    units = (uint32_t)((size + TLSF_HEADER_SIZE + TLSF_ALIGN - 1U) / TLSF_ALIGN);
+    if (units < TLSF_MIN_UNITS) {
+        units = TLSF_MIN_UNITS;
+    }
+
+    Tlsf_MappingSearch(units, &fl, &sl);
+    off = Tlsf_FindSuitable(tlsf, fl, sl);
+    if (off == TLSF_NONE) {
+        /* 上取整后没有更大的链表了：请求所在链表的表头也可能正好够大，只看这一块 */
+        Tlsf_MappingInsert(units, &fl, &sl);
+        if (fl >= TLSF_FL_COUNT) {
+            return NULL;
+        }
+        off = tlsf->heads[fl][sl];
+        if (off == TLSF_NONE || Tlsf_Units(Tlsf_At(tlsf, off)) < units) {
+            return NULL;
+        }
+    }
+
+    Tlsf_Remove(tlsf, off);
+    b = Tlsf_At(tlsf, off);
+
+    /* 余下的部分够一个最小块就切出来放回链表 */
+    if (Tlsf_Units(b) - units >= TLSF_MIN_UNITS) {
+        uint16_t rest = (uint16_t)(off + units);
+        Tlsf_Block_t *r = Tlsf_At(tlsf, rest);
+
+        r->prev_phys = off;
+        r->size = (uint16_t)(Tlsf_Units(b) - units);
+        b->size = (uint16_t)units;
+        Tlsf_LinkNext(tlsf, rest);
+        Tlsf_Insert(tlsf, rest);
+    }
+    return (uint8_t *)b + TLSF_HEADER_SIZE;
+}
+
+bool Tlsf_Free(Tlsf_t *tlsf, void *p)
+{
+    uint16_t off;
+    Tlsf_Block_t *b, *next;
+
+    if (p == NULL) {
+        return true;
+    }
+    off = (uint16_t)(((uint8_t *)p - TLSF_HEADER_SIZE - tlsf->base) / TLSF_ALIGN);
+    b = Tlsf_At(tlsf, off);
+    if ((b->size & TLSF_FREE_BIT) != 0 || Tlsf_Units(b) < TLSF_MIN_UNITS) {
+        return false;
+    }
+
+    /* 与后一块合并（哨兵不是空闲块，不会越界） */
+    next = Tlsf_At(tlsf, (uint16_t)(off + Tlsf_Units(b)));
+    if ((next->size & TLSF_FREE_BIT) != 0) {
+        Tlsf_Remove(tlsf, (uint16_t)(off + Tlsf_Units(b)));
+        b->size = (uint16_t)(Tlsf_Units(b) + Tlsf_Units(next));
+    }
+    /* 与前一块合并 */
+    if (b->prev_phys != TLSF_NONE && (Tlsf_At(tlsf, b->prev_phys)->size & TLSF_FREE_BIT) != 0) {
+        uint16_t prev = b->prev_phys;
+        Tlsf_Block_t *pb = Tlsf_At(tlsf, prev);
+
+        Tlsf_Remove(tlsf, prev);
+        pb->size = (uint16_t)(Tlsf_Units(pb) + Tlsf_Units(b));
+        off = prev;
+    }
+    Tlsf_LinkNext(tlsf, off);
+    Tlsf_Insert(tlsf, off);
+    return true;
+}
+
+size_t Tlsf_BlockSize(const Tlsf_t *tlsf, const void *p)
+{
+    const Tlsf_Block_t *b = (const Tlsf_Block_t *)((const uint8_t *)p - TLSF_HEADER_SIZE);
+
+    (void)tlsf;
+    return (size_t)Tlsf_Units(b) * TLSF_ALIGN;
+}
+
+void Tlsf_GetStats(const Tlsf_t *tlsf, Tlsf_Stats_t *stats)
+{
+    uint16_t off = 0;
+
+    stats->free_bytes = tlsf->free_bytes;
+    stats->largest_free = 0;
+    stats->smallest_free = 0;
+    stats->free_blocks = 0;
+    for (;;) {
+        const Tlsf_Block_t *b = Tlsf_At(tlsf, off);
+        size_t bytes = (size_t)Tlsf_Units(b) * TLSF_ALIGN;
+
+        if (bytes == 0) {
+            break;                  // 哨兵
+        }
+        if ((b->size & TLSF_FREE_BIT) != 0) {
+            if (bytes > stats->largest_free) {
+                stats->largest_free = bytes;
+            }
+            if (stats->free_blocks == 0 || bytes < stats->smallest_free) {
+                stats->smallest_free = bytes;
+            }
+            stats->free_blocks++;
+        }
+        off = (uint16_t)(off + Tlsf_Units(b));
+    }
+}
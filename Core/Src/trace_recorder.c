@@ -0,0 +1,255 @@
+/*
+================================================================================
+trace_recorder.c - 内核事件跟踪实现文件
+================================================================================
+记录在关中断的几条指令内写完，任务、中断和内核临界区里都可以调用，不依赖
+任何 RTOS 接口。冻结标志也在关中断时检查，所以一旦冻结，不会再有被打断的
+写入者在发送快照期间改动缓冲。快照发送期间不记录（发送本身产生的事件不需要）。
+*/
+#include "trace_recorder.h"
+
+#if TRACE_RECORDER
+
+#include "main.h"
+#include "console.h"
+#include "cpu_stats.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include <string.h>
+
+#if (TRACE_RECORDS & (TRACE_RECORDS - 1)) != 0
+#error "TRACE_RECORDS must be a power of two"
+#endif
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint32_t cycles;
+    uint8_t  type;
+    uint8_t  a;
+    uint16_t b;
+} Trace_Record_t;
+
+_Static_assert(sizeof(Trace_Record_t) == TRACE_RECORD_SIZE, "trace record layout");
+
+typedef enum {
+    TRACE_STATE_OFF = 0,
+    TRACE_STATE_RUNNING,
+    TRACE_STATE_FROZEN,
+} Trace_State_t;
+
+/* Private variables ---------------------------------------------------------*/
+static Trace_Record_t g_trace[TRACE_RECORDS];
+static uint32_t g_trace_count = 0;              // 自由递增，写入位置为 count % TRACE_RECORDS
+static volatile uint8_t g_trace_state = TRACE_STATE_OFF;
+static uint32_t g_trace_freeze_cycles;
+static uint32_t g_trace_freeze_tick;
+static const char *g_trace_objects[TRACE_MAX_OBJECTS];
+static uint8_t g_trace_object_count = 0;
+
+/* Private functions ---------------------------------------------------------*/
+/* 调用方已关中断 */
+static Trace_Record_t *Trace_Next(void)
+{
+    return &g_trace[g_trace_count++ & (TRACE_RECORDS - 1U)];
+}
+
+static void Trace_Freeze(void)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (g_trace_state == TRACE_STATE_RUNNING) {
+        g_trace_state = TRACE_STATE_FROZEN;
+        g_trace_freeze_cycles = DWT->CYCCNT;
+        g_trace_freeze_tick = (uint32_t)xTaskGetTickCount();
+    }
+    __set_PRIMASK(primask);
+}
+
+/* 发一帧；控制台缓冲放不下时等 DMA 腾出空间 */
+static void Trace_Frame(uint8_t kind, const void *data, uint8_t len)
+{
+    char frame[3 + TRACE_FRAME_MAX];
+
+    frame[0] = (char)TRACE_SYNC;
+    frame[1] = (char)kind;
+    frame[2] = (char)len;
+    if (len != 0) {
+        memcpy(&frame[3], data, len);
+    }
+    while (Console_Write(frame, (uint16_t)(3U + len)) == 0) {
+        vTaskDelay(1);
+    }
+}
+
+static void Trace_NameFrame(uint8_t kind, uint8_t number, const char *name)
+{
+    uint8_t buf[1 + configMAX_TASK_NAME_LEN];
+    uint8_t len = 0;
+
+    buf[0] = number;
+    while (name[len] != '\0' && len < configMAX_TASK_NAME_LEN) {
+        buf[1 + len] = (uint8_t)name[len];
+        len++;
+    }
+    Trace_Frame(kind, buf, (uint8_t)(1U + len));
+}
+
+static uint8_t *Trace_Put32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+    return p + 4;
+}
+
+/* Public functions ----------------------------------------------------------*/
+void Trace_Init(void)
+{
+    CpuStats_InitCounter();                     // 打开 DWT 周期计数器，调度器启动时还会再调一次
+    g_trace_state = TRACE_STATE_RUNNING;
+}
+
+void Trace_Event(uint8_t type, uint8_t a, uint16_t b)
+{
+    uint32_t primask = __get_PRIMASK();
+    Trace_Record_t *r;
+
+    __disable_irq();
+    if (g_trace_state == TRACE_STATE_RUNNING) {
+        r = Trace_Next();
+        r->cycles = DWT->CYCCNT;
+        r->type = type;
+        r->a = a;
+        r->b = b;
+    }
+    __set_PRIMASK(primask);
+}
+
+void Trace_NameObject(void *handle, const char *name)
+{
+    if (handle == NULL || g_trace_object_count >= TRACE_MAX_OBJECTS) {
+        return;
+    }
+    g_trace_objects[g_trace_object_count++] = name;
+    /* 递归互斥量的句柄被 cmsis_os2 置了最低位 */
+    vQueueSetQueueNumber((QueueHandle_t)((uintptr_t)handle & ~(uintptr_t)1U), g_trace_object_count);
+}
+
+void Trace_Heap(uint8_t type, const void *address, size_t size)
+{
+    size_t units = (size + 7U) / 8U;
+    uint16_t where = 0xFFFF;
+
+    /* 20 KB SRAM 以 8 字节为单位放得进 16 位；回放只靠地址配对分配和释放 */
+    if (address != NULL) {
+        where = (uint16_t)(((uintptr_t)address - SRAM_BASE) / 8U);
+    }
+    Trace_Event(type, (uint8_t)(units > 255U ? 255U : units), where);
+}
+
+void Trace_MarkStart(Trace_Mark_t mark, uint16_t value, const char *label)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint8_t len = 0;
+    Trace_Record_t *r;
+
+    __disable_irq();
+    if (g_trace_state == TRACE_STATE_RUNNING) {
+        r = Trace_Next();
+        r->cycles = DWT->CYCCNT;
+        r->type = TRACE_EV_MARK_START;
+        r->a = (uint8_t)mark;
+        r->b = value;
+
+        /* 文字放在紧跟的续记录里：类型字节之外的 7 个字节，不足补 0 */
+        while (label != NULL && label[len] != '\0' && len < TRACE_LABEL_MAX) {
+            uint8_t *raw = (uint8_t *)Trace_Next();
+
+            memset(raw, 0, TRACE_RECORD_SIZE);
+            raw[4] = TRACE_EV_TEXT;
+            for (uint8_t i = 0; i < TRACE_RECORD_SIZE; i++) {
+                if (i == 4) {
+                    continue;
+                }
+                if (label[len] == '\0' || len >= TRACE_LABEL_MAX) {
+                    break;
+                }
+                raw[i] = (uint8_t)label[len++];
+            }
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+void Trace_MarkStop(Trace_Mark_t mark, uint16_t value)
+{
+    Trace_Event(TRACE_EV_MARK_STOP, (uint8_t)mark, value);
+}
+
+void Trace_Trigger(void)
+{
+    Trace_Freeze();
+}
+
+bool Trace_Dump(bool force)
+{
+    TaskStatus_t tasks[CPU_STATS_MAX_TASKS];
+    uint8_t hdr[19];
+    uint8_t *p = hdr;
+    uint32_t count, n, i;
+    UBaseType_t ntasks;
+
+    if (force) {
+        Trace_Freeze();
+    }
+    if (g_trace_state != TRACE_STATE_FROZEN) {
+        return false;
+    }
+
+    count = g_trace_count;
+    n = count < TRACE_RECORDS ? count : TRACE_RECORDS;
+
+    *p++ = TRACE_VERSION;
+    p = Trace_Put32(p, SystemCoreClock);
+    p = Trace_Put32(p, g_trace_freeze_cycles);
+    p = Trace_Put32(p, g_trace_freeze_tick);
+    p = Trace_Put32(p, count);
+    *p++ = (uint8_t)TRACE_RECORDS;
+    *p++ = (uint8_t)(TRACE_RECORDS >> 8);
+    Trace_Frame(TRACE_FRAME_HEADER, hdr, (uint8_t)(p - hdr));
+
+    ntasks = uxTaskGetSystemState(tasks, CPU_STATS_MAX_TASKS, NULL);
+    for (i = 0; i < ntasks; i++) {
+        Trace_NameFrame(TRACE_FRAME_TASK, (uint8_t)tasks[i].xTaskNumber, tasks[i].pcTaskName);
+    }
+    for (i = 0; i < g_trace_object_count; i++) {
+        Trace_NameFrame(TRACE_FRAME_OBJECT, (uint8_t)(i + 1U), g_trace_objects[i]);
+    }
+
+    /* 从最旧的记录开始，每帧 TRACE_FRAME_MAX / 8 条；环形缓冲末尾处截断成两帧 */
+    for (i = count - n; i != count; ) {
+        uint32_t slot = i & (TRACE_RECORDS - 1U);
+        uint32_t chunk = TRACE_FRAME_MAX / TRACE_RECORD_SIZE;
+
+        if (chunk > count - i) {
+            chunk = count - i;
+        }
+        if (chunk > TRACE_RECORDS - slot) {
+            chunk = TRACE_RECORDS - slot;
+        }
+        Trace_Frame(TRACE_FRAME_RECORDS, &g_trace[slot], (uint8_t)(chunk * TRACE_RECORD_SIZE));
+        i += chunk;
+    }
+    Trace_Frame(TRACE_FRAME_END, NULL, 0);
+
+    __disable_irq();
+    g_trace_count = 0;
+    g_trace_state = TRACE_STATE_RUNNING;
+    __enable_irq();
+    return true;
+}
+
+#endif /* TRACE_RECORDER */
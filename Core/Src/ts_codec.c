@@ -0,0 +1,241 @@
+/*
+================================================================================
+ts_codec.c - Gorilla 风格时间序列压缩实现
+================================================================================
+格式（MSB 优先的位流）:
+  样本0:  时间戳 32 位 + 数值 32 位
+  时间戳: dod = (t - t_prev) - delta_prev
+          '0'                dod == 0
+          '10'   + 7 位      -64  .. 63
+          '110'  + 9 位      -256 .. 255
+          '1110' + 12 位     -2048 .. 2047
+          '1111' + 32 位     其他
+  数值:   x = v ^ v_prev
+          '0'                x == 0
+          '10'   + len 位      非零位落在上一次的 [lead, lead+len) 窗口内
+          '11'   + lead(5) + len-1(5) + len 位，并更新窗口
+本文件不依赖 HAL，主机端工具直接复用同一份源码解码。
+*/
+#include "ts_codec.h"
+#include <string.h>
+
+#if defined(TS_CODEC_PROFILE) && defined(__arm__)
+#include "stm32f1xx.h"
+#define TS_CYCLES()     (DWT->CYCCNT)
+#else
+#define TS_CYCLES()     (0U)
+#endif
+
+/* Private functions ---------------------------------------------------------*/
+static void ts_put_bits(TS_Encoder_t *enc, uint32_t value, uint8_t nbits)
+{
+    while (nbits) {
+        uint8_t free = 8 - (enc->bit_pos & 7U);
+        uint8_t take = nbits < free ? nbits : free;
+        uint8_t chunk = (uint8_t)((value >> (nbits - take)) & ((1U << take) - 1U));
+
+        enc->buf[enc->bit_pos >> 3] |= (uint8_t)(chunk << (free - take));
+        enc->bit_pos += take;
+        nbits -= take;
+    }
+}
+
+/* 越过 size_bits 时不读缓冲区，置 error 并返回 0 */
+static uint32_t ts_get_bits(TS_Decoder_t *dec, uint8_t nbits)
+{
+    uint32_t value = 0;
+
+    if (dec->error || nbits > dec->size_bits - dec->bit_pos) {
+        dec->error = true;
+        return 0;
+    }
+    while (nbits) {
+        uint8_t avail = 8 - (dec->bit_pos & 7U);
+        uint8_t take = nbits < avail ? nbits : avail;
+        uint8_t byte = dec->buf[dec->bit_pos >> 3];
+
+        value = (value << take) | ((byte >> (avail - take)) & ((1U << take) - 1U));
+        dec->bit_pos += take;
+        nbits -= take;
+    }
+
+    return value;
+}
+
+static uint8_t ts_clz(uint32_t x)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_clz(x);
+#else
+    uint8_t n = 0;
+    while (!(x & 0x80000000U)) { x <<= 1; n++; }
+    return n;
+#endif
+}
+
+static uint8_t ts_ctz(uint32_t x)
+{
+#if defined(__GNUC__)
+    return (uint8_t)__builtin_ctz(x);
+#else
+    uint8_t n = 0;
+    while (!(x & 1U)) { x >>= 1; n++; }
+    return n;
+#endif
+}
+
+static int32_t ts_sign_extend(uint32_t value, uint8_t nbits)
+{
+    uint32_t sign = 1U << (nbits - 1);
+    return (int32_t)((value ^ sign) - sign);
+}
+
+/* Public functions ----------------------------------------------------------*/
+void TS_Encode_Init(TS_Encoder_t *enc, uint8_t *buf, uint16_t size)
+{
+    memset(enc, 0, sizeof(*enc));
+    memset(buf, 0, size);
+    enc->buf = buf;
+    enc->capacity_bits = (uint32_t)size * 8U;
+}
+
+bool TS_Encode_Append(TS_Encoder_t *enc, uint32_t timestamp, int32_t value)
+{
+#ifdef TS_CODEC_PROFILE
+    uint32_t start = TS_CYCLES();
+#endif
+    uint32_t v = (uint32_t)value;
+
+    if (enc->bit_pos + TS_CODEC_MAX_SAMPLE_BITS > enc->capacity_bits || enc->count == UINT16_MAX) {
+        return false;
+    }
+
+    if (enc->count == 0) {
+        ts_put_bits(enc, timestamp, 32);
+        ts_put_bits(enc, v, 32);
+    } else {
+        int32_t delta = (int32_t)(timestamp - enc->t_prev);
+        int32_t dod = (int32_t)((uint32_t)delta - (uint32_t)enc->t_delta);    // 按 2^32 取模，与解码对称
+        uint32_t x = v ^ enc->v_prev;
+
+        if (dod == 0) {
+            ts_put_bits(enc, 0x0, 1);
+        } else if (dod >= -64 && dod <= 63) {
+            ts_put_bits(enc, 0x2, 2);
+            ts_put_bits(enc, (uint32_t)dod & 0x7FU, 7);
+        } else if (dod >= -256 && dod <= 255) {
+            ts_put_bits(enc, 0x6, 3);
+            ts_put_bits(enc, (uint32_t)dod & 0x1FFU, 9);
+        } else if (dod >= -2048 && dod <= 2047) {
+            ts_put_bits(enc, 0xE, 4);
+            ts_put_bits(enc, (uint32_t)dod & 0xFFFU, 12);
+        } else {
+            ts_put_bits(enc, 0xF, 4);
+            ts_put_bits(enc, (uint32_t)dod, 32);
+        }
+        enc->t_delta = delta;
+
+        if (x == 0) {
+            ts_put_bits(enc, 0x0, 1);
+        } else {
+            uint8_t lead = ts_clz(x);
+            uint8_t trail = ts_ctz(x);
+
+            if (lead > 31) lead = 31;
+            if (enc->v_len != 0 && lead >= enc->v_lead &&
+                trail >= 32U - enc->v_lead - enc->v_len) {
+                /* Reuse the previous window */
+                ts_put_bits(enc, 0x2, 2);
+                ts_put_bits(enc, x >> (32U - enc->v_lead - enc->v_len), enc->v_len);
+            } else {
+                uint8_t len = 32U - lead - trail;
+                ts_put_bits(enc, 0x3, 2);
+                ts_put_bits(enc, lead, 5);
+                ts_put_bits(enc, len - 1U, 5);
+                ts_put_bits(enc, x >> trail, len);
+                enc->v_lead = lead;
+                enc->v_len = len;
+            }
+        }
+    }
+
+    enc->t_prev = timestamp;
+    enc->v_prev = v;
+    enc->count++;
+
+#ifdef TS_CODEC_PROFILE
+    enc->cycles += TS_CYCLES() - start;
+#endif
+    return true;
+}
+
+uint16_t TS_Encode_Bytes(const TS_Encoder_t *enc)
+{
+    return (uint16_t)((enc->bit_pos + 7U) >> 3);
+}
+
+void TS_Decode_Init(TS_Decoder_t *dec, const uint8_t *buf, uint32_t size_bits, uint16_t count)
+{
+    memset(dec, 0, sizeof(*dec));
+    dec->buf = buf;
+    dec->size_bits = size_bits;
+    dec->count = count;
+}
+
+bool TS_Decode_Next(TS_Decoder_t *dec, uint32_t *timestamp, int32_t *value)
+{
+    if (dec->error || dec->index >= dec->count) {
+        return false;
+    }
+
+    if (dec->index == 0) {
+        dec->t_prev = ts_get_bits(dec, 32);
+        dec->v_prev = ts_get_bits(dec, 32);
+    } else {
+        int32_t dod;
+
+        if (ts_get_bits(dec, 1) == 0) {
+            dod = 0;
+        } else if (ts_get_bits(dec, 1) == 0) {
+            dod = ts_sign_extend(ts_get_bits(dec, 7), 7);
+        } else if (ts_get_bits(dec, 1) == 0) {
+            dod = ts_sign_extend(ts_get_bits(dec, 9), 9);
+        } else if (ts_get_bits(dec, 1) == 0) {
+            dod = ts_sign_extend(ts_get_bits(dec, 12), 12);
+        } else {
+            dod = (int32_t)ts_get_bits(dec, 32);
+        }
+        dec->t_delta = (int32_t)((uint32_t)dec->t_delta + (uint32_t)dod);
+        dec->t_prev += (uint32_t)dec->t_delta;
+
+        if (ts_get_bits(dec, 1) != 0) {
+            uint32_t x;
+            if (ts_get_bits(dec, 1) == 0) {
+                /* 复用窗口：之前必须有过一次 '11' */
+                if (dec->v_len == 0) {
+                    dec->error = true;
+                    return false;
+                }
+                x = ts_get_bits(dec, dec->v_len) << (32U - dec->v_lead - dec->v_len);
+            } else {
+                dec->v_lead = (uint8_t)ts_get_bits(dec, 5);
+                dec->v_len = (uint8_t)ts_get_bits(dec, 5) + 1U;
+                if (dec->v_lead + dec->v_len > 32U) {
+                    dec->error = true;
+                    return false;
+                }
+                x = ts_get_bits(dec, dec->v_len) << (32U - dec->v_lead - dec->v_len);
+            }
+            dec->v_prev ^= x;
+        }
+    }
+
+    if (dec->error) {
+        return false;
+    }
+
+    *timestamp = dec->t_prev;
+    *value = (int32_t)dec->v_prev;
+    dec->index++;
+    return true;
+}
@@ -9,17 +9,18 @@ uart_handler.c - UART DMA IDLE处理实现文件
 #include "uart.h"
 #include "app_task.h"
 #include "my_printf.h"
+#include "msg_buf.h"
+#include "metrics.h"
 
 /* Private variables ---------------------------------------------------------*/
 uint8_t uart2_dma_buffer[UART_DMA_BUFFER_SIZE];
-uint8_t uart2_process_buffer[UART_DMA_BUFFER_SIZE];
 volatile uint16_t uart2_last_dma_size = 0;
 volatile uint8_t uart2_rx_complete_flag = 0;
 static volatile uint8_t uart2_tx_busy = 0;
 static uint8_t uart2_tx_buffer[UART_DMA_BUFFER_SIZE];
 
 /* Private function prototypes -----------------------------------------------*/
-static void UART2_ParseReceivedData(uint8_t* data, uint16_t length);
+static void UART2_ParseReceivedData(MsgBuf_t* msg);
 
 /**
   * @brief  Initialize UART2 DMA handler
@@ -29,7 +30,6 @@ void UART2_Init(void)
 {
     // 清空缓冲区
     memset(uart2_dma_buffer, 0, UART_DMA_BUFFER_SIZE);
-    memset(uart2_process_buffer, 0, UART_DMA_BUFFER_SIZE);
 
     // 启用UART2空闲中断
     __HAL_UART_ENABLE_IT(&huart2, UART_IT_IDLE);
@@ -105,15 +105,20 @@ void HAL_UART_IdleCallback(UART_HandleTypeDef *huart)
 
         if(recv_len > 0)
         {
-            // 复制数据到处理缓冲区
-            memset(uart2_process_buffer, 0, UART_DMA_BUFFER_SIZE);
-            memcpy(uart2_process_buffer, uart2_dma_buffer, recv_len);
-            //HAL_UART_Transmit(&huart1, uart2_process_buffer, sizeof(uart2_process_buffer), 100);
-            // 解析接收到的数据
-            UART2_ParseReceivedData(uart2_process_buffer, recv_len);
-
-            // 清空DMA缓冲区
-            memset(uart2_dma_buffer, 0, UART_DMA_BUFFER_SIZE);
+            // 直接写进池中的消息缓冲，之后只传递指针；池空时丢弃这一段
+            MsgBuf_t *msg = MsgBuf_Alloc();
+            if(msg != NULL)
+            {
+                // 截断保护 + 添加结束符
+                if(recv_len >= MSG_BUF_SIZE)
+                    recv_len = MSG_BUF_SIZE - 1;
+                memcpy(msg->data, uart2_dma_buffer, recv_len);
+                msg->data[recv_len] = '\0';
+                msg->length = recv_len;
+
+                // 解析并分发到对应队列
+                UART2_ParseReceivedData(msg);
+            }
         }
 
         // 重新启动DMA接收
@@ -140,48 +145,28 @@ void HAL_UART_IRQHandler_Custom(UART_HandleTypeDef *huart)
 }
 
 /**
-  * @brief  解析接收到的数据
-  * @param  data: 接收数据指针
-  * @param  length: 数据长度
+  * @brief  解析接收到的数据，把缓冲（连同引用）交给对应的队列
+  * @param  msg: 已写好数据并以 '\0' 结尾的消息缓冲
   * @retval None
   */
-static void UART2_ParseReceivedData(uint8_t* data, uint16_t length)
+static void UART2_ParseReceivedData(MsgBuf_t* msg)
 {
-    if(length == 0)
-        return;
-
-    // 截断保护 + 添加结束符
-    if(length >= UART_DMA_BUFFER_SIZE)
-        length = UART_DMA_BUFFER_SIZE - 1;
-    data[length] = '\0';
-
-    // 检查是否为+IPD数据（MQTT收到的报文）
-    char *ipd = strstr((char*)data, "+IPD,");
+    // 检查是否为+IPD数据（MQTT收到的报文）：载荷从 ':' 之后开始，不再拷贝
+    char *ipd = strstr(msg->data, "+IPD,");
     if(ipd != NULL)
     {
         char *colon = strchr(ipd, ':');
         if(colon != NULL)
         {
-            MQTT_Message_t mqtt_msg;
-            uint16_t payload_len = length - (uint16_t)(colon + 1 - (char*)data);
-            if(payload_len >= sizeof(mqtt_msg.payload))
-                payload_len = sizeof(mqtt_msg.payload) - 1;
-            memcpy(mqtt_msg.payload, colon + 1, payload_len);
-            mqtt_msg.payload[payload_len] = '\0';
-            osMessageQueuePut(mqttQueueHandle, &mqtt_msg, 0, 0);
+            msg->offset = (uint16_t)(colon + 1 - msg->data);
+            MsgBuf_Send(mqttQueueHandle, msg, 0);
             uart2_rx_complete_flag = 1;
             return;
         }
     }
 
     // 普通AT响应放入uart2队列
-    if(length < sizeof(((UartMessage_t*)0)->data))
-    {
-        UartMessage_t uart_msg;
-        memcpy(uart_msg.data, data, length + 1);  // 含'\0'
-        uart_msg.length = length;
-        osMessageQueuePut(uart2QueueHandle, &uart_msg, 0, 0);
-    }
+    MsgBuf_Send(uart2QueueHandle, msg, 0);
 
     uart2_rx_complete_flag = 1;
 }
@@ -195,18 +180,20 @@ static void UART2_ParseReceivedData(uint8_t* data, uint16_t length)
 HAL_StatusTypeDef UART2_WaitForResponse(const char* expected_response, uint32_t timeout)
 {
     uint32_t start_time = osKernelGetTickCount();
-    UartMessage_t uart_msg;
+    MsgBuf_t *msg;
 
     uart2_rx_complete_flag = 0;
 
     while((osKernelGetTickCount() - start_time) < timeout)
     {
         // 尝试从队列获取消息
-        if(osMessageQueueGet(uart2QueueHandle, &uart_msg, NULL, 100) == osOK)
+        msg = MsgBuf_Receive(uart2QueueHandle, 100);
+        if(msg != NULL)
         {
-            //HAL_UART_Transmit(&huart1, uart_msg.data, sizeof(uart_msg.data), 100);
             // 检查是否包含期望的响应
-            if(strstr(uart_msg.data, expected_response) != NULL)
+            uint8_t found = strstr(msg->data, expected_response) != NULL;
+            MsgBuf_Release(msg);
+            if(found)
             {
                 return HAL_OK;
             }
@@ -224,15 +211,16 @@ HAL_StatusTypeDef UART2_WaitForResponse(const char* expected_response, uint32_t
   */
 void UART2_ProcessDMAData(void)
 {
-    UartMessage_t uart_msg;
+    MsgBuf_t *msg;
 
     // 从队列中获取UART消息
-    while(osMessageQueueGet(uart2QueueHandle, &uart_msg, NULL, 0) == osOK)
+    while((msg = MsgBuf_Receive(uart2QueueHandle, 0)) != NULL)
     {
         // 处理接收到的数据
-        //printf("Received: %s (Length: %d)\n", uart_msg.data, uart_msg.length);
+        //printf("Received: %s (Length: %d)\n", msg->data, msg->length);
 
         // 可以在这里添加更多的数据处理逻辑
         // 例如：MQTT消息处理、AT命令响应等
+        MsgBuf_Release(msg);
     }
 }
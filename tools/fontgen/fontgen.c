@@ -0,0 +1,340 @@
+/*
+================================================================================
+fontgen.c - OLED 子集字库生成器
+================================================================================
+编译（Linux）:
+  gcc -O2 -I../../Core/Inc -o fontgen fontgen.c ../../Core/Src/oled_font.c
+
+用法:
+  fontgen [--raw] <charset.txt> <oled_font_data.c>
+
+从 oledfont.h 的完整字库中取出 charset.txt 列出的字形，生成带索引的子集表；
+默认使用非零字节掩码压缩（--raw 只做子集）。生成后用 OLED_Font_Decode 逐个
+回读校验，并打印 flash 占用对比和主机端解码耗时。
+
+charset.txt 每行 "<字体>: <字符>"，字体为 8 (6x8)、16 (8x16) 或 hz (16x16 汉字)：
+  - 8/16 行列出字符本身，空白被忽略（空格总会收录），\xNN 表示单个字节；
+  - hz 行列出 Hzk 中的汉字序号（OLED_ShowCHinese 的 no 参数），以空白分隔；
+  - # 开头为注释。
+*/
+#include "oled_font.h"
+#include "oledfont.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define PTR_SIZE            4       /* Cortex-M3 */
+#define FONT_STRUCT_SIZE    (8 + 3 * PTR_SIZE)
+
+typedef struct {
+    const char *name;               /* 生成的全局变量名 */
+    const char *tag;                /* 内部静态表名前缀 */
+    uint8_t     width;
+    uint8_t     pages;
+    uint8_t     first;              /* 源字库第一个字符 */
+    uint16_t    source_count;       /* 源字库字形数 */
+    size_t      source_bytes;       /* 源字库在 flash 中的大小 */
+    uint8_t     used[256];          /* 收录的字符 */
+} Font_Spec_t;
+
+static Font_Spec_t g_fonts[] = {
+    { "OLED_Font6x8",  "font8",  6,  1, ' ', sizeof(F6x8) / 6,    sizeof(F6x8),  {0} },
+    { "OLED_Font8x16", "font16", 8,  2, ' ', sizeof(F8X16) / 16,  sizeof(F8X16), {0} },
+    { "OLED_FontHz16", "hz16",   16, 2, 0,   sizeof(Hzk) / 64,    sizeof(Hzk),   {0} },
+};
+#define FONT_COUNT  (sizeof(g_fonts) / sizeof(g_fonts[0]))
+
+/* 源字库中第 index 个字形的原始字模，按页存放 */
+static void source_glyph(int font, int index, uint8_t *out)
+{
+    switch (font) {
+    case 0:
+        memcpy(out, F6x8[index], 6);
+        break;
+    case 1:
+        memcpy(out, &F8X16[index * 16], 16);
+        break;
+    default:
+        memcpy(out, Hzk[2 * index], 16);
+        memcpy(out + 16, Hzk[2 * index + 1], 16);
+        break;
+    }
+}
+
+static int parse_charset(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[512];
+    int lineno = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *p = line;
+        Font_Spec_t *font;
+
+        lineno++;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') {
+            continue;
+        }
+
+        if (strncmp(p, "8:", 2) == 0) {
+            font = &g_fonts[0];
+            p += 2;
+        } else if (strncmp(p, "16:", 3) == 0) {
+            font = &g_fonts[1];
+            p += 3;
+        } else if (strncmp(p, "hz:", 3) == 0) {
+            font = &g_fonts[2];
+            p += 3;
+        } else {
+            fprintf(stderr, "%s:%d: expected '8:', '16:' or 'hz:'\n", path, lineno);
+            fclose(f);
+            return -1;
+        }
+
+        while (*p != '\0' && *p != '\n' && *p != '\r') {
+            unsigned long c;
+            char *end;
+
+            if (*p == ' ' || *p == '\t') {
+                p++;
+                continue;
+            }
+            if (font == &g_fonts[2]) {
+                c = strtoul(p, &end, 0);
+                p = end;
+            } else if (p[0] == '\\' && p[1] == 'x') {
+                c = strtoul(p + 2, &end, 16);
+                p = end;
+            } else {
+                c = (unsigned char)*p++;
+            }
+            if (c < font->first || c - font->first >= font->source_count) {
+                fprintf(stderr, "%s:%d: glyph 0x%02lx not in source font\n", path, lineno, c);
+                fclose(f);
+                return -1;
+            }
+            font->used[c] = 1;
+        }
+    }
+    fclose(f);
+
+    /* 空格用于补白和未收录字符，始终收录 */
+    g_fonts[0].used[' '] = 1;
+    g_fonts[1].used[' '] = 1;
+    return 0;
+}
+
+/* 生成一个字库，返回生成表的 flash 大小 */
+static size_t emit_font(FILE *out, Font_Spec_t *font, int index, int packed,
+                        uint8_t *data, uint16_t *offset, uint8_t *map, OLED_Font_t *desc)
+{
+    uint8_t n = (uint8_t)(font->width * font->pages);
+    int lo = -1, hi = -1, glyphs = 0;
+    size_t len = 0;
+
+    for (int c = 0; c < 256; c++) {
+        if (font->used[c]) {
+            if (lo < 0) lo = c;
+            hi = c;
+        }
+    }
+    if (lo < 0) {
+        lo = hi = font->first;      /* 空子集：保留一个空索引 */
+    }
+
+    memset(map, OLED_FONT_NONE, 256);
+    for (int c = lo; c <= hi; c++) {
+        uint8_t glyph[OLED_FONT_MAX_BYTES];
+
+        if (!font->used[c]) {
+            continue;
+        }
+        source_glyph(index, c - font->first, glyph);
+        map[c - lo] = (uint8_t)glyphs;
+        offset[glyphs] = (uint16_t)len;
+
+        if (packed) {
+            uint8_t *mask = &data[len];
+            memset(mask, 0, (n + 7) / 8);
+            len += (n + 7) / 8;
+            for (uint8_t i = 0; i < n; i++) {
+                if (glyph[i] != 0) {
+                    mask[i >> 3] |= (uint8_t)(1U << (i & 7));
+                    data[len++] = glyph[i];
+                }
+            }
+        } else {
+            memcpy(&data[len], glyph, n);
+            len += n;
+        }
+        glyphs++;
+    }
+
+    desc->width = font->width;
+    desc->pages = font->pages;
+    desc->packed = (uint8_t)packed;
+    desc->first = (uint8_t)lo;
+    desc->count = (uint8_t)(hi - lo + 1);
+    desc->map = map;
+    desc->offset = packed ? offset : NULL;
+    desc->data = data;
+
+    fprintf(out, "\n/* %s: %d/%u glyphs */\n", font->name, glyphs, (unsigned)font->source_count);
+    fprintf(out, "static const uint8_t g_%s_map[%d] = {", font->tag, desc->count);
+    for (int i = 0; i < desc->count; i++) {
+        fprintf(out, "%s0x%02X,", i % 16 ? " " : "\n    ", map[i]);
+    }
+    fprintf(out, "\n};\n");
+
+    if (packed && glyphs) {
+        fprintf(out, "static const uint16_t g_%s_offset[%d] = {", font->tag, glyphs);
+        for (int i = 0; i < glyphs; i++) {
+            fprintf(out, "%s%u,", i % 12 ? " " : "\n    ", offset[i]);
+        }
+        fprintf(out, "\n};\n");
+    }
+
+    fprintf(out, "static const uint8_t g_%s_data[%zu] = {", font->tag, len ? len : 1);
+    for (int c = lo, g = 0; c <= hi; c++) {
+        size_t end;
+
+        if (!font->used[c]) {
+            continue;
+        }
+        end = g + 1 < glyphs ? offset[g + 1] : len;
+        if (index == 2) {
+            fprintf(out, "\n    /* %d */", c);
+        } else if (c >= 0x21 && c < 0x7F && c != '\\') {
+            fprintf(out, "\n    /* '%c' */", c);
+        } else {
+            fprintf(out, "\n    /* 0x%02X */", c);
+        }
+        for (size_t i = offset[g]; i < end; i++) {
+            fprintf(out, " 0x%02X,", data[i]);
+        }
+        g++;
+    }
+    fprintf(out, "%s\n};\n", len ? "" : "\n    0x00,");
+
+    fprintf(out, "const OLED_Font_t %s = {\n", font->name);
+    fprintf(out, "    .width = %u,\n    .pages = %u,\n    .packed = %u,\n", font->width, font->pages, packed);
+    fprintf(out, "    .first = 0x%02X,\n    .count = %u,\n", desc->first, desc->count);
+    fprintf(out, "    .map = g_%s_map,\n", font->tag);
+    if (packed && glyphs) {
+        fprintf(out, "    .offset = g_%s_offset,\n", font->tag);
+    } else {
+        fprintf(out, "    .offset = NULL,\n");
+    }
+    fprintf(out, "    .data = g_%s_data,\n};\n", font->tag);
+
+    return desc->count + (packed ? (size_t)glyphs * 2 : 0) + (len ? len : 1) + FONT_STRUCT_SIZE;
+}
+
+/* 回读校验并测量主机端解码耗时，返回 0 表示一致 */
+static int verify_font(int index, const Font_Spec_t *font, const OLED_Font_t *desc, double *ns_per_glyph)
+{
+    uint8_t want[OLED_FONT_MAX_BYTES], got[OLED_FONT_MAX_BYTES];
+    struct timespec t0, t1;
+    unsigned long decoded = 0;
+    volatile uint8_t sink = 0;
+
+    for (int c = 0; c < 256; c++) {
+        uint8_t n = OLED_Font_Decode(desc, (uint8_t)c, got);
+
+        if (!font->used[c]) {
+            if (n != 0) {
+                fprintf(stderr, "%s: glyph 0x%02x decoded but not in charset\n", font->name, c);
+                return -1;
+            }
+            continue;
+        }
+        source_glyph(index, c - font->first, want);
+        if (n != font->width * font->pages || memcmp(want, got, n) != 0) {
+            fprintf(stderr, "%s: glyph 0x%02x round-trip mismatch\n", font->name, c);
+            return -1;
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int rep = 0; rep < 20000; rep++) {
+        for (int c = desc->first; c < desc->first + desc->count; c++) {
+            if (OLED_Font_Decode(desc, (uint8_t)c, got)) {
+                sink ^= got[0];
+                decoded++;
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    (void)sink;
+
+    *ns_per_glyph = decoded ? ((double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec)) / decoded
+                            : 0.0;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t data[FONT_COUNT][256 * OLED_FONT_MAX_BYTES + 256 * 4];
+    static uint16_t offset[FONT_COUNT][256];
+    static uint8_t map[FONT_COUNT][256];
+    OLED_Font_t desc[FONT_COUNT];
+    size_t gen_size[FONT_COUNT], src_total = 0, gen_total = 0;
+    const char *charset, *output;
+    int packed = 1, arg = 1;
+    FILE *out;
+
+    if (argc > 1 && strcmp(argv[1], "--raw") == 0) {
+        packed = 0;
+        arg++;
+    }
+    if (argc - arg != 2) {
+        fprintf(stderr, "usage: %s [--raw] <charset.txt> <oled_font_data.c>\n", argv[0]);
+        return 2;
+    }
+    charset = argv[arg];
+    output = argv[arg + 1];
+
+    if (parse_charset(charset) != 0) {
+        return 1;
+    }
+
+    out = fopen(output, "w");
+    if (out == NULL) {
+        perror(output);
+        return 1;
+    }
+    fprintf(out, "/*\n"
+                 "================================================================================\n"
+                 "oled_font_data.c - 子集字库，由 tools/fontgen 根据 charset.txt 生成，请勿手工修改\n"
+                 "================================================================================\n"
+                 "格式：%s\n*/\n"
+                 "#include \"oled_font.h\"\n"
+                 "#include <stddef.h>\n",
+            packed ? "非零字节掩码压缩（见 oled_font.h）" : "原始字模");
+
+    for (size_t i = 0; i < FONT_COUNT; i++) {
+        gen_size[i] = emit_font(out, &g_fonts[i], (int)i, packed, data[i], offset[i], map[i], &desc[i]);
+    }
+    fclose(out);
+
+    printf("%-14s %8s %8s %10s\n", "font", "source", "subset", "host ns/glyph");
+    for (size_t i = 0; i < FONT_COUNT; i++) {
+        double ns;
+
+        if (verify_font((int)i, &g_fonts[i], &desc[i], &ns) != 0) {
+            return 1;
+        }
+        printf("%-14s %7zuB %7zuB %10.1f\n", g_fonts[i].name, g_fonts[i].source_bytes, gen_size[i], ns);
+        src_total += g_fonts[i].source_bytes;
+        gen_total += gen_size[i];
+    }
+    printf("flash: %zu -> %zu bytes (%zu saved)\n", src_total, gen_total, src_total - gen_total);
+    return 0;
+}
@@ -0,0 +1,369 @@
+/*
+================================================================================
+heap_bench.c - 堆分配器对比：heap_4 与 TLSF 回放同一分配序列
+================================================================================
+编译（Linux）:
+  gcc -O2 -Ihost -I../../Core/Inc -o heap_bench heap_bench.c ../../Core/Src/tlsf.c \
+      ../../Middlewares/Third_Party/FreeRTOS/Source/portable/MemMang/heap_4.c
+  堆大小默认与 configTOTAL_HEAP_SIZE 相同（512），-DHEAP_BENCH_SIZE=4096 可改。
+  加 -m32 时 heap_4 的块头与目标板一样是 8 字节；64 位编译下它是 16 字节，
+  分配失败数会因此偏向 TLSF（TLSF 的块头与指针宽度无关，始终是 8 字节）。
+
+用法:
+  heap_bench [-n 次数] [-s 种子] [-w random|monitor] [heap.txt]
+    heap.txt 为 tracecv -m 从固件跟踪快照中导出的分配序列，按地址配对分配和
+    释放，整段回放 -n 次（默认 1），每次结束时释放仍未释放的块。省略时用合成负载：
+      random   大小 8..96 字节的随机分配/释放，平均占用约为堆的一半，默认 -n 100000 步
+      monitor  task_monitor.c 的模式：每个周期分配 7 个 TaskStatus_t 再释放
+    输出两个分配器的成功/失败次数（其中“碎片失败”是空闲总量够、但没有
+    一块放得下）、最少空闲、碎片率（1 - 最大空闲块 / 空闲总量，千分比）以及
+    每次分配/释放的耗时（主机纳秒，含计时本身约几十纳秒，只用于相对比较）。
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "tlsf.h"
+
+#define MONITOR_TASKS       7
+#define MONITOR_STATUS_SIZE 36          // 目标板上的 sizeof(TaskStatus_t)
+#define RANDOM_MAX_LIVE     256
+
+typedef struct {
+    char   kind;                        // 'm' 或 'f'
+    int    id;
+    size_t size;                        // 仅 'm'：请求字节数
+} Op_t;
+
+typedef struct {
+    const char *name;
+    size_t header;
+    void *(*alloc)(size_t size);
+    void (*release)(void *p);
+    void (*stats)(size_t *free_bytes, size_t *largest);
+} Heap_t;
+
+typedef struct {
+    unsigned long ok, failed, frag_failed;
+    size_t min_free, largest_end;
+    unsigned worst_frag;
+    double frag_sum;
+    unsigned long frag_samples;
+    double *t_alloc, *t_free;
+    size_t n_alloc, n_free;
+} Result_t;
+
+static Op_t *g_ops;
+static size_t g_nops, g_capops;
+static int g_nids;
+static uint8_t g_tlsf_mem[HEAP_BENCH_SIZE] __attribute__((aligned(8)));
+static Tlsf_t g_tlsf;
+
+/* heap_4（pvPortMalloc 等来自链接进来的 heap_4.c） -------------------------*/
+static void heap4_stats(size_t *free_bytes, size_t *largest)
+{
+    HeapStats_t s;
+
+    /* 10.3.1 的 heap_4 在没有空闲块时遍历越过 pxEnd，读空指针 */
+    if (xPortGetFreeHeapSize() == 0) {
+        *free_bytes = 0;
+        *largest = 0;
+        return;
+    }
+    vPortGetHeapStats(&s);
+    *free_bytes = s.xAvailableHeapSpaceInBytes;
+    *largest = s.xSizeOfLargestFreeBlockInBytes;
+}
+
+/* TLSF ---------------------------------------------------------------------*/
+static void *tlsf_alloc(size_t size)
+{
+    return Tlsf_Alloc(&g_tlsf, size);
+}
+
+static void tlsf_release(void *p)
+{
+    Tlsf_Free(&g_tlsf, p);
+}
+
+static void tlsf_stats(size_t *free_bytes, size_t *largest)
+{
+    Tlsf_Stats_t s;
+
+    Tlsf_GetStats(&g_tlsf, &s);
+    *free_bytes = s.free_bytes;
+    *largest = s.largest_free;
+}
+
+/* 负载 ---------------------------------------------------------------------*/
+static void push(char kind, int id, size_t size)
+{
+    if (g_nops == g_capops) {
+        g_capops = g_capops ? 2 * g_capops : 1024;
+        g_ops = realloc(g_ops, g_capops * sizeof(Op_t));
+    }
+    g_ops[g_nops].kind = kind;
+    g_ops[g_nops].id = id;
+    g_ops[g_nops].size = size;
+    g_nops++;
+}
+
+static uint32_t g_rng = 1;
+
+static uint32_t rnd(void)
+{
+    g_rng ^= g_rng << 13;
+    g_rng ^= g_rng >> 17;
+    g_rng ^= g_rng << 5;
+    return g_rng;
+}
+
+static void workload_random(long steps)
+{
+    int live[RANDOM_MAX_LIVE];
+    int nlive = 0;
+    /* 平均请求 52 字节加块头约 60 字节：存活块数在 target 附近时占用约为堆的一半 */
+    unsigned target = HEAP_BENCH_SIZE / 2 / 60;
+
+    if (target < 1) {
+        target = 1;
+    }
+    if (target > RANDOM_MAX_LIVE / 2) {
+        target = RANDOM_MAX_LIVE / 2;
+    }
+    for (long i = 0; i < steps; i++) {
+        /* 分配的概率随存活块数线性下降，在 target 处与释放持平 */
+        if (nlive == 0 || rnd() % (2 * target) >= (unsigned)nlive) {
+            live[nlive++] = g_nids;
+            push('m', g_nids++, 8 + rnd() % 89);
+        } else {
+            int k = (int)(rnd() % (unsigned)nlive);
+            push('f', live[k], 0);
+            live[k] = live[--nlive];
+        }
+    }
+    while (nlive > 0) {
+        push('f', live[--nlive], 0);
+    }
+}
+
+static void workload_monitor(long cycles)
+{
+    for (long i = 0; i < cycles; i++) {
+        push('m', g_nids, MONITOR_TASKS * MONITOR_STATUS_SIZE);
+        push('f', g_nids++, 0);
+    }
+}
+
+/* tracecv -m 的输出：m/f <地址/8> <块长>，块长含 8 字节块头 */
+static int workload_trace(const char *path, long repeat)
+{
+    static int live[65536];
+    char line[128];
+    FILE *in = fopen(path, "r");
+    unsigned long failed = 0;
+
+    if (in == NULL) {
+        perror(path);
+        return -1;
+    }
+    for (long r = 0; r < repeat; r++) {
+        memset(live, 0xFF, sizeof(live));
+        rewind(in);
+        while (fgets(line, sizeof(line), in) != NULL) {
+            char kind;
+            unsigned addr, size;
+
+            if (sscanf(line, "%c %u %u", &kind, &addr, &size) != 3 || addr > 0xFFFF) {
+                continue;
+            }
+            if (kind == 'm') {
+                if (addr == 0xFFFF) {
+                    failed++;           // 固件上就失败了，回放中不再尝试
+                    continue;
+                }
+                if (live[addr] >= 0) {
+                    push('f', live[addr], 0);    // 快照间隔里漏掉的释放
+                }
+                live[addr] = g_nids;
+                push('m', g_nids++, size > 8 ? size - 8 : 1);
+            } else if (kind == 'f' && live[addr] >= 0) {
+                push('f', live[addr], 0);
+                live[addr] = -1;
+            }
+        }
+        for (unsigned a = 0; a < 65536; a++) {
+            if (live[a] >= 0) {
+                push('f', live[a], 0);
+            }
+        }
+    }
+    fclose(in);
+    if (failed) {
+        printf("%lu allocation(s) failed on the device and are skipped\n", failed / (unsigned long)repeat);
+    }
+    return 0;
+}
+
+/* 回放 ---------------------------------------------------------------------*/
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void replay(const Heap_t *h, Result_t *res)
+{
+    void **ptr = calloc((size_t)g_nids + 1, sizeof(void *));
+    size_t free_bytes, largest;
+
+    memset(res, 0, sizeof(*res));
+    res->t_alloc = malloc(g_nops * sizeof(double));
+    res->t_free = malloc(g_nops * sizeof(double));
+    res->min_free = (size_t)-1;
+
+    for (size_t i = 0; i < g_nops; i++) {
+        const Op_t *op = &g_ops[i];
+        double t0, t1;
+
+        if (op->kind == 'm') {
+            t0 = now_ns();
+            ptr[op->id] = h->alloc(op->size);
+            t1 = now_ns();
+            res->t_alloc[res->n_alloc++] = t1 - t0;
+            if (ptr[op->id] != NULL) {
+                res->ok++;
+            } else {
+                h->stats(&free_bytes, &largest);
+                res->failed++;
+                if (free_bytes >= op->size + h->header) {
+                    res->frag_failed++;
+                }
+            }
+        } else if (ptr[op->id] != NULL) {
+            t0 = now_ns();
+            h->release(ptr[op->id]);
+            t1 = now_ns();
+            res->t_free[res->n_free++] = t1 - t0;
+            ptr[op->id] = NULL;
+        }
+
+        h->stats(&free_bytes, &largest);
+        if (free_bytes < res->min_free) {
+            res->min_free = free_bytes;
+        }
+        if (free_bytes > 0) {
+            unsigned frag = (unsigned)(1000 - largest * 1000 / free_bytes);
+            if (frag > res->worst_frag) {
+                res->worst_frag = frag;
+            }
+            res->frag_sum += frag;
+            res->frag_samples++;
+        }
+    }
+    h->stats(&free_bytes, &res->largest_end);
+    qsort(res->t_alloc, res->n_alloc, sizeof(double), cmp_double);
+    qsort(res->t_free, res->n_free, sizeof(double), cmp_double);
+    free(ptr);
+}
+
+static void print_times(const char *label, const Result_t *r, int alloc)
+{
+    const double *t = alloc ? r->t_alloc : r->t_free;
+    size_t n = alloc ? r->n_alloc : r->n_free;
+    double sum = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        sum += t[i];
+    }
+    if (n == 0) {
+        printf("  %-10s %8s\n", label, "-");
+        return;
+    }
+    printf("  %-10s %8.0f %8.0f %8.0f\n", label, sum / n, t[n * 99 / 100], t[n - 1]);
+}
+
+int main(int argc, char **argv)
+{
+    const char *workload = "random", *trace = NULL;
+    long count = -1;
+    Heap_t heaps[2] = {
+        { "heap_4", 0, pvPortMalloc, vPortFree, heap4_stats },
+        { "tlsf", TLSF_HEADER_SIZE, tlsf_alloc, tlsf_release, tlsf_stats },
+    };
+    Result_t res[2];
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            count = atol(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            g_rng = (uint32_t)strtoul(argv[++i], NULL, 0) | 1U;
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            workload = argv[++i];
+        } else if (argv[i][0] != '-') {
+            trace = argv[i];
+        } else {
+            fprintf(stderr, "usage: heap_bench [-n count] [-s seed] [-w random|monitor] [heap.txt]\n");
+            return 2;
+        }
+    }
+
+    if (trace != NULL) {
+        if (workload_trace(trace, count > 0 ? count : 1) != 0) {
+            return 1;
+        }
+        workload = trace;
+    } else if (strcmp(workload, "monitor") == 0) {
+        workload_monitor(count > 0 ? count : 10000);
+    } else if (strcmp(workload, "random") == 0) {
+        workload_random(count > 0 ? count : 100000);
+    } else {
+        fprintf(stderr, "heap_bench: unknown workload %s\n", workload);
+        return 2;
+    }
+
+    /* heap_4 的块头是 BlockLink_t 按 8 字节对齐；第一次分配时它才初始化 */
+    heaps[0].header = (sizeof(void *) + sizeof(size_t) + 7U) & ~(size_t)7U;
+    if (!Tlsf_Init(&g_tlsf, g_tlsf_mem, sizeof(g_tlsf_mem))) {
+        fprintf(stderr, "heap_bench: heap too small for TLSF\n");
+        return 1;
+    }
+
+    printf("workload %s: %zu ops, heap %d B, block header heap_4 %zu B / tlsf %d B\n",
+           workload, g_nops, HEAP_BENCH_SIZE, heaps[0].header, TLSF_HEADER_SIZE);
+    for (int h = 0; h < 2; h++) {
+        replay(&heaps[h], &res[h]);
+    }
+
+    printf("\n%-22s %12s %12s\n", "", heaps[0].name, heaps[1].name);
+    printf("%-22s %12lu %12lu\n", "allocations ok", res[0].ok, res[1].ok);
+    printf("%-22s %12lu %12lu\n", "allocations failed", res[0].failed, res[1].failed);
+    printf("%-22s %12lu %12lu\n", "  of which fragmented", res[0].frag_failed, res[1].frag_failed);
+    printf("%-22s %12zu %12zu\n", "min free (B)", res[0].min_free, res[1].min_free);
+    printf("%-22s %12.0f %12.0f\n", "mean fragmentation", res[0].frag_samples ? res[0].frag_sum / res[0].frag_samples : 0,
+           res[1].frag_samples ? res[1].frag_sum / res[1].frag_samples : 0);
+    printf("%-22s %12u %12u\n", "worst fragmentation", res[0].worst_frag, res[1].worst_frag);
+    printf("%-22s %12zu %12zu\n", "largest free at end", res[0].largest_end, res[1].largest_end);
+    printf("(fragmentation in permille: 1000 - 1000 * largest free block / total free)\n");
+
+    for (int h = 0; h < 2; h++) {
+        printf("\n%s time (ns)   mean      p99      max\n", heaps[h].name);
+        print_times("alloc", &res[h], 1);
+        print_times("free", &res[h], 0);
+        free(res[h].t_alloc);
+        free(res[h].t_free);
+    }
+    free(g_ops);
+    return 0;
+}
@@ -0,0 +1,48 @@
+/* heap_bench 主机端替身：只提供 heap_4.c 用到的配置和类型，单线程，不挂起调度器 */
+#ifndef __HOST_FREERTOS_H
+#define __HOST_FREERTOS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+#ifndef HEAP_BENCH_SIZE
+#define HEAP_BENCH_SIZE                     512     // 与 FreeRTOSConfig.h 的 configTOTAL_HEAP_SIZE 一致
+#endif
+
+#define configTOTAL_HEAP_SIZE               ((size_t)HEAP_BENCH_SIZE)
+#define configSUPPORT_DYNAMIC_ALLOCATION    1
+#define configAPPLICATION_ALLOCATED_HEAP    0
+#define configUSE_MALLOC_FAILED_HOOK        0
+#define configASSERT(x)                     assert(x)
+
+#define portBYTE_ALIGNMENT                  8
+#define portBYTE_ALIGNMENT_MASK             0x0007
+#define portPOINTER_SIZE_TYPE               uintptr_t
+#define portMAX_DELAY                       ((size_t)-1)
+
+#define PRIVILEGED_FUNCTION
+#define mtCOVERAGE_TEST_MARKER()
+#define traceMALLOC(pvAddress, uiSize)
+#define traceFREE(pvAddress, uiSize)
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+typedef struct xHeapStats
+{
+    size_t xAvailableHeapSpaceInBytes;
+    size_t xSizeOfLargestFreeBlockInBytes;
+    size_t xSizeOfSmallestFreeBlockInBytes;
+    size_t xNumberOfFreeBlocks;
+    size_t xMinimumEverFreeBytesRemaining;
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+} HeapStats_t;
+
+void *pvPortMalloc(size_t xSize);
+void vPortFree(void *pv);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+void vPortGetHeapStats(HeapStats_t *pxHeapStats);
+
+#endif /* __HOST_FREERTOS_H */
@@ -0,0 +1,8 @@
+/* heap_bench 主机端替身：单线程，挂起/恢复调度器为空操作 */
+#ifndef __HOST_TASK_H
+#define __HOST_TASK_H
+
+#define vTaskSuspendAll()                   ((void)0)
+#define xTaskResumeAll()                    ((void)0)
+
+#endif /* __HOST_TASK_H */
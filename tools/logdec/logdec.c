@@ -0,0 +1,276 @@
+/*
+================================================================================
+logdec.c - DLOG 二进制日志解码：从 ELF 的 .logstr 段还原格式串
+================================================================================
+编译（Linux）:
+  gcc -O2 -o logdec logdec.c
+
+用法:
+  logdec <ESP8266.elf> [capture.bin]
+    从 capture.bin（省略时为标准输入）读取 USART1 的原始字节流：普通文本原样
+    输出，DLOG 记录（以 0xFF 开头，格式见 Core/Inc/dlog.h）按 ELF 中的格式串
+    格式化，行首加 [秒.毫秒] 时间戳。事件跟踪快照的帧（以 0xFE 开头，见
+    Core/Inc/trace_recorder.h）跳过，用 tools/tracecv 处理。
+
+  实时查看:  stty -F /dev/ttyUSB0 115200 raw && logdec build/ESP8266.elf < /dev/ttyUSB0
+
+ELF 必须是设备上正在运行的那一版固件，格式串 ID 就是它在 .logstr 段内的偏移。
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define DLOG_SYNC           0xFF
+#define DLOG_MAX_ARGS       8
+#define DLOG_STR_MAX        15
+#define TRACE_SYNC          0xFE
+
+typedef struct {
+    uint8_t  ident[16];
+    uint16_t type, machine;
+    uint32_t version, entry, phoff, shoff, flags;
+    uint16_t ehsize, phentsize, phnum, shentsize, shnum, shstrndx;
+} Elf32_Ehdr;
+
+typedef struct {
+    uint32_t name, type, flags, addr, offset, size, link, info, addralign, entsize;
+} Elf32_Shdr;
+
+typedef struct {
+    uint32_t word;
+    char     str[DLOG_STR_MAX + 1];
+} Arg_t;
+
+static const char *g_strings = NULL;
+static uint32_t g_strings_size = 0;
+static int g_line_start = 1;
+
+static uint8_t *load(FILE *f, size_t *len)
+{
+    uint8_t *buf;
+    long n;
+
+    fseek(f, 0, SEEK_END);
+    n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((size_t)n);
+    if (buf != NULL && fread(buf, 1, (size_t)n, f) != (size_t)n) {
+        free(buf);
+        buf = NULL;
+    }
+    *len = (size_t)n;
+    return buf;
+}
+
+/* 找到 .logstr 段；它是 INFO 段，内容在文件里，地址为 0 */
+static int load_strings(const uint8_t *elf, size_t len)
+{
+    const Elf32_Ehdr *eh = (const Elf32_Ehdr *)elf;
+    const Elf32_Shdr *sh;
+    const char *names;
+
+    if (len < sizeof(Elf32_Ehdr) || memcmp(elf, "\177ELF\001\001", 6) != 0) {
+        return -1;
+    }
+    sh = (const Elf32_Shdr *)(elf + eh->shoff);
+    names = (const char *)(elf + sh[eh->shstrndx].offset);
+    for (int i = 0; i < eh->shnum; i++) {
+        if (strcmp(names + sh[i].name, ".logstr") == 0) {
+            g_strings = (const char *)(elf + sh[i].offset);
+            g_strings_size = sh[i].size;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void put_text(const char *s, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        if (s[i] == '\r') {
+            continue;
+        }
+        putchar(s[i]);
+        g_line_start = s[i] == '\n';
+    }
+}
+
+/* 按格式串输出一条记录；每个转换说明去掉长度修饰后交给 printf */
+static void format(const char *fmt, const Arg_t *args, int nargs)
+{
+    char spec[16], out[64];
+    int a = 0;
+
+    while (*fmt) {
+        const char *start = fmt;
+        size_t n = 0;
+
+        if (*fmt != '%') {
+            put_text(fmt++, 1);
+            continue;
+        }
+        fmt++;
+        if (*fmt == '%') {
+            put_text(fmt++, 1);
+            continue;
+        }
+
+        spec[n++] = '%';
+        while (*fmt && strchr("-+ #0123456789.", *fmt) && n < sizeof(spec) - 3) {
+            spec[n++] = *fmt++;
+        }
+        while (*fmt == 'l' || *fmt == 'h' || *fmt == 'z') {
+            fmt++;
+        }
+        if (*fmt == '\0') {
+            put_text(start, strlen(start));
+            break;
+        }
+        spec[n++] = *fmt;
+        spec[n] = '\0';
+
+        if (a >= nargs) {
+            n = (size_t)snprintf(out, sizeof(out), "<missing>");
+        } else if (*fmt == 's') {
+            n = (size_t)snprintf(out, sizeof(out), spec, args[a].str);
+        } else if (*fmt == 'd' || *fmt == 'i') {
+            n = (size_t)snprintf(out, sizeof(out), spec, (int32_t)args[a].word);
+        } else if (*fmt == 'c') {
+            n = (size_t)snprintf(out, sizeof(out), spec, (int)(char)args[a].word);
+        } else {
+            n = (size_t)snprintf(out, sizeof(out), spec, (uint32_t)args[a].word);
+        }
+        put_text(out, n < sizeof(out) ? n : sizeof(out) - 1);
+        a++;
+        fmt++;
+    }
+}
+
+static int get(FILE *in)
+{
+    return fgetc(in);
+}
+
+/* 跳过一帧跟踪快照（0xFE 已读掉）：u8 帧类型, u8 长度, 内容 */
+static int skip_trace_frame(FILE *in)
+{
+    int len;
+
+    if (get(in) == EOF || (len = get(in)) == EOF) {
+        return -1;
+    }
+    while (len-- > 0) {
+        if (get(in) == EOF) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* 读一条记录（0xFF 已读掉）；流在记录中间结束返回 -1 */
+static int record(FILE *in)
+{
+    Arg_t args[DLOG_MAX_ARGS];
+    uint8_t hdr[8];
+    uint32_t id, tick;
+    int nargs, mask, c;
+
+    for (int i = 0; i < 8; i++) {
+        if ((c = get(in)) == EOF) {
+            return -1;
+        }
+        hdr[i] = (uint8_t)c;
+    }
+    id = hdr[0] | (uint32_t)hdr[1] << 8;
+    tick = hdr[2] | (uint32_t)hdr[3] << 8 | (uint32_t)hdr[4] << 16 | (uint32_t)hdr[5] << 24;
+    nargs = hdr[6];
+    mask = hdr[7];
+    if (nargs > DLOG_MAX_ARGS) {
+        printf("\n** bad record (%d args)\n", nargs);
+        g_line_start = 1;
+        return 0;
+    }
+
+    for (int i = 0; i < nargs; i++) {
+        memset(&args[i], 0, sizeof(args[i]));
+        if (mask & (1 << i)) {
+            int len = get(in);
+            if (len == EOF || len > DLOG_STR_MAX) {
+                return -1;
+            }
+            for (int k = 0; k < len; k++) {
+                if ((c = get(in)) == EOF) {
+                    return -1;
+                }
+                args[i].str[k] = (char)c;
+            }
+        } else {
+            for (int k = 0; k < 4; k++) {
+                if ((c = get(in)) == EOF) {
+                    return -1;
+                }
+                args[i].word |= (uint32_t)c << (8 * k);
+            }
+        }
+    }
+
+    if (g_line_start) {
+        printf("[%6lu.%03lu] ", (unsigned long)(tick / 1000), (unsigned long)(tick % 1000));
+    }
+    if (id >= g_strings_size) {
+        printf("<unknown format id %lu>\n", (unsigned long)id);
+        g_line_start = 1;
+        return 0;
+    }
+    format(g_strings + id, args, nargs);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *f, *in = stdin;
+    uint8_t *elf;
+    size_t len;
+    int c;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <firmware.elf> [capture.bin]\n", argv[0]);
+        return 2;
+    }
+    f = fopen(argv[1], "rb");
+    elf = f != NULL ? load(f, &len) : NULL;
+    if (f != NULL) {
+        fclose(f);
+    }
+    if (elf == NULL || load_strings(elf, len) != 0) {
+        fprintf(stderr, "%s: not an ELF32 file with a .logstr section\n", argv[1]);
+        return 1;
+    }
+    if (argc > 2 && (in = fopen(argv[2], "rb")) == NULL) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    while ((c = get(in)) != EOF) {
+        if (c == DLOG_SYNC) {
+            if (record(in) != 0) {
+                printf("\n** capture ends inside a record\n");
+                break;
+            }
+        } else if (c == TRACE_SYNC) {
+            if (skip_trace_frame(in) != 0) {
+                break;
+            }
+        } else {
+            char ch = (char)c;
+            put_text(&ch, 1);
+        }
+        if (in == stdin) {
+            fflush(stdout);
+        }
+    }
+
+    free(elf);
+    return 0;
+}
@@ -0,0 +1,135 @@
+/*
+================================================================================
+metrics_dump.c - 解码设备在 MQTT_TOPIC_SYS 上发布的二进制指标报文
+================================================================================
+编译（Linux）:
+  gcc -O2 -I../../Core/Inc -o metrics_dump metrics_dump.c
+
+用法:
+  mosquitto_sub -h <broker> -t 'stm32/$SYS/metrics' -F %x | metrics_dump
+    每行一个十六进制报文（mosquitto_sub 的 %x 格式），逐行解码打印。
+
+指标名与直方图上界直接取自 Core/Inc/metrics_table.h，报文头中的 schema
+哈希与本程序编译时的表不一致时拒绝解码（固件和工具要用同一版表）。
+*/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include "metrics_table.h"
+
+#define MAX_PACKET          512
+
+#define NAME_COUNTER(obj)           #obj,
+#define NAME_GAUGE(obj)             #obj,
+#define NAME_HIST(obj, ...)         #obj,
+#define BOUNDS_HIST(obj, ...)       { __VA_ARGS__ },
+
+static const char *const g_counter_names[] = { METRICS_COUNTER_TABLE(NAME_COUNTER) };
+static const char *const g_gauge_names[] = { METRICS_GAUGE_TABLE(NAME_GAUGE) };
+static const char *const g_hist_names[] = { METRICS_HIST_TABLE(NAME_HIST) };
+static const uint32_t g_hist_bounds[METRIC_HIST_COUNT][METRICS_HIST_BOUNDS] = { METRICS_HIST_TABLE(BOUNDS_HIST) };
+
+/* 与 metrics.c 的 Metrics_Schema 相同：FNV-1a 折叠到 16 位 */
+static uint16_t schema(void)
+{
+    static const char text[] = METRICS_SCHEMA_TEXT;
+    uint32_t h = 2166136261UL;
+
+    for (const char *s = text; *s; s++) {
+        h = (h ^ (uint8_t)*s) * 16777619UL;
+    }
+    return (uint16_t)((h >> 16) ^ h);
+}
+
+static int get_var(const uint8_t **p, const uint8_t *end, uint32_t *v)
+{
+    *v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (*p == end) {
+            return -1;
+        }
+        *v |= (uint32_t)(**p & 0x7F) << shift;
+        if ((*(*p)++ & 0x80) == 0) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int decode(const uint8_t *buf, size_t len)
+{
+    const uint8_t *p = buf + 3, *end = buf + len;
+    uint32_t v;
+
+    if (len < 3 || buf[0] != METRICS_WIRE_VERSION) {
+        printf("unsupported packet (version %u)\n", len ? buf[0] : 0);
+        return -1;
+    }
+    if ((uint16_t)(buf[1] | (buf[2] << 8)) != schema()) {
+        printf("schema %04x does not match metrics_table.h (%04x), rebuild metrics_dump\n",
+               buf[1] | (buf[2] << 8), schema());
+        return -1;
+    }
+
+    if (get_var(&p, end, &v) != 0) {
+        goto truncated;
+    }
+    printf("seq %lu\n", (unsigned long)v);
+    for (int i = 0; i < METRIC_COUNTER_COUNT; i++) {
+        if (get_var(&p, end, &v) != 0) {
+            goto truncated;
+        }
+        printf("  %-20s %lu\n", g_counter_names[i], (unsigned long)v);
+    }
+    for (int i = 0; i < METRIC_GAUGE_COUNT; i++) {
+        if (get_var(&p, end, &v) != 0) {
+            goto truncated;
+        }
+        printf("  %-20s %ld\n", g_gauge_names[i], (long)(int32_t)((v >> 1) ^ (0U - (v & 1))));
+    }
+    for (int i = 0; i < METRIC_HIST_COUNT; i++) {
+        printf("  %-20s", g_hist_names[i]);
+        for (int b = 0; b <= METRICS_HIST_BOUNDS; b++) {
+            if (get_var(&p, end, &v) != 0) {
+                goto truncated;
+            }
+            if (b < METRICS_HIST_BOUNDS) {
+                printf(" <=%lu:%lu", (unsigned long)g_hist_bounds[i][b], (unsigned long)v);
+            } else {
+                printf(" >:%lu\n", (unsigned long)v);
+            }
+        }
+    }
+    return 0;
+
+truncated:
+    printf("\n  ** truncated packet\n");
+    return -1;
+}
+
+int main(void)
+{
+    char line[2 * MAX_PACKET + 16];
+    uint8_t buf[MAX_PACKET];
+    int failures = 0;
+
+    while (fgets(line, sizeof(line), stdin) != NULL) {
+        size_t len = 0;
+        unsigned byte;
+
+        for (const char *s = line; len < sizeof(buf) && isxdigit((unsigned char)s[0]) && isxdigit((unsigned char)s[1]); s += 2) {
+            if (sscanf(s, "%2x", &byte) != 1) {
+                break;
+            }
+            buf[len++] = (uint8_t)byte;
+        }
+        if (len == 0) {
+            continue;
+        }
+        if (decode(buf, len) != 0) {
+            failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,9 @@
+/* oled_emu 主机端替身：只提供 sensor.h 用到的类型 */
+#ifndef __HOST_FREERTOS_H
+#define __HOST_FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+
+#endif /* __HOST_FREERTOS_H */
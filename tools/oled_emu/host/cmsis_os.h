@@ -0,0 +1,13 @@
+/* oled_emu 主机端替身：仿真中没有调度器，延时立即返回 */
+#ifndef __HOST_CMSIS_OS_H
+#define __HOST_CMSIS_OS_H
+
+#include <stdint.h>
+
+static inline int osDelay(uint32_t ticks)
+{
+    (void)ticks;
+    return 0;
+}
+
+#endif /* __HOST_CMSIS_OS_H */
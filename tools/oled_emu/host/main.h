@@ -0,0 +1,12 @@
+/*
+ * oled_emu 主机端替身：代替 Core/Inc/main.h，不引入 FreeRTOS/ESP8266/MQTT。
+ * Core/Inc 下的头文件用 "main.h" 引用时会先找到同目录的真实 main.h，
+ * 所以本文件用 -include 预先包含，并沿用真实文件的包含保护宏使其被跳过。
+ */
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include "stm32f1xx_hal.h"
+#include "cmsis_os.h"
+
+#endif /* __MAIN_H */
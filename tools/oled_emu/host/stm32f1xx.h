@@ -0,0 +1,7 @@
+/* oled_emu 主机端替身：gpio_pin.hpp 只需要 GPIO 定义 */
+#ifndef __HOST_STM32F1XX_H
+#define __HOST_STM32F1XX_H
+
+#include "stm32f1xx_hal.h"
+
+#endif /* __HOST_STM32F1XX_H */
@@ -0,0 +1,188 @@
+/*
+================================================================================
+oled_emu.cpp - OLED 驱动主机端仿真：逐个 API 调用统计总线开销并导出画面
+================================================================================
+编译（Linux，软件 I2C 传输）:
+  g++ -O2 -std=gnu++17 -DGPIO_PIN_HOST -Ihost -I../../Core/Inc -include host/main.h -o oled_emu \
+      oled_emu.cpp ssd1306_emu.cpp ../../Core/Src/oled.cpp ../../Core/Src/soft_i2c.cpp \
+      -x c++ ../../Core/Src/oled_text.c ../../Core/Src/oled_font.c ../../Core/Src/oled_font_data.c \
+      ../../Core/Src/oled_spark.c
+
+用法:
+  oled_emu [outdir] [golden_dir]
+    运行固定的绘制场景，打印每个 API 调用的事务数/字节数/SCL 位时间；
+    给出 outdir 时每一帧写成 outdir/frame_NN.pbm；
+    给出 golden_dir 时与同名 PBM 逐像素比较，有差异则返回 1。
+
+  回归检查:   oled_emu "" golden
+  更新基准图: oled_emu golden（确认画面变化是预期的之后再提交）
+
+除 golden 比较外还做两项自检：总线上不能出现 NACK/线冲突；文本层增量刷新后
+的 GRAM 必须与清屏后整屏重绘的结果一致。
+*/
+#include "ssd1306_emu.h"
+#include "oled.h"
+#include "oled_text.h"
+#include "oled_spark.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BUS_BIT_US          10      // 100 kHz SCL
+
+static const char *g_outdir = NULL;
+static const char *g_golden = NULL;
+static int g_frame = 0;
+static int g_failures = 0;
+static int g_fields[4];
+
+static void report(const char *call)
+{
+    Emu_BusStats_t s;
+
+    Emu_GetStats(&s);
+    printf("%-34s %6lu %7lu %9lu %9lu.%03lu\n", call,
+           (unsigned long)s.transactions, (unsigned long)s.bytes, (unsigned long)s.bit_times,
+           (unsigned long)(s.bit_times * BUS_BIT_US / 1000), (unsigned long)(s.bit_times * BUS_BIT_US % 1000));
+    if (s.nacks || s.contention) {
+        printf("  ** %lu NACK, %lu line contention\n", (unsigned long)s.nacks, (unsigned long)s.contention);
+        g_failures++;
+    }
+    Emu_ResetStats();
+}
+
+static void frame(void)
+{
+    char name[256];
+    int diff;
+
+    g_frame++;
+    if (g_outdir != NULL) {
+        snprintf(name, sizeof(name), "%s/frame_%02d.pbm", g_outdir, g_frame);
+        if (Emu_WritePBM(name) != 0) {
+            g_failures++;
+        }
+    }
+    if (g_golden != NULL) {
+        snprintf(name, sizeof(name), "%s/frame_%02d.pbm", g_golden, g_frame);
+        diff = Emu_ComparePBM(name);
+        if (diff != 0) {
+            printf("  ** frame %02d: %s\n", g_frame, diff < 0 ? "golden missing" : "differs from golden");
+            g_failures++;
+        }
+    }
+}
+
+static void show_text(unsigned long temp, unsigned long humi, unsigned long cnt, unsigned long tick)
+{
+    char str[32];
+
+    snprintf(str, sizeof(str), "Temp: %lu \x7F""C", temp);
+    OLED_Text_Set((uint8_t)g_fields[0], str);
+    snprintf(str, sizeof(str), "Humi: %lu %%RH", humi);
+    OLED_Text_Set((uint8_t)g_fields[1], str);
+    snprintf(str, sizeof(str), "Cnt:%-5lu  %s", cnt, "ON");
+    OLED_Text_Set((uint8_t)g_fields[2], str);
+    snprintf(str, sizeof(str), "Tick: %lu", tick);
+    OLED_Text_Set((uint8_t)g_fields[3], str);
+    OLED_Text_Flush();
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t snapshot[EMU_PAGES][EMU_WIDTH];
+    History_Bucket_t spark[HISTORY_BUCKETS];
+    OLED_TextStats_t text;
+
+    g_outdir = argc > 1 && argv[1][0] ? argv[1] : NULL;
+    g_golden = argc > 2 ? argv[2] : NULL;
+
+    Emu_Reset();
+    printf("%-34s %6s %7s %9s %13s\n", "call", "xfers", "bytes", "bit-times", "ms@100kHz");
+
+    OLED_Init();
+    report("OLED_Init");
+    if (!Emu_DisplayOn()) {
+        printf("  ** display not switched on\n");
+        g_failures++;
+    }
+    frame();
+
+    for (int i = 0; i < 4; i++) {
+        g_fields[i] = OLED_Text_AddField(0, (uint8_t)(i * 2), 16, 16);
+    }
+
+    show_text(23, 45, 1, 1000);
+    report("text frame (first)");
+    frame();
+
+    show_text(23, 45, 2, 1100);
+    report("text frame (tick + counter)");
+    frame();
+
+    show_text(23, 45, 2, 1200);
+    report("text frame (tick only)");
+    frame();
+
+    show_text(23, 45, 2, 1200);
+    report("text frame (unchanged)");
+
+    OLED_Text_GetStats(&text);
+    printf("text layer: %lu cells drawn, %lu skipped, %lu bus bytes saved over %lu frames\n",
+           (unsigned long)text.cells_drawn, (unsigned long)text.cells_skipped,
+           (unsigned long)text.total_saved_bytes, (unsigned long)text.frames);
+
+    /* 自检：增量刷新的结果必须与清屏后整屏重绘一致 */
+    memcpy(snapshot, Emu_Gram(), sizeof(snapshot));
+    OLED_Clear();
+    OLED_Text_Invalidate();
+    show_text(23, 45, 2, 1200);
+    report("full redraw after OLED_Clear");
+    if (memcmp(snapshot, Emu_Gram(), sizeof(snapshot)) != 0) {
+        printf("  ** incremental frame differs from full redraw\n");
+        g_failures++;
+    }
+
+    OLED_ShowString(0, 6, (uint8_t *)"Cnt:7 45%RH", 16);   // 只用 charset.txt 收录的字符
+    OLED_Refresh();
+    report("OLED_ShowString + Refresh");
+    frame();
+
+    OLED_DrawPoint(127, 63, 1);
+    OLED_Refresh();
+    report("OLED_DrawPoint + Refresh");
+
+    OLED_Fill(32, 16, 95, 47, 1);
+    OLED_Refresh();
+    report("OLED_Fill 64x32 + Refresh");
+    frame();
+
+    OLED_WR_Byte(0xA6, OLED_CMD);
+    report("OLED_WR_Byte (single command)");
+
+    OLED_Clear();
+    OLED_Refresh();
+    report("OLED_Clear + Refresh");
+    frame();
+
+    /* 趋势图：32 个桶，含一段没有读数的空桶；换桶后整体左移一列，只应刷新一页 */
+    for (int i = 0; i < HISTORY_BUCKETS; i++) {
+        spark[i].min = (int8_t)(20 + (i % 8));
+        spark[i].max = (int8_t)(spark[i].min + (i % 3));
+    }
+    spark[10].min = INT8_MAX;
+    spark[10].max = INT8_MIN;
+    OLED_Spark_Draw(X_WIDTH - HISTORY_BUCKETS, 1, spark, HISTORY_BUCKETS);
+    OLED_Refresh();
+    report("OLED_Spark_Draw 32 buckets");
+    frame();
+
+    memmove(spark, spark + 1, sizeof(spark) - sizeof(spark[0]));
+    spark[HISTORY_BUCKETS - 1].min = 24;
+    spark[HISTORY_BUCKETS - 1].max = 24;
+    OLED_Spark_Draw(X_WIDTH - HISTORY_BUCKETS, 1, spark, HISTORY_BUCKETS);
+    OLED_Refresh();
+    report("OLED_Spark_Draw (next bucket)");
+
+    printf("%s\n", g_failures ? "FAIL" : "OK");
+    return g_failures ? 1 : 0;
+}
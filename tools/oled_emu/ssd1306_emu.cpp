@@ -0,0 +1,425 @@
+/*
+================================================================================
+ssd1306_emu.cpp - 主机端 I2C 总线解码器 + SSD1306 命令/GRAM 模型实现
+================================================================================
+线与模型：主机引脚为输出时驱动 ODR 电平（开漏输出高 = 释放），输入时释放；
+总线有上拉，从机只在 ACK 时钟拉低 SDA。每次引脚写入/模式切换后重新计算
+SCL/SDA，按电平变化解码：
+  SCL 高时 SDA 下降 -> START，SDA 上升 -> STOP；
+  SCL 上升沿采样数据位，第 8 个下降沿后从机应答，第 9 个下降沿后释放。
+*/
+#include "ssd1306_emu.h"
+#include "stm32f1xx_hal.h"
+#include "soft_i2c.h"
+#include <stdio.h>
+#include <string.h>
+
+uint32_t SystemCoreClock = 8000000U;    // 只影响 I2C_Delay_us 的空循环次数
+
+/* Private types -------------------------------------------------------------*/
+typedef struct {
+    uint16_t odr;
+    uint8_t  cfg[16];               // CRL/CRH 中的 4 位配置
+} Emu_Port_t;
+
+typedef enum {
+    BUS_IDLE = 0,
+    BUS_ADDR,
+    BUS_CONTROL,
+    BUS_CMD_STREAM,
+    BUS_DATA_STREAM,
+    BUS_CMD_SINGLE,                 // Co = 1：一个字节后回到控制字节
+    BUS_DATA_SINGLE,
+    BUS_IGNORE                      // 地址不匹配，直到 STOP
+} Emu_BusState_t;
+
+/* Private variables ---------------------------------------------------------*/
+static Emu_Port_t g_ports[2];       // GPIOA, GPIOB
+static uint8_t g_scl = 1, g_sda = 1;
+static uint8_t g_slave_low = 0;
+static uint8_t g_ack_phase = 0;
+static Emu_BusState_t g_bus = BUS_IDLE;
+static uint8_t g_bitcnt = 0;
+static uint8_t g_shift = 0;
+static Emu_BusStats_t g_stats;
+
+/* SSD1306 */
+static uint8_t g_gram[EMU_PAGES][EMU_WIDTH];
+static uint8_t g_on = 0;
+static uint8_t g_mode = 2;          // 0 水平, 1 垂直, 2 页寻址
+static uint8_t g_col = 0, g_page = 0;
+static uint8_t g_col_start = 0, g_col_end = EMU_WIDTH - 1;
+static uint8_t g_page_start = 0, g_page_end = EMU_PAGES - 1;
+static uint8_t g_cmd[8];
+static uint8_t g_cmd_len = 0, g_cmd_need = 0;
+
+/* Private functions ---------------------------------------------------------*/
+static Emu_Port_t *Emu_Port(uint32_t base)
+{
+    if (base == GPIOA_BASE) return &g_ports[0];
+    if (base == GPIOB_BASE) return &g_ports[1];
+    fprintf(stderr, "oled_emu: access to unmodelled GPIO port 0x%08lx\n", (unsigned long)base);
+    return &g_ports[1];
+}
+
+/* 主机是否主动驱动该引脚，以及驱动的电平 */
+static uint8_t Emu_PinDriven(const Emu_Port_t *p, uint8_t pin, uint8_t *level)
+{
+    uint8_t cfg = p->cfg[pin];
+    uint8_t odr = (p->odr >> pin) & 1U;
+
+    if ((cfg & 0x3) == 0) {
+        return 0;                   // 输入：释放，由上拉决定
+    }
+    if ((cfg & 0x4) && odr) {
+        return 0;                   // 开漏输出高：释放
+    }
+    *level = odr;
+    return 1;
+}
+
+static uint8_t Emu_LineSCL(void)
+{
+    uint8_t level = 1;
+    const Emu_Port_t *p = Emu_Port(I2C_SCL_GPIO_BASE);
+    return Emu_PinDriven(p, __builtin_ctz(I2C_SCL_Pin), &level) ? level : 1;
+}
+
+static uint8_t Emu_LineSDA(void)
+{
+    uint8_t level = 1;
+    const Emu_Port_t *p = Emu_Port(I2C_SDA_GPIO_BASE);
+    uint8_t driven = Emu_PinDriven(p, __builtin_ctz(I2C_SDA_Pin), &level);
+
+    if (g_slave_low) {
+        if (driven && level) {
+            g_stats.contention++;
+        }
+        return 0;
+    }
+    return driven ? level : 1;
+}
+
+static uint8_t Emu_CmdParams(uint8_t c)
+{
+    switch (c) {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD8: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void Emu_ExecCmd(const uint8_t *c)
+{
+    if (c[0] <= 0x0F) {
+        g_col = (uint8_t)((g_col & 0xF0) | (c[0] & 0x0F));
+    } else if (c[0] <= 0x1F) {
+        g_col = (uint8_t)((g_col & 0x0F) | ((c[0] & 0x0F) << 4));
+    } else if (c[0] >= 0xB0 && c[0] <= 0xB7) {
+        g_page = c[0] & 0x07;
+    } else if (c[0] == 0xAE || c[0] == 0xAF) {
+        g_on = c[0] & 1U;
+    } else if (c[0] == 0x20) {
+        g_mode = c[1] & 0x03;
+    } else if (c[0] == 0x21) {
+        g_col_start = c[1] & 0x7F;
+        g_col_end = c[2] & 0x7F;
+        g_col = g_col_start;
+    } else if (c[0] == 0x22) {
+        g_page_start = c[1] & 0x07;
+        g_page_end = c[2] & 0x07;
+        g_page = g_page_start;
+    }
+    g_col &= EMU_WIDTH - 1;
+}
+
+static void Emu_Command(uint8_t b)
+{
+    g_stats.cmd_bytes++;
+    g_cmd[g_cmd_len++] = b;
+    if (g_cmd_len == 1) {
+        g_cmd_need = Emu_CmdParams(b);
+    }
+    if (g_cmd_len > g_cmd_need) {
+        Emu_ExecCmd(g_cmd);
+        g_cmd_len = 0;
+    }
+}
+
+static void Emu_Data(uint8_t b)
+{
+    g_stats.data_bytes++;
+    g_gram[g_page][g_col] = b;
+
+    if (g_mode == 0) {
+        if (++g_col > g_col_end) {
+            g_col = g_col_start;
+            if (++g_page > g_page_end) g_page = g_page_start;
+        }
+    } else if (g_mode == 1) {
+        if (++g_page > g_page_end) {
+            g_page = g_page_start;
+            if (++g_col > g_col_end) g_col = g_col_start;
+        }
+    } else {
+        if (++g_col >= EMU_WIDTH) g_col = g_col_start;
+    }
+}
+
+/* 一个完整字节，返回从机是否应答 */
+static uint8_t Emu_Byte(uint8_t b)
+{
+    g_stats.bytes++;
+
+    switch (g_bus) {
+    case BUS_ADDR:
+        if (b != EMU_I2C_ADDR) {
+            g_stats.nacks++;
+            g_bus = BUS_IGNORE;
+            return 0;
+        }
+        g_bus = BUS_CONTROL;
+        return 1;
+    case BUS_CONTROL:
+        if (b & 0x80) {
+            g_bus = (b & 0x40) ? BUS_DATA_SINGLE : BUS_CMD_SINGLE;
+        } else {
+            g_bus = (b & 0x40) ? BUS_DATA_STREAM : BUS_CMD_STREAM;
+        }
+        return 1;
+    case BUS_CMD_SINGLE:
+        Emu_Command(b);
+        g_bus = BUS_CONTROL;
+        return 1;
+    case BUS_DATA_SINGLE:
+        Emu_Data(b);
+        g_bus = BUS_CONTROL;
+        return 1;
+    case BUS_CMD_STREAM:
+        Emu_Command(b);
+        return 1;
+    case BUS_DATA_STREAM:
+        Emu_Data(b);
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/* 引脚状态变化后重新计算总线电平并解码 */
+static void Emu_Update(void)
+{
+    uint8_t scl = Emu_LineSCL();
+    uint8_t sda = Emu_LineSDA();
+
+    if (scl == g_scl && sda != g_sda && scl) {
+        if (!sda) {
+            /* START / 重复起始 */
+            g_stats.transactions++;
+            g_bus = BUS_ADDR;
+            g_cmd_len = 0;
+        } else if (g_bus != BUS_IDLE) {
+            /* STOP：事务结束 */
+            g_bus = BUS_IDLE;
+        }
+        g_bitcnt = 0;
+        g_shift = 0;
+        g_ack_phase = 0;
+        g_slave_low = 0;
+    } else if (scl && !g_scl) {
+        if (g_bus != BUS_IDLE) {
+            g_stats.bit_times++;
+            if (!g_ack_phase && g_bitcnt < 8) {
+                g_shift = (uint8_t)((g_shift << 1) | sda);
+                g_bitcnt++;
+            }
+        }
+    } else if (!scl && g_scl && g_bus != BUS_IDLE) {
+        if (g_ack_phase) {
+            g_ack_phase = 0;
+            g_slave_low = 0;
+            g_bitcnt = 0;
+            g_shift = 0;
+        } else if (g_bitcnt == 8) {
+            g_ack_phase = 1;
+            g_slave_low = Emu_Byte(g_shift);
+        }
+        sda = Emu_LineSDA();
+    }
+
+    g_scl = scl;
+    g_sda = sda;
+}
+
+/* Host hooks (gpio_pin.hpp) -------------------------------------------------*/
+extern "C" void Host_GPIO_Write(uint32_t port, uint8_t pin, uint8_t level)
+{
+    Emu_Port_t *p = Emu_Port(port);
+
+    if (level) {
+        p->odr |= (uint16_t)(1U << pin);
+    } else {
+        p->odr &= (uint16_t)~(1U << pin);
+    }
+    Emu_Update();
+}
+
+extern "C" uint8_t Host_GPIO_Read(uint32_t port, uint8_t pin)
+{
+    if (port == I2C_SDA_GPIO_BASE && (1U << pin) == I2C_SDA_Pin) return Emu_LineSDA();
+    if (port == I2C_SCL_GPIO_BASE && (1U << pin) == I2C_SCL_Pin) return Emu_LineSCL();
+    return (Emu_Port(port)->odr >> pin) & 1U;
+}
+
+extern "C" void Host_GPIO_Config(uint32_t port, uint8_t pin, uint32_t cfg)
+{
+    Emu_Port(port)->cfg[pin] = (uint8_t)(cfg & 0xF);
+    Emu_Update();
+}
+
+/* HAL 替身 ------------------------------------------------------------------*/
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    uint32_t base = (uint32_t)(uintptr_t)GPIOx;
+
+    for (uint8_t pin = 0; pin < 16; pin++) {
+        uint32_t cfg;
+
+        if (!(GPIO_Init->Pin & (1U << pin))) {
+            continue;
+        }
+        if (GPIO_Init->Mode == GPIO_MODE_INPUT) {
+            cfg = GPIO_Init->Pull == GPIO_NOPULL ? 0x4 : 0x8;
+        } else {
+            cfg = (GPIO_Init->Mode == GPIO_MODE_OUTPUT_OD ? 0x4 : 0x0) | (GPIO_Init->Speed & 0x3);
+        }
+        Host_GPIO_Config(base, pin, cfg);
+        if (GPIO_Init->Mode == GPIO_MODE_INPUT && GPIO_Init->Pull != GPIO_NOPULL) {
+            Host_GPIO_Write(base, pin, GPIO_Init->Pull == GPIO_PULLUP);
+        }
+    }
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+    for (uint8_t pin = 0; pin < 16; pin++) {
+        if (GPIO_Pin & (1U << pin)) {
+            Host_GPIO_Write((uint32_t)(uintptr_t)GPIOx, pin, PinState == GPIO_PIN_SET);
+        }
+    }
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return Host_GPIO_Read((uint32_t)(uintptr_t)GPIOx, (uint8_t)__builtin_ctz(GPIO_Pin)) ? GPIO_PIN_SET
+                                                                                         : GPIO_PIN_RESET;
+}
+
+/* Public functions ----------------------------------------------------------*/
+void Emu_Reset(void)
+{
+    memset(g_ports, 0, sizeof(g_ports));
+    for (uint8_t i = 0; i < 2; i++) {
+        memset(g_ports[i].cfg, 0x4, sizeof(g_ports[i].cfg));   // 复位后为浮空输入
+    }
+    g_scl = 1;
+    g_sda = 1;
+    g_slave_low = 0;
+    g_ack_phase = 0;
+    g_bus = BUS_IDLE;
+    g_bitcnt = 0;
+    g_shift = 0;
+
+    memset(g_gram, 0, sizeof(g_gram));
+    g_on = 0;
+    g_mode = 2;
+    g_col = 0;
+    g_page = 0;
+    g_col_start = 0;
+    g_col_end = EMU_WIDTH - 1;
+    g_page_start = 0;
+    g_page_end = EMU_PAGES - 1;
+    g_cmd_len = 0;
+
+    Emu_ResetStats();
+}
+
+void Emu_GetStats(Emu_BusStats_t *stats)
+{
+    *stats = g_stats;
+}
+
+void Emu_ResetStats(void)
+{
+    memset(&g_stats, 0, sizeof(g_stats));
+}
+
+const uint8_t (*Emu_Gram(void))[EMU_WIDTH]
+{
+    return g_gram;
+}
+
+uint8_t Emu_DisplayOn(void)
+{
+    return g_on;
+}
+
+static uint8_t Emu_Pixel(uint8_t x, uint8_t y)
+{
+    return (g_gram[y / 8][x] >> (y % 8)) & 1U;
+}
+
+int Emu_WritePBM(const char *path)
+{
+    FILE *f = fopen(path, "w");
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    fprintf(f, "P1\n%d %d\n", EMU_WIDTH, EMU_PAGES * 8);
+    for (uint8_t y = 0; y < EMU_PAGES * 8; y++) {
+        for (uint8_t x = 0; x < EMU_WIDTH; x++) {
+            fputc(Emu_Pixel(x, y) ? '1' : '0', f);
+        }
+        fputc('\n', f);
+    }
+    fclose(f);
+    return 0;
+}
+
+int Emu_ComparePBM(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    int w, h, diff = 0;
+
+    if (f == NULL || fscanf(f, "P1 %d %d", &w, &h) != 2 || w != EMU_WIDTH || h != EMU_PAGES * 8) {
+        if (f != NULL) fclose(f);
+        return -1;
+    }
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int c;
+            do {
+                c = fgetc(f);
+            } while (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+            if (c == EOF) {
+                fclose(f);
+                return -1;
+            }
+            if ((c == '1') != (Emu_Pixel((uint8_t)x, (uint8_t)y) != 0)) {
+                diff++;
+            }
+        }
+    }
+    fclose(f);
+    return diff;
+}
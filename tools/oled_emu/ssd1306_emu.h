@@ -0,0 +1,47 @@
+/*
+================================================================================
+ssd1306_emu.h - 主机端 I2C 总线解码器 + SSD1306 命令/GRAM 模型
+================================================================================
+GPIO 写操作（Pin<> 模板的 Host_GPIO_* 钩子和 HAL_GPIO_* 替身）驱动一个
+开漏线与模型：SCL/SDA 的电平变化被解码为 START/STOP/字节/ACK，地址匹配的
+字节流送入 SSD1306 模型，更新 128x64 GRAM。
+*/
+#ifndef __SSD1306_EMU_H
+#define __SSD1306_EMU_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define EMU_WIDTH           128
+#define EMU_PAGES           8
+#define EMU_I2C_ADDR        0x78    // 8 位写地址（0x3C << 1）
+
+/* 总线统计：bytes 含地址和控制字节；bit_times 为事务期间的 SCL 时钟数（每字节 9 个，STOP 1 个） */
+typedef struct {
+    uint32_t transactions;          // START 次数（含重复起始）
+    uint32_t bytes;
+    uint32_t bit_times;
+    uint32_t nacks;
+    uint32_t contention;            // 从机拉低 ACK 时主机仍推挽输出高电平
+    uint32_t data_bytes;            // 写入 GRAM 的字节数
+    uint32_t cmd_bytes;
+} Emu_BusStats_t;
+
+/* 复位总线和屏幕模型（GRAM 清零、显示关闭、页寻址模式） */
+void Emu_Reset(void);
+
+/* 读取/清零总线统计 */
+void Emu_GetStats(Emu_BusStats_t *stats);
+void Emu_ResetStats(void);
+
+/* GRAM：gram[page][column]，每字节 8 个像素，LSB 在上 */
+const uint8_t (*Emu_Gram(void))[EMU_WIDTH];
+uint8_t Emu_DisplayOn(void);
+
+/* 把 GRAM 写成 PBM（P1，亮像素为 1），返回 0 成功 */
+int Emu_WritePBM(const char *path);
+
+/* 读取 PBM 并与当前 GRAM 比较，返回不同的像素数，文件错误返回 -1 */
+int Emu_ComparePBM(const char *path);
+
+#endif /* __SSD1306_EMU_H */
@@ -0,0 +1,229 @@
+/*
+================================================================================
+ram_report.c - 链接后 RAM 占用报告：按对象列出 RTOS 静态内存及其余大块变量
+================================================================================
+编译（Linux）:
+  gcc -O2 -o ram_report ram_report.c
+
+用法:
+  ram_report <ESP8266.elf> [ram_kb]
+
+读取 ELF 符号表：
+  - rtos_<类别>_<对象名> 符号（rtos_objects.c 按表生成）按对象汇总，
+    一个任务 = tcb + stack，一个队列 = qcb + qbuf，内存池 = pool + pblk，
+    定时器 = timer + timercb；
+  - 其余 RAM 变量按大小列出前 TOP_OTHERS 个；
+  - 可写的分配段（.data/.bss/._user_heap_stack）求和，与 ram_kb（默认 20）比较。
+只依赖 ELF32 小端格式，不需要交叉工具链的 nm/size。
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define RAM_BASE            0x20000000UL
+#define TOP_OTHERS          12
+#define MAX_OBJECTS         64
+
+#define SHT_SYMTAB          2
+#define SHF_WRITE           0x1
+#define SHF_ALLOC           0x2
+#define STT_OBJECT          1
+
+typedef struct {
+    uint8_t  ident[16];
+    uint16_t type, machine;
+    uint32_t version, entry, phoff, shoff, flags;
+    uint16_t ehsize, phentsize, phnum, shentsize, shnum, shstrndx;
+} Elf32_Ehdr;
+
+typedef struct {
+    uint32_t name, type, flags, addr, offset, size, link, info, addralign, entsize;
+} Elf32_Shdr;
+
+typedef struct {
+    uint32_t name, value, size;
+    uint8_t  info, other;
+    uint16_t shndx;
+} Elf32_Sym;
+
+typedef struct {
+    char     name[48];
+    const char *kind;
+    uint32_t bytes;
+    uint32_t parts[2];              /* 控制块 / 栈或缓冲 */
+} Object_t;
+
+typedef struct {
+    const char *name;
+    uint32_t    size;
+} Symbol_t;
+
+/* rtos_<prefix>_<对象> -> 对象类别，part 0 为控制块，1 为栈/消息缓冲 */
+static const struct {
+    const char *prefix;
+    const char *kind;
+    int         part;
+} g_kinds[] = {
+    { "rtos_tcb_",     "task",  0 },
+    { "rtos_stack_",   "task",  1 },
+    { "rtos_qcb_",     "queue", 0 },
+    { "rtos_qbuf_",    "queue", 1 },
+    { "rtos_pool_",    "pool",  0 },
+    { "rtos_pblk_",    "pool",  1 },
+    { "rtos_mutex_",   "mutex", 0 },
+    { "rtos_sem_",     "sem",   0 },
+    { "rtos_timer_",   "timer", 0 },
+    { "rtos_timercb_", "timer", 1 },
+};
+
+static Object_t g_objects[MAX_OBJECTS];
+static int g_object_count = 0;
+
+static uint8_t *load(const char *path, size_t *len)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+    long n;
+
+    if (f == NULL) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    n = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((size_t)n);
+    if (buf != NULL && fread(buf, 1, (size_t)n, f) != (size_t)n) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    *len = (size_t)n;
+    return buf;
+}
+
+static void add_rtos(const char *sym, uint32_t size)
+{
+    for (size_t k = 0; k < sizeof(g_kinds) / sizeof(g_kinds[0]); k++) {
+        size_t plen = strlen(g_kinds[k].prefix);
+        Object_t *o = NULL;
+
+        if (strncmp(sym, g_kinds[k].prefix, plen) != 0) {
+            continue;
+        }
+
+        for (int i = 0; i < g_object_count; i++) {
+            if (strcmp(g_objects[i].name, sym + plen) == 0 && strcmp(g_objects[i].kind, g_kinds[k].kind) == 0) {
+                o = &g_objects[i];
+            }
+        }
+        if (o == NULL) {
+            if (g_object_count == MAX_OBJECTS) {
+                return;
+            }
+            o = &g_objects[g_object_count++];
+            snprintf(o->name, sizeof(o->name), "%s", sym + plen);
+            o->kind = g_kinds[k].kind;
+        }
+        o->parts[g_kinds[k].part] += size;
+        o->bytes += size;
+        return;
+    }
+}
+
+static int cmp_size(const void *a, const void *b)
+{
+    const Symbol_t *x = a, *y = b;
+    return x->size < y->size ? 1 : x->size > y->size ? -1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    const Elf32_Ehdr *eh;
+    const Elf32_Shdr *sh;
+    Symbol_t *others = NULL;
+    size_t len, other_count = 0;
+    uint32_t ram = 20 * 1024, used = 0, rtos = 0, heap = 0, other_total = 0;
+    uint8_t *elf;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <firmware.elf> [ram_kb]\n", argv[0]);
+        return 2;
+    }
+    if (argc > 2) {
+        ram = (uint32_t)strtoul(argv[2], NULL, 0) * 1024;
+    }
+
+    elf = load(argv[1], &len);
+    if (elf == NULL || len < sizeof(Elf32_Ehdr) || memcmp(elf, "\177ELF\001\001", 6) != 0) {
+        fprintf(stderr, "%s: not a little-endian ELF32 file\n", argv[1]);
+        return 1;
+    }
+    eh = (const Elf32_Ehdr *)elf;
+    sh = (const Elf32_Shdr *)(elf + eh->shoff);
+
+    /* RAM 中的可写分配段 */
+    for (int i = 0; i < eh->shnum; i++) {
+        if ((sh[i].flags & (SHF_ALLOC | SHF_WRITE)) == (SHF_ALLOC | SHF_WRITE) && sh[i].addr >= RAM_BASE) {
+            used += sh[i].size;
+        }
+    }
+
+    for (int i = 0; i < eh->shnum; i++) {
+        const Elf32_Sym *sym;
+        const char *str;
+        uint32_t n;
+
+        if (sh[i].type != SHT_SYMTAB) {
+            continue;
+        }
+        sym = (const Elf32_Sym *)(elf + sh[i].offset);
+        str = (const char *)(elf + sh[sh[i].link].offset);
+        n = sh[i].size / sizeof(Elf32_Sym);
+        others = calloc(n, sizeof(Symbol_t));
+        if (others == NULL) {
+            return 1;
+        }
+
+        for (uint32_t s = 0; s < n; s++) {
+            const char *name = str + sym[s].name;
+
+            if ((sym[s].info & 0xF) != STT_OBJECT || sym[s].size == 0 || sym[s].value < RAM_BASE) {
+                continue;
+            }
+            if (strncmp(name, "rtos_", 5) == 0) {
+                add_rtos(name, sym[s].size);
+                rtos += sym[s].size;
+            } else if (strcmp(name, "ucHeap") == 0) {
+                heap = sym[s].size;
+            } else {
+                others[other_count].name = name;
+                others[other_count].size = sym[s].size;
+                other_total += sym[s].size;
+                other_count++;
+            }
+        }
+    }
+
+    printf("%-20s %-6s %7s %9s %9s\n", "object", "kind", "bytes", "cb", "stack/buf");
+    for (int i = 0; i < g_object_count; i++) {
+        const Object_t *o = &g_objects[i];
+        printf("%-20s %-6s %7lu %9lu %9lu\n", o->name, o->kind, (unsigned long)o->bytes,
+               (unsigned long)o->parts[0], (unsigned long)o->parts[1]);
+    }
+    printf("%-27s %7lu\n\n", "RTOS static objects", (unsigned long)rtos);
+
+    qsort(others, other_count, sizeof(Symbol_t), cmp_size);
+    for (size_t i = 0; i < other_count && i < TOP_OTHERS; i++) {
+        printf("%-27s %7lu\n", others[i].name, (unsigned long)others[i].size);
+    }
+    printf("%-27s %7lu (%lu symbols)\n", "other variables", (unsigned long)other_total, (unsigned long)other_count);
+    printf("%-27s %7lu\n", "FreeRTOS heap (ucHeap)", (unsigned long)heap);
+    printf("%-27s %7lu\n\n", "heap/stack reserve + pad", (unsigned long)(used - rtos - heap - other_total));
+    printf("RAM used %lu / %lu bytes, %lu free\n", (unsigned long)used, (unsigned long)ram,
+           used <= ram ? (unsigned long)(ram - used) : 0UL);
+
+    free(others);
+    free(elf);
+    return used <= ram ? 0 : 1;
+}
@@ -0,0 +1,460 @@
+/*
+================================================================================
+stack_report.c - 任务栈静态分析：调用图最坏深度 vs 配置栈大小 vs 运行时高水位
+================================================================================
+编译（Linux）:
+  gcc -O2 -o stack_report stack_report.c
+
+用法:
+  cmake -DSTACK_USAGE=ON ... && cmake --build <build> --target stack_report
+  或手动:  stack_report [-r monitor.log] <源码根目录> <构建目录>
+
+STACK_USAGE=ON 时每个源文件用 -fstack-usage -fcallgraph-info=su 编译（GCC 10
+以上），在构建目录里留下 .ci 调用图（VCG 格式，节点带本函数栈帧字节数）。本程序：
+  - 从 Core/Inc/rtos_objects.h 的 RTOS_TASK_TABLE 取每个任务的入口和栈（字），
+    另加 IDLE（prvIdleTask）和 Tmr Svc（prvTimerTask），栈取自 FreeRTOSConfig.h；
+  - 从入口沿调用图求最坏路径的栈深度，再加上切换任务时压栈的 16 个字
+    （硬件自动保存 8 个 + PendSV 保存 r4-r11）。外设中断用 MSP，不占任务栈；
+  - -r 给出监控任务的串口输出（logdec 还原后的文本）时，取每个任务 Stack
+    一列（uxTaskGetStackHighWaterMark，剩余字数）的最小值，换算成实际用量。
+建议值 = max(静态, 运行时) 加 20% 余量，按 8 字对齐。
+
+静态结果是下限：没有 .ci 的函数（newlib、libgcc）按 0 计并列为 unknown，
+函数指针调用（定时器回调、HAL 回调）列为 indirect，递归和变长栈帧单独标出。
+任何任务的静态深度超过配置栈时返回 1。
+*/
+#define _XOPEN_SOURCE 700
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <ftw.h>
+
+#define MAX_TASKS           16
+#define CTX_BYTES           (16 * 4)
+#define MARGIN_PERCENT      20
+#define MAX_UNKNOWN_SHOWN   6
+
+typedef struct Node Node_t;
+
+typedef struct Edge {
+    Node_t      *to;
+    struct Edge *next;
+} Edge_t;
+
+struct Node {
+    char    *title;
+    int      bytes;             // 本函数栈帧，-1 表示没有定义（无 .ci）
+    int      dynamic;           // 栈帧含 alloca/变长数组
+    Edge_t  *calls;
+    Node_t  *hash_next;
+    /* 求深度时的状态 */
+    int      state;             // 0 未访问，1 访问中，2 已完成
+    long     worst;
+    Node_t  *worst_child;
+    int      recursive;
+};
+
+typedef struct {
+    char  name[32];
+    char  entry[64];
+    long  words;
+    long  hwm;                  // 运行时最小剩余字数，-1 表示没有数据
+} Task_t;
+
+static Node_t *g_hash[4096];
+static Task_t g_tasks[MAX_TASKS];
+static int g_task_count = 0;
+static int g_ci_files = 0;
+
+/* 一次遍历中收集的问题 */
+static Node_t *g_unknown[256];
+static int g_unknown_count;
+static int g_indirect;
+static int g_recursion;
+static int g_dynamic;
+
+static unsigned hash(const char *s)
+{
+    unsigned h = 2166136261U;
+
+    while (*s) {
+        h = (h ^ (uint8_t)*s++) * 16777619U;
+    }
+    return h % (sizeof(g_hash) / sizeof(g_hash[0]));
+}
+
+static Node_t *node(const char *title)
+{
+    unsigned h = hash(title);
+    Node_t *n;
+
+    for (n = g_hash[h]; n != NULL; n = n->hash_next) {
+        if (strcmp(n->title, title) == 0) {
+            return n;
+        }
+    }
+    n = calloc(1, sizeof(Node_t));
+    n->title = strdup(title);
+    n->bytes = -1;
+    n->hash_next = g_hash[h];
+    g_hash[h] = n;
+    return n;
+}
+
+/* 按名字找函数定义：全局函数的 title 就是名字，static 函数为 "文件:名字" */
+static Node_t *find_function(const char *name)
+{
+    size_t len = strlen(name);
+
+    for (size_t h = 0; h < sizeof(g_hash) / sizeof(g_hash[0]); h++) {
+        for (Node_t *n = g_hash[h]; n != NULL; n = n->hash_next) {
+            size_t tl = strlen(n->title);
+
+            if (n->bytes >= 0 && (strcmp(n->title, name) == 0 ||
+                (tl > len && n->title[tl - len - 1] == ':' && strcmp(n->title + tl - len, name) == 0))) {
+                return n;
+            }
+        }
+    }
+    return NULL;
+}
+
+/* 取出 key: "..." 中的字符串，返回指向结尾引号之后的位置 */
+static const char *quoted(const char *line, const char *key, char *out, size_t size)
+{
+    const char *p = strstr(line, key);
+    size_t n = 0;
+
+    out[0] = '\0';
+    if (p == NULL || (p = strchr(p + strlen(key), '"')) == NULL) {
+        return NULL;
+    }
+    for (p++; *p && *p != '"'; p++) {
+        if (*p == '\\' && p[1] != '\0') {
+            out[n < size - 1 ? n++ : n] = *p++;
+        }
+        out[n < size - 1 ? n++ : n] = *p;
+    }
+    out[n] = '\0';
+    return *p ? p + 1 : p;
+}
+
+static void load_ci(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[2048], a[512], b[1024];
+
+    if (f == NULL) {
+        perror(path);
+        return;
+    }
+    g_ci_files++;
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (strncmp(line, "node:", 5) == 0) {
+            Node_t *n;
+            const char *s;
+
+            quoted(line, "title:", a, sizeof(a));
+            quoted(line, "label:", b, sizeof(b));
+            n = node(a);
+            /* label: "名字\n文件:行:列\nN bytes (static|dynamic|dynamic,bounded)" */
+            if ((s = strstr(b, " bytes (")) != NULL) {
+                const char *d = s;
+
+                while (d > b && isdigit((unsigned char)d[-1])) {
+                    d--;
+                }
+                n->bytes = atoi(d);
+                n->dynamic = strncmp(s + 8, "dynamic", 7) == 0 && strncmp(s + 8, "dynamic,bounded", 15) != 0;
+            }
+        } else if (strncmp(line, "edge:", 5) == 0) {
+            Node_t *from;
+            Edge_t *e;
+
+            quoted(line, "sourcename:", a, sizeof(a));
+            quoted(line, "targetname:", b, sizeof(b));
+            from = node(a);
+            e = calloc(1, sizeof(Edge_t));
+            e->to = node(b);
+            e->next = from->calls;
+            from->calls = e;
+        }
+    }
+    fclose(f);
+}
+
+static int walk_ci(const char *path, const struct stat *st, int type, struct FTW *ftw)
+{
+    size_t len = strlen(path);
+
+    (void)st;
+    (void)ftw;
+    if (type == FTW_F && len > 3 && strcmp(path + len - 3, ".ci") == 0) {
+        load_ci(path);
+    }
+    return 0;
+}
+
+/* 取 "#define <name>" 之后的第一个整数 */
+static long config_value(const char *path, const char *name)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+    long v = -1;
+
+    if (f == NULL) {
+        return -1;
+    }
+    while (v < 0 && fgets(line, sizeof(line), f) != NULL) {
+        const char *p = strstr(line, name);
+
+        if (strncmp(line, "#define", 7) == 0 && p != NULL && !isalnum((unsigned char)p[strlen(name)]) &&
+            p[strlen(name)] != '_') {
+            /* 跳过类型转换里的标识符，例如 ((uint16_t)128) */
+            for (p += strlen(name); *p && *p != '/'; p++) {
+                if (isdigit((unsigned char)*p) && !isalnum((unsigned char)p[-1]) && p[-1] != '_') {
+                    break;
+                }
+            }
+            if (isdigit((unsigned char)*p)) {
+                v = strtol(p, NULL, 0);
+            }
+        }
+    }
+    fclose(f);
+    return v;
+}
+
+static void add_task(const char *name, const char *entry, long words)
+{
+    Task_t *t;
+
+    if (g_task_count >= MAX_TASKS) {
+        return;
+    }
+    t = &g_tasks[g_task_count++];
+    snprintf(t->name, sizeof(t->name), "%s", name);
+    snprintf(t->entry, sizeof(t->entry), "%s", entry);
+    t->words = words;
+    t->hwm = -1;
+}
+
+/* 解析 RTOS_TASK_TABLE 中的 X(名称, 入口, 栈字数, 优先级) 行 */
+static int load_tasks(const char *root)
+{
+    char path[1024], line[512];
+    FILE *f;
+    int in_table = 0;
+    long v;
+
+    snprintf(path, sizeof(path), "%s/Core/Inc/rtos_objects.h", root);
+    if ((f = fopen(path, "r")) == NULL) {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char name[32], entry[64];
+        long words;
+
+        if (strstr(line, "#define RTOS_TASK_TABLE(X)") != NULL) {
+            in_table = 1;
+            continue;
+        }
+        if (!in_table) {
+            continue;
+        }
+        if (sscanf(line, " X(%31[^, ], %63[^, ], %ld", name, entry, &words) == 3) {
+            add_task(name, entry, words);
+        }
+        if (strchr(line, '\\') == NULL) {
+            break;
+        }
+    }
+    fclose(f);
+
+    snprintf(path, sizeof(path), "%s/Core/Inc/FreeRTOSConfig.h", root);
+    if ((v = config_value(path, "configMINIMAL_STACK_SIZE")) > 0) {
+        add_task("IDLE", "prvIdleTask", v);
+    }
+    if ((v = config_value(path, "configTIMER_TASK_STACK_DEPTH")) > 0) {
+        add_task("Tmr Svc", "prvTimerTask", v);
+    }
+    return g_task_count > 0 ? 0 : -1;
+}
+
+/* 监控输出的任务行："名称\t\t状态\t优先级\t剩余栈\t编号" */
+static void load_runtime(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+
+    if (f == NULL) {
+        perror(path);
+        return;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        char *p = strchr(line, ']');
+        char name[32], state;
+        int prio;
+        long hwm, num;
+
+        p = (line[0] == '[' && p != NULL) ? p + 1 : line;   // logdec 的 [秒.毫秒] 前缀
+        while (*p == ' ') {
+            p++;
+        }
+        if (sscanf(p, "%31[^\t]\t\t%c\t%d\t%ld\t%ld", name, &state, &prio, &hwm, &num) != 5) {
+            continue;
+        }
+        for (int i = 0; i < g_task_count; i++) {
+            if (strcmp(g_tasks[i].name, name) == 0 && (g_tasks[i].hwm < 0 || hwm < g_tasks[i].hwm)) {
+                g_tasks[i].hwm = hwm;
+            }
+        }
+    }
+    fclose(f);
+}
+
+static void note_unknown(Node_t *n)
+{
+    for (int i = 0; i < g_unknown_count; i++) {
+        if (g_unknown[i] == n) {
+            return;
+        }
+    }
+    if (g_unknown_count < (int)(sizeof(g_unknown) / sizeof(g_unknown[0]))) {
+        g_unknown[g_unknown_count++] = n;
+    }
+}
+
+static void reset(void)
+{
+    for (size_t h = 0; h < sizeof(g_hash) / sizeof(g_hash[0]); h++) {
+        for (Node_t *n = g_hash[h]; n != NULL; n = n->hash_next) {
+            n->state = 0;
+            n->worst = 0;
+            n->worst_child = NULL;
+            n->recursive = 0;
+        }
+    }
+    g_unknown_count = 0;
+    g_indirect = 0;
+    g_recursion = 0;
+    g_dynamic = 0;
+}
+
+/* 最坏深度 = 本帧 + 各被调函数最坏深度的最大值；回到访问中的节点即递归，按 0 计 */
+static long worst(Node_t *n)
+{
+    if (n->state == 2) {
+        return n->worst;
+    }
+    if (n->state == 1) {
+        n->recursive = 1;
+        g_recursion++;
+        return 0;
+    }
+    n->state = 1;
+    if (strcmp(n->title, "__indirect_call") == 0) {
+        g_indirect++;
+    } else if (n->bytes < 0) {
+        note_unknown(n);
+    }
+    if (n->dynamic) {
+        g_dynamic++;
+    }
+    for (Edge_t *e = n->calls; e != NULL; e = e->next) {
+        long w = worst(e->to);
+
+        if (e->to->state == 2 && (n->worst_child == NULL || w > n->worst)) {
+            n->worst = w;
+            n->worst_child = e->to;
+        }
+    }
+    n->worst += n->bytes > 0 ? n->bytes : 0;
+    n->state = 2;
+    return n->worst;
+}
+
+static const char *short_name(const char *title)
+{
+    const char *p = strrchr(title, ':');
+
+    return p != NULL ? p + 1 : title;
+}
+
+int main(int argc, char **argv)
+{
+    const char *runtime = NULL;
+    int argi = 1, over = 0;
+
+    if (argc > 2 && strcmp(argv[1], "-r") == 0) {
+        runtime = argv[2];
+        argi = 3;
+    }
+    if (argc - argi != 2) {
+        fprintf(stderr, "usage: %s [-r monitor.log] <source root> <build dir>\n", argv[0]);
+        return 2;
+    }
+    if (load_tasks(argv[argi]) != 0) {
+        fprintf(stderr, "%s: no RTOS_TASK_TABLE found\n", argv[argi]);
+        return 2;
+    }
+    nftw(argv[argi + 1], walk_ci, 16, FTW_PHYS);
+    if (g_ci_files == 0) {
+        fprintf(stderr, "%s: no .ci files; configure with -DSTACK_USAGE=ON and rebuild\n", argv[argi + 1]);
+        return 2;
+    }
+    if (runtime != NULL) {
+        load_runtime(runtime);
+    }
+
+    printf("%-16s %-22s %7s %7s %7s %7s %8s\n", "task", "entry", "config", "static", "runtime", "suggest", "");
+    printf("%-16s %-22s %7s %7s %7s %7s\n", "", "", "bytes", "bytes", "bytes", "words");
+    for (int i = 0; i < g_task_count; i++) {
+        Task_t *t = &g_tasks[i];
+        Node_t *entry = find_function(t->entry);
+        long config = t->words * 4, depth, used = -1, need, suggest;
+        char runtime_col[24];
+
+        if (entry == NULL) {
+            printf("%-16s %-22s %7ld  (entry not found in call graphs)\n", t->name, t->entry, config);
+            continue;
+        }
+        reset();
+        depth = worst(entry) + CTX_BYTES;
+        if (t->hwm >= 0) {
+            used = config - t->hwm * 4;
+        }
+        need = depth > used ? depth : used;
+        suggest = (need * (100 + MARGIN_PERCENT) / 100 + 31) / 32 * 8;
+        if (used >= 0) {
+            snprintf(runtime_col, sizeof(runtime_col), "%ld", used);
+        } else {
+            snprintf(runtime_col, sizeof(runtime_col), "-");
+        }
+        printf("%-16s %-22s %7ld %7ld %7s %7ld %8s\n", t->name, t->entry, config, depth, runtime_col, suggest,
+               depth > config ? "OVERFLOW" : (suggest < t->words ? "shrink" : ""));
+        if (depth > config) {
+            over = 1;
+        }
+
+        printf("    path:");
+        for (Node_t *n = entry; n != NULL; n = n->worst_child) {
+            printf(" %s(%d)%s", short_name(n->title), n->bytes > 0 ? n->bytes : 0, n->worst_child ? " >" : "");
+        }
+        printf("\n");
+        if (g_indirect || g_recursion || g_dynamic || g_unknown_count) {
+            printf("    lower bound: %d indirect, %d recursive, %d dynamic frame, %d unknown", g_indirect,
+                   g_recursion, g_dynamic, g_unknown_count);
+            for (int k = 0; k < g_unknown_count && k < MAX_UNKNOWN_SHOWN; k++) {
+                printf("%s%s", k == 0 ? " (" : ", ", short_name(g_unknown[k]->title));
+            }
+            printf("%s\n", g_unknown_count > MAX_UNKNOWN_SHOWN ? ", ...)" : (g_unknown_count ? ")" : ""));
+        }
+    }
+    printf("\nstatic = worst call path + %d bytes context frame; suggest = max(static, runtime) + %d%%\n",
+           CTX_BYTES, MARGIN_PERCENT);
+    return over;
+}
@@ -0,0 +1,464 @@
+/*
+================================================================================
+tracecv.c - 事件跟踪快照转换：串口流 -> Chrome 跟踪格式（JSON）
+================================================================================
+编译（Linux）:
+  gcc -O2 -I../../Core/Inc -o tracecv tracecv.c
+
+用法:
+  tracecv [-m heap.txt] [capture.bin] > trace.json
+    从 capture.bin（省略时为标准输入）读取 USART1 的原始字节流，取出其中的
+    跟踪快照帧（以 0xFE 开头，格式见 Core/Inc/trace_recorder.h），普通文本和
+    DLOG 记录跳过。每个快照输出为一个进程，用 chrome://tracing 或
+    https://ui.perfetto.dev 打开：
+      CPU        每段是当时在运行的任务
+      ISR        外设中断（嵌套显示）
+      <任务>     运行区间、进入就绪、延时、队列收发和阻塞
+      <任务> marks  代码中的 Trace_MarkStart/Stop 区间（如每条 AT 命令）
+    时间轴以毫秒 tick 为准，与 logdec 输出的 [秒.毫秒] 时间戳对齐。
+    -m heap.txt  另把快照中的堆分配/释放按顺序写成文本，供 tools/heap_bench 回放：
+                   m <地址/8> <块长>     （地址 65535 表示分配失败）
+                   f <地址/8> <块长>
+                 每个快照前有一行 "# snapshot N"。
+
+  抓取:  stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 > capture.bin
+固件需在 config.h 中打开 TRACE_RECORDER。
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "trace_recorder.h"
+
+#define DLOG_SYNC           0xFF
+#define DLOG_MAX_ARGS       8
+
+#define TID_ISR             0
+#define TID_CPU             9999
+#define TID_MARKS           1000            // + 任务号
+
+typedef struct {
+    uint32_t cycles;
+    uint8_t  type;
+    uint8_t  a;
+    uint16_t b;
+    uint8_t  raw[TRACE_RECORD_SIZE];
+} Record_t;
+
+typedef struct {
+    int      open;
+    uint32_t hz;
+    uint32_t freeze_cycles;
+    uint32_t freeze_tick;
+    uint32_t total;
+    uint32_t capacity;
+    char     task[256][32];
+    char     object[256][32];
+    Record_t *rec;
+    size_t   nrec;
+    size_t   cap;
+} Snapshot_t;
+
+#define NAME_MARK(obj)      #obj,
+static const char *const g_mark_names[] = { TRACE_MARK_TABLE(NAME_MARK) };
+
+/* STM32F103 的 IRQn */
+static const char *const g_irq_names[] = {
+    "WWDG", "PVD", "TAMPER", "RTC", "FLASH", "RCC", "EXTI0", "EXTI1", "EXTI2", "EXTI3", "EXTI4",
+    "DMA1_Channel1", "DMA1_Channel2", "DMA1_Channel3", "DMA1_Channel4", "DMA1_Channel5",
+    "DMA1_Channel6", "DMA1_Channel7", "ADC1_2", "USB_HP_CAN1_TX", "USB_LP_CAN1_RX0", "CAN1_RX1",
+    "CAN1_SCE", "EXTI9_5", "TIM1_BRK", "TIM1_UP", "TIM1_TRG_COM", "TIM1_CC", "TIM2", "TIM3", "TIM4",
+    "I2C1_EV", "I2C1_ER", "I2C2_EV", "I2C2_ER", "SPI1", "SPI2", "USART1", "USART2", "USART3",
+    "EXTI15_10", "RTC_Alarm", "USBWakeUp",
+};
+
+static Snapshot_t g_snap;
+static int g_pid = 0;
+static int g_first_event = 1;
+static FILE *g_heap_out = NULL;
+
+static uint32_t get32(const uint8_t *p)
+{
+    return p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+/* JSON 字符串内容（不含引号） */
+static void put_json(const char *s)
+{
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\') {
+            printf("\\%c", *s);
+        } else if ((unsigned char)*s < 0x20 || (unsigned char)*s >= 0x7F) {
+            printf("\\u%04x", (unsigned char)*s);
+        } else {
+            putchar(*s);
+        }
+    }
+}
+
+static void event_begin(void)
+{
+    printf(g_first_event ? "\n  " : ",\n  ");
+    g_first_event = 0;
+}
+
+static void meta(const char *what, int tid, const char *name)
+{
+    event_begin();
+    printf("{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"args\":{\"name\":\"", g_pid, tid, what);
+    put_json(name);
+    printf("\"}}");
+}
+
+static void sort_index(int tid, int index)
+{
+    event_begin();
+    printf("{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":%d}}",
+           g_pid, tid, index);
+}
+
+/* ph 为 B/E/i/X；dur < 0 表示没有持续时间；arg 为 NULL 表示没有参数 */
+static void emit(char ph, int tid, double ts, double dur, const char *name, const char *arg, long value)
+{
+    event_begin();
+    printf("{\"ph\":\"%c\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f", ph, g_pid, tid, ts);
+    if (dur >= 0) {
+        printf(",\"dur\":%.3f", dur);
+    }
+    if (ph == 'i') {
+        printf(",\"s\":\"t\"");
+    }
+    if (name != NULL) {
+        printf(",\"name\":\"");
+        put_json(name);
+        printf("\"");
+    }
+    if (arg != NULL) {
+        printf(",\"args\":{\"%s\":%ld}", arg, value);
+    }
+    printf("}");
+}
+
+static const char *task_name(int n)
+{
+    static char buf[16];
+
+    if (n >= 0 && g_snap.task[n][0] != '\0') {
+        return g_snap.task[n];
+    }
+    snprintf(buf, sizeof(buf), "task %d", n);
+    return buf;
+}
+
+static const char *object_name(int n)
+{
+    static char buf[16];
+
+    if (n == 0) {
+        return "kernel queue";
+    }
+    if (g_snap.object[n][0] != '\0') {
+        return g_snap.object[n];
+    }
+    snprintf(buf, sizeof(buf), "queue %d", n);
+    return buf;
+}
+
+static const char *irq_name(int exc)
+{
+    static char buf[16];
+
+    if (exc >= 16 && exc - 16 < (int)(sizeof(g_irq_names) / sizeof(g_irq_names[0]))) {
+        return g_irq_names[exc - 16];
+    }
+    snprintf(buf, sizeof(buf), "exception %d", exc);
+    return buf;
+}
+
+/* 把一个完整的快照输出为一个进程 */
+static void convert(void)
+{
+    double *ts;
+    uint64_t acc = 0, end_acc;
+    size_t last = (size_t)-1;
+    int cur = -1, isr_depth = 0;
+    int mark_depth[256] = { 0 };
+    double cur_start = 0, end_ts;
+    double mhz = g_snap.hz / 1e6;
+    char name[96];
+
+    if (g_snap.hz == 0) {
+        return;
+    }
+    g_pid++;
+    ts = calloc(g_snap.nrec + 1, sizeof(double));
+
+    /* 周期计数 32 位回绕，累加相邻记录的差值；冻结时刻对应 freeze_tick 毫秒 */
+    for (size_t i = 0; i < g_snap.nrec; i++) {
+        if (g_snap.rec[i].type == TRACE_EV_TEXT) {
+            continue;
+        }
+        if (last != (size_t)-1) {
+            acc += (uint32_t)(g_snap.rec[i].cycles - g_snap.rec[last].cycles);
+        }
+        ts[i] = (double)acc;
+        last = i;
+    }
+    end_acc = acc + (last != (size_t)-1 ? (uint32_t)(g_snap.freeze_cycles - g_snap.rec[last].cycles) : 0);
+    for (size_t i = 0; i < g_snap.nrec; i++) {
+        ts[i] = g_snap.freeze_tick * 1000.0 - ((double)end_acc - ts[i]) / mhz;
+    }
+    end_ts = g_snap.freeze_tick * 1000.0;
+
+    if (g_heap_out != NULL) {
+        fprintf(g_heap_out, "# snapshot %d\n", g_pid);
+    }
+    snprintf(name, sizeof(name), "snapshot %d @ %lu ms (%lu of %lu events)", g_pid,
+             (unsigned long)g_snap.freeze_tick, (unsigned long)g_snap.nrec, (unsigned long)g_snap.total);
+    meta("process_name", 0, name);
+    meta("thread_name", TID_CPU, "CPU");
+    sort_index(TID_CPU, -2);
+    meta("thread_name", TID_ISR, "ISR");
+    sort_index(TID_ISR, -1);
+    for (int n = 1; n < 256; n++) {
+        if (g_snap.task[n][0] != '\0') {
+            meta("thread_name", n, g_snap.task[n]);
+            snprintf(name, sizeof(name), "%s marks", g_snap.task[n]);
+            meta("thread_name", TID_MARKS + n, name);
+            sort_index(n, 2 * n);
+            sort_index(TID_MARKS + n, 2 * n + 1);
+        }
+    }
+
+    for (size_t i = 0; i < g_snap.nrec; i++) {
+        const Record_t *r = &g_snap.rec[i];
+        int tid = isr_depth > 0 ? TID_ISR : (cur >= 0 ? cur : TID_CPU);
+
+        switch (r->type) {
+        case TRACE_EV_SWITCH_IN:
+            if (cur >= 0) {
+                emit('X', cur, cur_start, ts[i] - cur_start, "running", NULL, 0);
+                emit('X', TID_CPU, cur_start, ts[i] - cur_start, task_name(cur), NULL, 0);
+            }
+            cur = r->a;
+            cur_start = ts[i];
+            break;
+        case TRACE_EV_READY:
+            emit('i', r->a, ts[i], -1, "ready", NULL, 0);
+            break;
+        case TRACE_EV_DELAY:
+            emit('i', r->a, ts[i], -1, "delay", NULL, 0);
+            break;
+        case TRACE_EV_ISR_ENTER:
+            emit('B', TID_ISR, ts[i], -1, irq_name(r->a), NULL, 0);
+            isr_depth++;
+            break;
+        case TRACE_EV_ISR_EXIT:
+            if (isr_depth > 0) {                // 快照从中断中间开始时丢掉不配对的出口
+                emit('E', TID_ISR, ts[i], -1, NULL, NULL, 0);
+                isr_depth--;
+            }
+            break;
+        case TRACE_EV_QUEUE_SEND:
+        case TRACE_EV_QUEUE_SEND_FAILED:
+        case TRACE_EV_QUEUE_RECEIVE:
+        case TRACE_EV_QUEUE_RECEIVE_FAILED:
+        case TRACE_EV_QUEUE_BLOCK_SEND:
+        case TRACE_EV_QUEUE_BLOCK_RECEIVE: {
+            static const char *const op[] = { "send", "send failed", "receive", "receive failed",
+                                              "block on send", "block on receive" };
+            snprintf(name, sizeof(name), "%s %s", op[r->type - TRACE_EV_QUEUE_SEND], object_name(r->a));
+            emit('i', tid, ts[i], -1, name, "waiting", r->b);
+            break;
+        }
+        case TRACE_EV_MARK_START: {
+            char label[TRACE_LABEL_MAX + 1];
+            size_t n = 0;
+
+            /* 续记录里的文字：类型字节之外的 7 个字节 */
+            for (size_t k = i + 1; k < g_snap.nrec && g_snap.rec[k].type == TRACE_EV_TEXT; k++) {
+                for (int b = 0; b < TRACE_RECORD_SIZE; b++) {
+                    if (b != 4 && g_snap.rec[k].raw[b] != 0 && n < TRACE_LABEL_MAX) {
+                        label[n++] = (char)g_snap.rec[k].raw[b];
+                    }
+                }
+            }
+            label[n] = '\0';
+            snprintf(name, sizeof(name), "%s%s%s",
+                     r->a < TRACE_MARK_COUNT ? g_mark_names[r->a] : "mark", n ? " " : "", label);
+            emit('B', TID_MARKS + (cur >= 0 ? cur : 0), ts[i], -1, name, "value", r->b);
+            mark_depth[cur >= 0 ? cur : 0]++;
+            break;
+        }
+        case TRACE_EV_MALLOC:
+        case TRACE_EV_FREE:
+            snprintf(name, sizeof(name), "%s %dB%s", r->type == TRACE_EV_MALLOC ? "malloc" : "free",
+                     r->a * 8, r->b == 0xFFFF ? " failed" : "");
+            emit('i', tid, ts[i], -1, name, "address", r->b == 0xFFFF ? 0 : 0x20000000L + r->b * 8L);
+            if (g_heap_out != NULL) {
+                fprintf(g_heap_out, "%c %u %u\n", r->type == TRACE_EV_MALLOC ? 'm' : 'f', r->b, r->a * 8U);
+            }
+            break;
+        case TRACE_EV_MARK_STOP:
+            if (mark_depth[cur >= 0 ? cur : 0] > 0) {
+                emit('E', TID_MARKS + (cur >= 0 ? cur : 0), ts[i], -1, NULL, "result", r->b);
+                mark_depth[cur >= 0 ? cur : 0]--;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    /* 冻结时仍未结束的区间在冻结时刻截断 */
+    if (cur >= 0) {
+        emit('X', cur, cur_start, end_ts - cur_start, "running", NULL, 0);
+        emit('X', TID_CPU, cur_start, end_ts - cur_start, task_name(cur), NULL, 0);
+    }
+    for (; isr_depth > 0; isr_depth--) {
+        emit('E', TID_ISR, end_ts, -1, NULL, NULL, 0);
+    }
+    for (int n = 0; n < 256; n++) {
+        for (; mark_depth[n] > 0; mark_depth[n]--) {
+            emit('E', TID_MARKS + n, end_ts, -1, NULL, NULL, 0);
+        }
+    }
+    free(ts);
+}
+
+static void frame(uint8_t kind, const uint8_t *p, int len)
+{
+    switch (kind) {
+    case TRACE_FRAME_HEADER:
+        if (len < 19 || p[0] != TRACE_VERSION) {
+            fprintf(stderr, "tracecv: unsupported snapshot header (version %d)\n", len > 0 ? p[0] : -1);
+            g_snap.open = 0;
+            return;
+        }
+        free(g_snap.rec);
+        memset(&g_snap, 0, sizeof(g_snap));
+        g_snap.open = 1;
+        g_snap.hz = get32(p + 1);
+        g_snap.freeze_cycles = get32(p + 5);
+        g_snap.freeze_tick = get32(p + 9);
+        g_snap.total = get32(p + 13);
+        g_snap.capacity = p[17] | (uint32_t)p[18] << 8;
+        break;
+    case TRACE_FRAME_TASK:
+    case TRACE_FRAME_OBJECT:
+        if (g_snap.open && len >= 1) {
+            char *dst = kind == TRACE_FRAME_TASK ? g_snap.task[p[0]] : g_snap.object[p[0]];
+            int n = len - 1 < 31 ? len - 1 : 31;
+
+            memcpy(dst, p + 1, (size_t)n);
+            dst[n] = '\0';
+        }
+        break;
+    case TRACE_FRAME_RECORDS:
+        for (int off = 0; g_snap.open && off + TRACE_RECORD_SIZE <= len; off += TRACE_RECORD_SIZE) {
+            Record_t *r;
+
+            if (g_snap.nrec == g_snap.cap) {
+                g_snap.cap = g_snap.cap ? 2 * g_snap.cap : 256;
+                g_snap.rec = realloc(g_snap.rec, g_snap.cap * sizeof(Record_t));
+            }
+            r = &g_snap.rec[g_snap.nrec++];
+            memcpy(r->raw, p + off, TRACE_RECORD_SIZE);
+            r->cycles = get32(p + off);
+            r->type = p[off + 4];
+            r->a = p[off + 5];
+            r->b = (uint16_t)(p[off + 6] | p[off + 7] << 8);
+        }
+        break;
+    case TRACE_FRAME_END:
+        if (g_snap.open) {
+            convert();
+            fprintf(stderr, "snapshot %d: %lu events at tick %lu\n", g_pid,
+                    (unsigned long)g_snap.nrec, (unsigned long)g_snap.freeze_tick);
+        }
+        g_snap.open = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+/* 跳过一条 DLOG 记录（0xFF 已读掉），它的参数里可能出现 0xFE */
+static int skip_dlog(FILE *in)
+{
+    uint8_t hdr[8];
+    int nargs, mask, c;
+
+    for (int i = 0; i < 8; i++) {
+        if ((c = fgetc(in)) == EOF) {
+            return -1;
+        }
+        hdr[i] = (uint8_t)c;
+    }
+    nargs = hdr[6];
+    mask = hdr[7];
+    if (nargs > DLOG_MAX_ARGS) {
+        return 0;
+    }
+    for (int i = 0; i < nargs; i++) {
+        int len = 4;
+
+        if (mask & (1 << i)) {
+            if ((len = fgetc(in)) == EOF) {
+                return -1;
+            }
+        }
+        while (len-- > 0) {
+            if (fgetc(in) == EOF) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    FILE *in = stdin;
+    uint8_t payload[256];
+    int c, arg = 1;
+
+    if (arg + 1 < argc && strcmp(argv[arg], "-m") == 0) {
+        if ((g_heap_out = fopen(argv[arg + 1], "w")) == NULL) {
+            perror(argv[arg + 1]);
+            return 1;
+        }
+        arg += 2;
+    }
+    if (arg < argc && (in = fopen(argv[arg], "rb")) == NULL) {
+        perror(argv[arg]);
+        return 1;
+    }
+
+    printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    while ((c = fgetc(in)) != EOF) {
+        if (c == DLOG_SYNC) {
+            if (skip_dlog(in) != 0) {
+                break;
+            }
+        } else if (c == TRACE_SYNC) {
+            int kind = fgetc(in);
+            int len = fgetc(in);
+
+            if (kind == EOF || len == EOF || fread(payload, 1, (size_t)len, in) != (size_t)len) {
+                break;
+            }
+            frame((uint8_t)kind, payload, len);
+        }
+    }
+    printf("\n]}\n");
+
+    if (g_pid == 0) {
+        fprintf(stderr, "tracecv: no complete trace snapshot in the capture\n");
+    }
+    free(g_snap.rec);
+    if (g_heap_out != NULL) {
+        fclose(g_heap_out);
+    }
+    return g_pid == 0;
+}
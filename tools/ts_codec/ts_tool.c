@@ -0,0 +1,163 @@
+/*
+================================================================================
+ts_tool.c - ts_codec 主机端工具：压缩率测量 / 位流解码
+================================================================================
+编译（Linux）:
+  gcc -O2 -I../../Core/Inc -o ts_tool ts_tool.c ../../Core/Src/ts_codec.c
+
+用法:
+  ts_tool bench <trace.csv>          每行 "timestamp,value"（整数，# 开头为注释），
+                                     编码后回读校验，输出压缩率与主机编码耗时
+  ts_tool decode <blob.bin> <count>  把设备导出的压缩位流还原为 CSV
+
+设备端的编码周期数用 -DTS_CODEC_PROFILE 编译固件后读取 TS_Encoder_t.cycles。
+*/
+#include "ts_codec.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DHT11_DATA_T_SIZE   24      /* sizeof(DHT11_Data_t) on Cortex-M3 */
+#define RAW_PAIR_SIZE       8       /* uint32 timestamp + int32 value */
+
+static int load_trace(const char *path, uint32_t **ts, int32_t **val, size_t *count)
+{
+    FILE *f = fopen(path, "r");
+    char line[128];
+    size_t cap = 1024, n = 0;
+
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+
+    *ts = malloc(cap * sizeof(**ts));
+    *val = malloc(cap * sizeof(**val));
+    while (fgets(line, sizeof(line), f) != NULL) {
+        unsigned long t;
+        long v;
+
+        if (line[0] == '#' || sscanf(line, "%lu,%ld", &t, &v) != 2) {
+            continue;
+        }
+        if (n == cap) {
+            cap *= 2;
+            *ts = realloc(*ts, cap * sizeof(**ts));
+            *val = realloc(*val, cap * sizeof(**val));
+        }
+        (*ts)[n] = (uint32_t)t;
+        (*val)[n] = (int32_t)v;
+        n++;
+    }
+    fclose(f);
+
+    *count = n;
+    return 0;
+}
+
+static int bench(const char *path)
+{
+    uint32_t *ts;
+    int32_t *val;
+    size_t count, i;
+    size_t encoded = 0, bytes = 0, blocks = 0;
+    double elapsed_ns = 0.0;
+    uint8_t buf[1024];
+
+    if (load_trace(path, &ts, &val, &count) != 0) {
+        return 1;
+    }
+    if (count == 0) {
+        fprintf(stderr, "%s: no samples\n", path);
+        return 1;
+    }
+
+    /* Encode in device-sized blocks, as an offline queue would */
+    for (i = 0; i < count; ) {
+        TS_Encoder_t enc;
+        TS_Decoder_t dec;
+        struct timespec t0, t1;
+        size_t first = i, j;
+
+        TS_Encode_Init(&enc, buf, sizeof(buf));
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        while (i < count && TS_Encode_Append(&enc, ts[i], val[i])) {
+            i++;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        elapsed_ns += (double)(t1.tv_sec - t0.tv_sec) * 1e9 + (double)(t1.tv_nsec - t0.tv_nsec);
+
+        TS_Decode_Init(&dec, buf, enc.bit_pos, enc.count);
+        for (j = first; j < i; j++) {
+            uint32_t t;
+            int32_t v;
+            if (!TS_Decode_Next(&dec, &t, &v) || t != ts[j] || v != val[j]) {
+                fprintf(stderr, "mismatch at sample %zu\n", j);
+                return 1;
+            }
+        }
+
+        encoded += enc.count;
+        bytes += TS_Encode_Bytes(&enc);
+        blocks++;
+    }
+
+    printf("samples:           %zu (%zu blocks of %zu bytes)\n", encoded, blocks, sizeof(buf));
+    printf("compressed:        %zu bytes, %.2f bits/sample\n", bytes, bytes * 8.0 / encoded);
+    printf("vs raw pairs:      %zu bytes, ratio %.2fx\n", encoded * RAW_PAIR_SIZE,
+           (double)(encoded * RAW_PAIR_SIZE) / bytes);
+    printf("vs DHT11_Data_t:   %zu bytes, ratio %.2fx\n", encoded * DHT11_DATA_T_SIZE,
+           (double)(encoded * DHT11_DATA_T_SIZE) / bytes);
+    printf("host encode:       %.1f ns/sample\n", elapsed_ns / encoded);
+
+    free(ts);
+    free(val);
+    return 0;
+}
+
+static int decode(const char *path, unsigned long count)
+{
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+    long size;
+    TS_Decoder_t dec;
+    uint32_t t;
+    int32_t v;
+
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc((size_t)size);
+    if (fread(buf, 1, (size_t)size, f) != (size_t)size) {
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+
+    TS_Decode_Init(&dec, buf, (uint32_t)size * 8U, (uint16_t)count);
+    while (TS_Decode_Next(&dec, &t, &v)) {
+        printf("%lu,%ld\n", (unsigned long)t, (long)v);
+    }
+
+    free(buf);
+    return dec.index == count ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[1], "bench") == 0) {
+        return bench(argv[2]);
+    }
+    if (argc == 4 && strcmp(argv[1], "decode") == 0) {
+        return decode(argv[2], strtoul(argv[3], NULL, 0));
+    }
+
+    fprintf(stderr, "usage: %s bench <trace.csv>\n"
+                    "       %s decode <blob.bin> <count>\n", argv[0], argv[0]);
+    return 2;
+}